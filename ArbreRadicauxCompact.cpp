@@ -0,0 +1,603 @@
+/**
+* \file ArbreRadicauxCompact.cpp
+* \brief Le code des opérateurs de ArbreRadicauxCompact.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "ArbreRadicauxCompact.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+#include <algorithm>
+
+namespace TP3
+{
+
+    static const char MAGIE_ARBRE[8] = { 'A', 'R', 'B', 'R', 'C', 'M', 'P', '2' };
+    static const std::size_t TAILLE_BLOC_LECTURE = 64 << 10;
+
+    /**
+    * \fn void ecrireNaturel(std::ostream& sortie, std::uint64_t valeur)
+    * \brief Écrit valeur en entier variable (7 bits par octet, LEB128)
+    */
+    static void ecrireNaturel(std::ostream& sortie, std::uint64_t valeur)
+    {
+        while (valeur >= 0x80)
+        {
+            sortie.put(static_cast<char>((valeur & 0x7F) | 0x80));
+            valeur >>= 7;
+        }
+        sortie.put(static_cast<char>(valeur));
+    }
+
+    /**
+    * \fn bool lireNaturel(std::istream& entree, std::uint64_t& valeur)
+    * \brief Lit un entier variable (LEB128) ; faux si les octets manquent ou sont invalides
+    */
+    static bool lireNaturel(std::istream& entree, std::uint64_t& valeur)
+    {
+        valeur = 0;
+        for (int decalage = 0; decalage < 64; decalage += 7)
+        {
+            int octet = entree.get();
+            if (octet == std::char_traits<char>::eof()) return false;
+            valeur |= static_cast<std::uint64_t>(octet & 0x7F) << decalage;
+            if (!(octet & 0x80)) return true;
+        }
+        return false;
+    }
+
+    /**
+    * \fn bool lireTableau(std::istream& entree, Conteneur& conteneur, std::uint64_t nombre)
+    * \brief Lit nombre éléments dans conteneur, par blocs : un nombre corrompu fait échouer la lecture
+    *        à la fin du flux au lieu de réserver d'un coup une mémoire démesurée
+    */
+    template <typename Conteneur>
+    static bool lireTableau(std::istream& entree, Conteneur& conteneur, std::uint64_t nombre)
+    {
+        typedef typename Conteneur::value_type Element;
+        const std::uint64_t parBloc = TAILLE_BLOC_LECTURE / sizeof(Element);
+
+        conteneur.clear();
+        while (nombre > 0)
+        {
+            std::size_t lus = conteneur.size();
+            std::size_t bloc = static_cast<std::size_t>(std::min(nombre, parBloc));
+            conteneur.resize(lus + bloc);
+            if (!entree.read(reinterpret_cast<char*>(&conteneur[lus]), bloc * sizeof(Element))) return false;
+            nombre -= bloc;
+        }
+        return true;
+    }
+
+    ArbreRadicauxCompact::ArbreRadicauxCompact() : textesPerdus(0), racine(AUCUN), nbRadicaux(0)
+    {
+    }
+
+    /**
+    * \brief Ajouter un radical
+    *
+    * \exception logic_error si le radical existe déjà, ou s'il dépasse 65535 caractères.
+    * \exception length_error si l'arbre contient déjà 2^32 - 1 noeuds.
+    */
+    void ArbreRadicauxCompact::ajouterRadical(const std::string& motRadical)
+    {
+        if (motRadical.size() > 0xFFFF)
+            throw std::logic_error("ajouterRadical : Le radical est trop long");
+        if (contientRadical(motRadical))
+            throw std::logic_error("ajouterRadical : Le radical est déjà dans le dictionnaire");
+
+        racine = auxAjouter(racine, motRadical);
+        ++nbRadicaux;
+    }
+
+    /**
+    * \brief Supprimer un radical, avec ses flexions et ses appartenances
+    *
+    * \exception logic_error si le radical n'existe pas.
+    */
+    void ArbreRadicauxCompact::supprimerRadical(const std::string& motRadical)
+    {
+        if (!contientRadical(motRadical))
+            throw std::logic_error("supprimerRadical : Le radical n'est pas dans le dictionnaire");
+
+        racine = auxSupprimer(racine, motRadical);
+        --nbRadicaux;
+    }
+
+    /**
+    * \brief Ajouter une flexion à un radical
+    *
+    * \exception logic_error si motRadical n'existe pas ou si motFlexion existe déjà.
+    */
+    void ArbreRadicauxCompact::ajouterFlexion(const std::string& motRadical, const std::string& motFlexion)
+    {
+        std::uint32_t i = trouver(motRadical);
+        if (i == AUCUN) throw std::logic_error("ajouterFlexion : Le radical n'est pas dans le dictionnaire");
+        if (!flexionsDe[i].ajouter(motFlexion))
+            throw std::logic_error("ajouterFlexion : La flexion est déjà présente dans le radical");
+    }
+
+    /**
+    * \brief Supprimer une flexion d'un radical
+    *
+    * \exception logic_error si motRadical ou motFlexion n'existe pas.
+    */
+    void ArbreRadicauxCompact::supprimerFlexion(const std::string& motRadical, const std::string& motFlexion)
+    {
+        std::uint32_t i = trouver(motRadical);
+        if (i == AUCUN) throw std::logic_error("supprimerFlexion : Le radical n'est pas dans le dictionnaire");
+        if (!flexionsDe[i].retirer(motFlexion))
+            throw std::logic_error("supprimerFlexion : La flexion n'est pas présente dans le radical");
+    }
+
+    /**
+    * \brief Retourne les flexions de motRadical, ou rien s'il n'existe pas
+    */
+    std::optional< std::vector<std::string> > ArbreRadicauxCompact::flexions(std::string_view motRadical) const
+    {
+        std::uint32_t i = trouver(motRadical);
+        if (i == AUCUN) return std::nullopt;
+        return flexionsDe[i].versVecteur();
+    }
+
+    /**
+    * \brief Ajoute numGroupe aux groupes de synonymes de motRadical
+    *
+    * \exception logic_error si motRadical n'existe pas.
+    */
+    void ArbreRadicauxCompact::ajouterAppartenance(const std::string& motRadical, int numGroupe)
+    {
+        std::uint32_t i = trouver(motRadical);
+        if (i == AUCUN) throw std::logic_error("ajouterAppartenance : Le radical n'est pas dans le dictionnaire");
+        appartenancesDe[i].push_back(numGroupe);
+    }
+
+    /**
+    * \brief Retourne les groupes de synonymes de motRadical, ou rien s'il n'existe pas
+    */
+    std::optional< std::vector<int> > ArbreRadicauxCompact::appartenances(std::string_view motRadical) const
+    {
+        std::uint32_t i = trouver(motRadical);
+        if (i == AUCUN) return std::nullopt;
+        return appartenancesDe[i];
+    }
+
+    /**
+    * \brief Retourne les radicaux en ordre croissant
+    */
+    std::vector<std::string> ArbreRadicauxCompact::radicaux() const
+    {
+        std::vector<std::uint32_t> ordre;
+        auxParcoursEnOrdre(racine, ordre);
+        std::vector<std::string> resultat;
+        resultat.reserve(ordre.size());
+        for (auto i : ordre) resultat.emplace_back(radical(i));
+        return resultat;
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t ArbreRadicauxCompact::memoire() const
+    {
+        std::size_t octets = octetsVecteur(noeuds) + octetsVecteur(flexionsDe) + octetsVecteur(appartenancesDe)
+                             + octetsVecteur(libres) + octetsChaine(textes);
+        for (auto &liste : flexionsDe) octets += liste.memoire();
+        for (auto &groupes : appartenancesDe) octets += octetsVecteur(groupes);
+        return octets;
+    }
+
+    /**
+    * \brief Renumérote les noeuds en ordre croissant, reconstruit l'arbre parfaitement équilibré
+    *        et récupère le texte des radicaux supprimés
+    *
+    * \post Le contenu logique de l'arbre reste inchangé.
+    */
+    void ArbreRadicauxCompact::compacter()
+    {
+        std::vector<std::uint32_t> ordre;
+        auxParcoursEnOrdre(racine, ordre);
+
+        std::vector<Noeud> nouveauxNoeuds(ordre.size());
+        std::vector<ListeFlexions> nouvellesFlexions(ordre.size());
+        std::vector< std::vector<int> > nouvellesAppartenances(ordre.size());
+        std::string nouveauxTextes;
+        nouveauxTextes.reserve(textes.size() - textesPerdus);
+        for (std::size_t k = 0; k < ordre.size(); ++k)
+        {
+            std::string_view texte = radical(ordre[k]);
+            nouveauxNoeuds[k].decalageRadical = nouveauxTextes.size();
+            nouveauxNoeuds[k].longueurRadical = texte.size();
+            nouveauxNoeuds[k].reserve = 0;
+            nouveauxTextes.append(texte.data(), texte.size());
+            nouvellesFlexions[k] = std::move(flexionsDe[ordre[k]]);
+            nouvellesFlexions[k].compacter();
+            nouvellesAppartenances[k] = std::move(appartenancesDe[ordre[k]]);
+            nouvellesAppartenances[k].shrink_to_fit();
+        }
+
+        noeuds.swap(nouveauxNoeuds);
+        flexionsDe.swap(nouvellesFlexions);
+        appartenancesDe.swap(nouvellesAppartenances);
+        textes.swap(nouveauxTextes);
+        std::vector<std::uint32_t>().swap(libres);
+        textesPerdus = 0;
+
+        // les noeuds sont maintenant numérotés dans l'ordre : on relie simplement 0 .. n-1
+        std::vector<std::uint32_t> identite(noeuds.size());
+        for (std::uint32_t k = 0; k < identite.size(); ++k) identite[k] = k;
+        racine = construireEquilibre(identite, 0, identite.size());
+    }
+
+    /**
+    * \brief Écrit l'arbre dans sortie (format binaire, ordre des octets de la machine ; les longueurs
+    *        et les nombres de flexions et d'appartenances sont des entiers variables)
+    */
+    void ArbreRadicauxCompact::ecrire(std::ostream& sortie) const
+    {
+        auto ecrireEntier = [&sortie](std::uint64_t valeur) { sortie.write(reinterpret_cast<const char*>(&valeur), sizeof(valeur)); };
+
+        sortie.write(MAGIE_ARBRE, sizeof(MAGIE_ARBRE));
+        ecrireEntier(noeuds.size());
+        ecrireEntier(libres.size());
+        ecrireEntier(textes.size());
+        ecrireEntier(textesPerdus);
+        ecrireEntier(racine);
+        ecrireEntier(nbRadicaux);
+
+        // aucun pointeur : les noeuds, les cases libres et les textes sont écrits tels quels
+        sortie.write(reinterpret_cast<const char*>(noeuds.data()), noeuds.size() * sizeof(Noeud));
+        sortie.write(reinterpret_cast<const char*>(libres.data()), libres.size() * sizeof(std::uint32_t));
+        sortie.write(textes.data(), textes.size());
+
+        for (std::size_t i = 0; i < noeuds.size(); ++i)
+        {
+            ecrireNaturel(sortie, flexionsDe[i].taille());
+            for (auto flexion : flexionsDe[i])
+            {
+                ecrireNaturel(sortie, flexion.size());
+                sortie.write(flexion.data(), flexion.size());
+            }
+            ecrireNaturel(sortie, appartenancesDe[i].size());
+            sortie.write(reinterpret_cast<const char*>(appartenancesDe[i].data()), appartenancesDe[i].size() * sizeof(int));
+        }
+    }
+
+    /**
+    * \brief Remplace le contenu de l'arbre par celui lu dans entree
+    *
+    * \exception runtime_error si entree ne contient pas un arbre écrit par ecrire, s'il est tronqué, ou si
+    *            un indice, un texte, une hauteur ou l'ordre des radicaux est incohérent.
+    * \post En cas d'exception, l'arbre reste inchangé.
+    */
+    void ArbreRadicauxCompact::lire(std::istream& entree)
+    {
+        auto lireEntier = [&entree]() {
+            std::uint64_t valeur = 0;
+            entree.read(reinterpret_cast<char*>(&valeur), sizeof(valeur));
+            return valeur;
+        };
+
+        char magie[sizeof(MAGIE_ARBRE)];
+        entree.read(magie, sizeof(magie));
+        if (!entree || std::memcmp(magie, MAGIE_ARBRE, sizeof(magie)) != 0)
+            throw std::runtime_error("ArbreRadicauxCompact::lire : Ce n'est pas un arbre compact");
+
+        const char* corrompu = "ArbreRadicauxCompact::lire : L'arbre est tronqué ou corrompu";
+        std::uint64_t nombreNoeuds = lireEntier(), nombreLibres = lireEntier(), tailleTextes = lireEntier();
+        std::uint64_t perdus = lireEntier(), indiceRacine = lireEntier(), nombreRadicaux = lireEntier();
+        if (!entree || nombreNoeuds > AUCUN || nombreLibres > nombreNoeuds || perdus > tailleTextes
+            || (indiceRacine != AUCUN && indiceRacine >= nombreNoeuds)
+            || nombreRadicaux != nombreNoeuds - nombreLibres || nombreRadicaux > static_cast<std::uint64_t>(INT_MAX))
+            throw std::runtime_error(corrompu);
+
+        ArbreRadicauxCompact lu;
+        lu.textesPerdus = perdus;
+        lu.racine = static_cast<std::uint32_t>(indiceRacine);
+        lu.nbRadicaux = static_cast<int>(nombreRadicaux);
+        if (!lireTableau(entree, lu.noeuds, nombreNoeuds) || !lireTableau(entree, lu.libres, nombreLibres)
+            || !lireTableau(entree, lu.textes, tailleTextes))
+            throw std::runtime_error(corrompu);
+
+        lu.flexionsDe.resize(lu.noeuds.size());
+        lu.appartenancesDe.resize(lu.noeuds.size());
+        std::string flexion;
+        for (std::size_t i = 0; i < lu.noeuds.size(); ++i)
+        {
+            std::uint64_t nombre, longueur;
+            if (!lireNaturel(entree, nombre)) throw std::runtime_error(corrompu);
+            for (; nombre > 0; --nombre)
+            {
+                if (!lireNaturel(entree, longueur) || !lireTableau(entree, flexion, longueur)
+                    || !lu.flexionsDe[i].ajouter(flexion))
+                    throw std::runtime_error(corrompu);
+            }
+            if (!lireNaturel(entree, nombre) || !lireTableau(entree, lu.appartenancesDe[i], nombre))
+                throw std::runtime_error(corrompu);
+        }
+        if (!lu.estValide())
+            throw std::runtime_error(corrompu);
+
+        *this = std::move(lu);
+    }
+
+    /**
+    * \fn bool estValide() const
+    * \brief Vérifie un arbre lu : cases libres, indices des enfants, textes des radicaux, hauteurs AVL
+    *        et ordre des radicaux. Les hauteurs strictement décroissantes interdisent les cycles ;
+    *        le parcours refuse en plus un noeud atteint deux fois.
+    */
+    bool ArbreRadicauxCompact::estValide() const
+    {
+        const std::size_t n = noeuds.size();
+        std::vector<char> libre(n, 0);
+        for (auto i : libres)
+        {
+            if (i >= n || libre[i] || noeuds[i].hauteur != -1) return false;
+            libre[i] = 1;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Noeud& noeud = noeuds[i];
+            if (libre[i])
+            {
+                if (!flexionsDe[i].estVide() || !appartenancesDe[i].empty()) return false;
+                continue;
+            }
+            if (noeud.hauteur < 0
+                || static_cast<std::uint64_t>(noeud.decalageRadical) + noeud.longueurRadical > textes.size())
+                return false;
+            for (std::uint32_t enfant : { noeud.gauche, noeud.droit })
+                if (enfant != AUCUN && (enfant >= n || libre[enfant])) return false;
+        }
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (libre[i]) continue;
+            int gauche = hauteur(noeuds[i].gauche), droit = hauteur(noeuds[i].droit);
+            if (noeuds[i].hauteur != 1 + std::max(gauche, droit) || std::abs(gauche - droit) > 1) return false;
+        }
+
+        // parcours en ordre itératif : la pile ne dépasse pas la hauteur de la racine
+        std::vector<char> vu(n, 0);
+        std::vector<std::uint32_t> pile;
+        std::string_view precedent;
+        std::size_t visites = 0;
+        std::uint32_t i = racine;
+        while (i != AUCUN || !pile.empty())
+        {
+            for (; i != AUCUN; i = noeuds[i].gauche)
+            {
+                if (vu[i]) return false;
+                vu[i] = 1;
+                pile.push_back(i);
+            }
+            i = pile.back();
+            pile.pop_back();
+            if (visites++ > 0 && !(precedent < radical(i))) return false;
+            precedent = radical(i);
+            i = noeuds[i].droit;
+        }
+        return visites == static_cast<std::size_t>(nbRadicaux);
+    }
+
+    /**
+    * \fn std::uint32_t trouver(std::string_view motRadical) const
+    * \brief Descente itérative ; retourne l'indice du noeud de motRadical, ou AUCUN
+    */
+    std::uint32_t ArbreRadicauxCompact::trouver(std::string_view motRadical) const
+    {
+        std::uint32_t i = racine;
+        while (i != AUCUN)
+        {
+            int comparaison = motRadical.compare(radical(i));
+            if (comparaison == 0) return i;
+            i = comparaison < 0 ? noeuds[i].gauche : noeuds[i].droit;
+        }
+        return AUCUN;
+    }
+
+    /**
+    * \fn std::uint32_t nouveauNoeud(const std::string& motRadical)
+    * \brief Crée une feuille pour motRadical, dans une case libre si possible
+    */
+    std::uint32_t ArbreRadicauxCompact::nouveauNoeud(const std::string& motRadical)
+    {
+        std::uint32_t i;
+        if (!libres.empty())
+        {
+            i = libres.back();
+            libres.pop_back();
+        }
+        else
+        {
+            if (noeuds.size() >= AUCUN)
+                throw std::length_error("ajouterRadical : L'arbre est plein");
+            i = noeuds.size();
+            noeuds.emplace_back();
+            flexionsDe.emplace_back();
+            appartenancesDe.emplace_back();
+        }
+
+        Noeud& noeud = noeuds[i];
+        noeud.gauche = noeud.droit = AUCUN;
+        noeud.decalageRadical = textes.size();
+        noeud.longueurRadical = motRadical.size();
+        noeud.hauteur = 0;
+        noeud.reserve = 0;
+        textes += motRadical;
+        return i;
+    }
+
+    /**
+    * \fn void libererNoeud(std::uint32_t i)
+    * \brief Rend la case i réutilisable ; son texte reste dans textes jusqu'à compacter
+    */
+    void ArbreRadicauxCompact::libererNoeud(std::uint32_t i)
+    {
+        textesPerdus += noeuds[i].longueurRadical;
+        noeuds[i].hauteur = -1;
+        flexionsDe[i] = ListeFlexions();
+        std::vector<int>().swap(appartenancesDe[i]);
+        libres.push_back(i);
+    }
+
+    /**
+    * \fn std::uint32_t auxAjouter(std::uint32_t sousArbre, const std::string& motRadical)
+    * \brief Fonction récursive ajoutant motRadical ; retourne la nouvelle racine du sous-arbre.
+    *        On ne garde aucune référence dans noeuds pendant l'appel récursif : il peut agrandir le tableau.
+    */
+    std::uint32_t ArbreRadicauxCompact::auxAjouter(std::uint32_t sousArbre, const std::string& motRadical)
+    {
+        if (sousArbre == AUCUN) return nouveauNoeud(motRadical);
+
+        if (motRadical < radical(sousArbre))
+        {
+            std::uint32_t gauche = auxAjouter(noeuds[sousArbre].gauche, motRadical);
+            noeuds[sousArbre].gauche = gauche;
+        }
+        else
+        {
+            std::uint32_t droit = auxAjouter(noeuds[sousArbre].droit, motRadical);
+            noeuds[sousArbre].droit = droit;
+        }
+        return equilibrer(sousArbre);
+    }
+
+    /**
+    * \fn std::uint32_t auxSupprimer(std::uint32_t sousArbre, std::string_view motRadical)
+    * \brief Fonction récursive supprimant motRadical ; retourne la nouvelle racine du sous-arbre.
+    *        Un noeud à deux enfants est remplacé par son successeur, déplacé tel quel.
+    */
+    std::uint32_t ArbreRadicauxCompact::auxSupprimer(std::uint32_t sousArbre, std::string_view motRadical)
+    {
+        int comparaison = motRadical.compare(radical(sousArbre));
+        if (comparaison < 0)
+        {
+            noeuds[sousArbre].gauche = auxSupprimer(noeuds[sousArbre].gauche, motRadical);
+            return equilibrer(sousArbre);
+        }
+        if (comparaison > 0)
+        {
+            noeuds[sousArbre].droit = auxSupprimer(noeuds[sousArbre].droit, motRadical);
+            return equilibrer(sousArbre);
+        }
+
+        std::uint32_t gauche = noeuds[sousArbre].gauche;
+        std::uint32_t droit = noeuds[sousArbre].droit;
+        libererNoeud(sousArbre);
+        if (gauche == AUCUN) return droit;
+        if (droit == AUCUN) return gauche;
+
+        std::uint32_t successeur;
+        droit = retirerMinimum(droit, successeur);
+        noeuds[successeur].gauche = gauche;
+        noeuds[successeur].droit = droit;
+        return equilibrer(successeur);
+    }
+
+    /**
+    * \fn std::uint32_t retirerMinimum(std::uint32_t sousArbre, std::uint32_t& minimum)
+    * \brief Détache le plus petit noeud du sous-arbre (sans le libérer) ; retourne la nouvelle racine
+    */
+    std::uint32_t ArbreRadicauxCompact::retirerMinimum(std::uint32_t sousArbre, std::uint32_t& minimum)
+    {
+        if (noeuds[sousArbre].gauche == AUCUN)
+        {
+            minimum = sousArbre;
+            return noeuds[sousArbre].droit;
+        }
+        noeuds[sousArbre].gauche = retirerMinimum(noeuds[sousArbre].gauche, minimum);
+        return equilibrer(sousArbre);
+    }
+
+    /**
+    * \fn std::uint32_t equilibrer(std::uint32_t i)
+    * \brief Remet à jour la hauteur de i et fait les rotations nécessaires ; retourne la racine du sous-arbre
+    */
+    std::uint32_t ArbreRadicauxCompact::equilibrer(std::uint32_t i)
+    {
+        mettreAJourHauteur(i);
+        int balance = hauteur(noeuds[i].gauche) - hauteur(noeuds[i].droit);
+        if (balance > 1)
+        {
+            std::uint32_t gauche = noeuds[i].gauche;
+            if (hauteur(noeuds[gauche].gauche) < hauteur(noeuds[gauche].droit))
+                noeuds[i].gauche = rotationGauche(gauche);
+            return rotationDroite(i);
+        }
+        if (balance < -1)
+        {
+            std::uint32_t droit = noeuds[i].droit;
+            if (hauteur(noeuds[droit].droit) < hauteur(noeuds[droit].gauche))
+                noeuds[i].droit = rotationDroite(droit);
+            return rotationGauche(i);
+        }
+        return i;
+    }
+
+    /**
+    * \fn std::uint32_t rotationDroite(std::uint32_t i)
+    * \brief L'enfant gauche de i devient la racine du sous-arbre
+    */
+    std::uint32_t ArbreRadicauxCompact::rotationDroite(std::uint32_t i)
+    {
+        std::uint32_t pivot = noeuds[i].gauche;
+        noeuds[i].gauche = noeuds[pivot].droit;
+        noeuds[pivot].droit = i;
+        mettreAJourHauteur(i);
+        mettreAJourHauteur(pivot);
+        return pivot;
+    }
+
+    /**
+    * \fn std::uint32_t rotationGauche(std::uint32_t i)
+    * \brief L'enfant droit de i devient la racine du sous-arbre
+    */
+    std::uint32_t ArbreRadicauxCompact::rotationGauche(std::uint32_t i)
+    {
+        std::uint32_t pivot = noeuds[i].droit;
+        noeuds[i].droit = noeuds[pivot].gauche;
+        noeuds[pivot].gauche = i;
+        mettreAJourHauteur(i);
+        mettreAJourHauteur(pivot);
+        return pivot;
+    }
+
+    void ArbreRadicauxCompact::mettreAJourHauteur(std::uint32_t i)
+    {
+        noeuds[i].hauteur = 1 + std::max(hauteur(noeuds[i].gauche), hauteur(noeuds[i].droit));
+    }
+
+    void ArbreRadicauxCompact::auxParcoursEnOrdre(std::uint32_t sousArbre, std::vector<std::uint32_t>& accumulateur) const
+    {
+        if (sousArbre == AUCUN) return;
+
+        auxParcoursEnOrdre(noeuds[sousArbre].gauche, accumulateur);
+        accumulateur.push_back(sousArbre);
+        auxParcoursEnOrdre(noeuds[sousArbre].droit, accumulateur);
+    }
+
+    /**
+    * \fn std::uint32_t construireEquilibre(const std::vector<std::uint32_t>& ordre, int debut, int fin)
+    * \brief Relie les noeuds ordre[debut, fin[ (triés) en un arbre parfaitement équilibré ; retourne sa racine
+    */
+    std::uint32_t ArbreRadicauxCompact::construireEquilibre(const std::vector<std::uint32_t>& ordre, int debut, int fin)
+    {
+        if (debut >= fin) return AUCUN;
+
+        int milieu = debut + (fin - debut) / 2;
+        std::uint32_t i = ordre[milieu];
+        noeuds[i].gauche = construireEquilibre(ordre, debut, milieu);
+        noeuds[i].droit = construireEquilibre(ordre, milieu + 1, fin);
+        mettreAJourHauteur(i);
+        return i;
+    }
+
+}//Fin du namespace
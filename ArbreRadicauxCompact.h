@@ -0,0 +1,192 @@
+/**
+* \file ArbreRadicauxCompact.h
+* \brief Interface du type ArbreRadicauxCompact
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+#include "ListeFlexions.h"
+#include "Memoire.h"
+
+#ifndef _ARBRERADICAUXCOMPACT__H
+#define _ARBRERADICAUXCOMPACT__H
+
+namespace TP3
+{
+
+   /**
+   * \class ArbreRadicauxCompact
+   *
+   * \brief Arbre AVL des radicaux dont les noeuds sont rangés dans un seul tableau.
+   *
+   * Les enfants sont des indices de 32 bits dans ce tableau plutôt que des pointeurs, la hauteur
+   * tient sur 8 bits et le texte du radical est un décalage dans une zone de caractères commune.
+   * Les flexions et les appartenances aux groupes de synonymes sont dans des tableaux parallèles,
+   * à l'indice du noeud. Un noeud occupe ainsi 16 octets. Comme aucun pointeur n'est conservé,
+   * l'arbre peut être déplacé ou écrit tel quel dans un flux (ecrire / lire).
+   *
+   * Les cases des noeuds supprimés sont réutilisées ; le texte des radicaux supprimés n'est
+   * récupéré que par compacter.
+   *
+   * Cet arbre est un magasin de radicaux autonome ; DicoSynonymes ne l'utilise pas. Ses groupes de
+   * synonymes gardent des pointeurs vers ses noeuds et ses opérations ensemblistes (joindre,
+   * fusionner en parallèle) greffent des sous-arbres entiers d'un dictionnaire à l'autre, ce qu'un
+   * indice dans un tableau propre à chaque dictionnaire ne permet pas sans les réécrire toutes.
+   * Seuls les 16 octets des noeuds sont parcourus lors d'une recherche ; les flexions et les
+   * appartenances ne sont lues qu'une fois le noeud trouvé.
+   *
+   */
+   class ArbreRadicauxCompact
+   {
+   public:
+
+      ArbreRadicauxCompact();
+
+      /**
+      * \brief Ajouter un radical
+      *
+      * \exception logic_error si le radical existe déjà, ou s'il dépasse 65535 caractères.
+      * \exception length_error si l'arbre contient déjà 2^32 - 1 noeuds.
+      */
+      void ajouterRadical(const std::string& motRadical);
+
+      /**
+      * \brief Supprimer un radical, avec ses flexions et ses appartenances
+      *
+      * \exception logic_error si le radical n'existe pas.
+      */
+      void supprimerRadical(const std::string& motRadical);
+
+      bool contientRadical(std::string_view motRadical) const { return trouver(motRadical) != AUCUN; }
+
+      /**
+      * \brief Ajouter une flexion à un radical
+      *
+      * \exception logic_error si motRadical n'existe pas ou si motFlexion existe déjà.
+      */
+      void ajouterFlexion(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Supprimer une flexion d'un radical
+      *
+      * \exception logic_error si motRadical ou motFlexion n'existe pas.
+      */
+      void supprimerFlexion(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Retourne les flexions de motRadical, ou rien s'il n'existe pas
+      */
+      std::optional< std::vector<std::string> > flexions(std::string_view motRadical) const;
+
+      /**
+      * \brief Ajoute numGroupe aux groupes de synonymes de motRadical
+      *
+      * \exception logic_error si motRadical n'existe pas.
+      */
+      void ajouterAppartenance(const std::string& motRadical, int numGroupe);
+
+      /**
+      * \brief Retourne les groupes de synonymes de motRadical, ou rien s'il n'existe pas
+      */
+      std::optional< std::vector<int> > appartenances(std::string_view motRadical) const;
+
+      /**
+      * \brief Retourne les radicaux en ordre croissant
+      */
+      std::vector<std::string> radicaux() const;
+
+      int nombreRadicaux() const { return nbRadicaux; }
+      int hauteur() const { return racine == AUCUN ? -1 : noeuds[racine].hauteur; }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+      /**
+      * \brief Renumérote les noeuds en ordre croissant, reconstruit l'arbre parfaitement équilibré
+      *        et récupère le texte des radicaux supprimés
+      *
+      * \post Le contenu logique de l'arbre reste inchangé.
+      */
+      void compacter();
+
+      /**
+      * \brief Écrit l'arbre dans sortie (format binaire, ordre des octets de la machine ; les longueurs
+      *        et les nombres de flexions et d'appartenances sont des entiers variables)
+      */
+      void ecrire(std::ostream& sortie) const;
+
+      /**
+      * \brief Remplace le contenu de l'arbre par celui lu dans entree
+      *
+      * \exception runtime_error si entree ne contient pas un arbre écrit par ecrire, s'il est tronqué, ou si
+      *            un indice, un texte, une hauteur ou l'ordre des radicaux est incohérent.
+      * \post En cas d'exception, l'arbre reste inchangé.
+      */
+      void lire(std::istream& entree);
+
+      static const std::uint32_t AUCUN = 0xFFFFFFFF;   // Indice nul.
+
+   private:
+
+      /**
+      * \struct Noeud
+      *
+      * \brief Un radical de l'arbre, sans aucun pointeur
+      */
+      struct Noeud
+      {
+         std::uint32_t gauche, droit;      // Indices des enfants, ou AUCUN.
+         std::uint32_t decalageRadical;    // Début du radical dans textes.
+         std::uint16_t longueurRadical;
+         std::int8_t hauteur;              // -1 marque une case libre.
+         std::uint8_t reserve;
+      };
+      static_assert(sizeof(Noeud) == 16, "Un noeud compact doit occuper 16 octets");
+
+      std::string_view radical(std::uint32_t i) const
+      {
+         return std::string_view(textes.data() + noeuds[i].decalageRadical, noeuds[i].longueurRadical);
+      }
+      int hauteur(std::uint32_t i) const { return i == AUCUN ? -1 : noeuds[i].hauteur; }
+
+      std::uint32_t trouver(std::string_view motRadical) const;
+      bool estValide() const;
+      std::uint32_t nouveauNoeud(const std::string& motRadical);
+      void libererNoeud(std::uint32_t i);
+      std::uint32_t auxAjouter(std::uint32_t sousArbre, const std::string& motRadical);
+      std::uint32_t auxSupprimer(std::uint32_t sousArbre, std::string_view motRadical);
+      std::uint32_t retirerMinimum(std::uint32_t sousArbre, std::uint32_t& minimum);
+      std::uint32_t equilibrer(std::uint32_t i);
+      std::uint32_t rotationDroite(std::uint32_t i);
+      std::uint32_t rotationGauche(std::uint32_t i);
+      void mettreAJourHauteur(std::uint32_t i);
+      void auxParcoursEnOrdre(std::uint32_t sousArbre, std::vector<std::uint32_t>& accumulateur) const;
+      std::uint32_t construireEquilibre(const std::vector<std::uint32_t>& ordre, int debut, int fin);
+
+      std::vector<Noeud> noeuds;
+      std::vector<ListeFlexions> flexionsDe;           // flexionsDe[i] : les flexions du noeud i.
+      std::vector< std::vector<int> > appartenancesDe; // appartenancesDe[i] : les groupes du noeud i.
+      std::vector<std::uint32_t> libres;               // Cases de noeuds réutilisables.
+      std::string textes;                              // Les radicaux bout à bout.
+      std::size_t textesPerdus;                        // Caractères de textes appartenant à des radicaux supprimés.
+      std::uint32_t racine;
+      int nbRadicaux;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,175 @@
+/**
+* \file CacheRadicaux.cpp
+* \brief Le code des opérateurs de CacheRadicaux.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "CacheRadicaux.h"
+
+namespace TP3
+{
+
+    /**
+    * \brief Constructeur
+    *
+    * \post Un cache vide de la capacité demandée (totale, répartie entre les fragments) est créé.
+    */
+    CacheRadicaux::CacheRadicaux(std::size_t capacite, std::size_t nbFragments)
+        : nbFragments(nbFragments == 0 ? 1 : nbFragments), capaciteParFragment(0),
+          fragments(new Fragment[nbFragments == 0 ? 1 : nbFragments])
+    {
+        redimensionner(capacite);
+    }
+
+    /**
+    * \brief Déplacement, sans allocation : source reste un cache inactif sans fragment
+    */
+    CacheRadicaux::CacheRadicaux(CacheRadicaux&& source) noexcept
+        : nbFragments(source.nbFragments), capaciteParFragment(source.capaciteParFragment),
+          fragments(std::move(source.fragments))
+    {
+        source.nbFragments = 0;
+        source.capaciteParFragment = 0;
+    }
+
+    /**
+    * \brief Affectation par déplacement : source reste un cache inactif sans fragment
+    */
+    CacheRadicaux& CacheRadicaux::operator=(CacheRadicaux&& source) noexcept
+    {
+        if (this != &source)
+        {
+            nbFragments = source.nbFragments;
+            capaciteParFragment = source.capaciteParFragment;
+            fragments = std::move(source.fragments);
+            source.nbFragments = 0;
+            source.capaciteParFragment = 0;
+        }
+        return *this;
+    }
+
+    /**
+    * \brief Cherche mot dans le cache
+    *
+    * \post Si mot est présent, il devient le plus récemment utilisé de son fragment
+    *       et son résultat est copié dans resultat.
+    * \return vrai si mot est dans le cache
+    */
+    bool CacheRadicaux::chercher(const std::string& mot, std::optional<std::string>& resultat)
+    {
+        if (!estActif()) return false;
+
+        Fragment& fragment = fragmentDe(mot);
+        std::lock_guard<std::mutex> garde(fragment.verrou);
+
+        auto it = fragment.positions.find(mot);
+        if (it == fragment.positions.end()) return false;
+
+        fragment.entrees.splice(fragment.entrees.begin(), fragment.entrees, it->second);
+        resultat = it->second->second;
+        return true;
+    }
+
+    /**
+    * \brief Conserve le résultat de la recherche de mot, en évinçant au besoin le moins récemment utilisé
+    */
+    void CacheRadicaux::inserer(const std::string& mot, const std::optional<std::string>& resultat)
+    {
+        if (!estActif()) return;
+
+        Fragment& fragment = fragmentDe(mot);
+        std::lock_guard<std::mutex> garde(fragment.verrou);
+
+        auto it = fragment.positions.find(mot);
+        if (it != fragment.positions.end())
+        {
+            it->second->second = resultat;
+            fragment.entrees.splice(fragment.entrees.begin(), fragment.entrees, it->second);
+            return;
+        }
+
+        if (fragment.entrees.size() >= capaciteParFragment)
+        {
+            fragment.positions.erase(fragment.entrees.back().first);
+            fragment.entrees.pop_back();
+        }
+        fragment.entrees.emplace_front(mot, resultat);
+        fragment.positions.emplace(mot, fragment.entrees.begin());
+    }
+
+    /**
+    * \brief Retire mot du cache s'il y est
+    */
+    void CacheRadicaux::invalider(const std::string& mot)
+    {
+        if (!estActif()) return;
+
+        Fragment& fragment = fragmentDe(mot);
+        std::lock_guard<std::mutex> garde(fragment.verrou);
+
+        auto it = fragment.positions.find(mot);
+        if (it == fragment.positions.end()) return;
+        fragment.entrees.erase(it->second);
+        fragment.positions.erase(it);
+    }
+
+    /**
+    * \brief Vide le cache
+    */
+    void CacheRadicaux::vider()
+    {
+        for (std::size_t i = 0; i < nbFragments; ++i)
+        {
+            std::lock_guard<std::mutex> garde(fragments[i].verrou);
+            fragments[i].entrees.clear();
+            fragments[i].positions.clear();
+        }
+    }
+
+    /**
+    * \brief Change la capacité du cache. Le contenu est vidé.
+    */
+    void CacheRadicaux::redimensionner(std::size_t capacite)
+    {
+        // cache déplacé : ses fragments sont recréés
+        if (!fragments)
+        {
+            fragments.reset(new Fragment[NB_FRAGMENTS_DEFAUT]);
+            nbFragments = NB_FRAGMENTS_DEFAUT;
+        }
+        vider();
+        capaciteParFragment = (capacite + nbFragments - 1) / nbFragments;
+    }
+
+    /**
+    * \fn Fragment& fragmentDe(const std::string& mot)
+    * \brief Retourne le fragment responsable de mot
+    */
+    CacheRadicaux::Fragment& CacheRadicaux::fragmentDe(const std::string& mot)
+    {
+        return fragments[std::hash<std::string>()(mot) % nbFragments];
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t CacheRadicaux::memoire() const
+    {
+        std::size_t octets = nbFragments * sizeof(Fragment);
+        for (std::size_t i = 0; i < nbFragments; ++i)
+        {
+            std::lock_guard<std::mutex> garde(fragments[i].verrou);
+            octets += octetsListe(fragments[i].entrees) + octetsTableHachage(fragments[i].positions);
+            for (auto &entree : fragments[i].entrees)
+                octets += octetsChaine(entree.first) + (entree.second ? octetsChaine(*entree.second) : 0);
+            for (auto &position : fragments[i].positions) octets += octetsChaine(position.first);
+        }
+        return octets;
+    }
+
+}//Fin du namespace
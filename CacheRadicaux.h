@@ -0,0 +1,119 @@
+/**
+* \file CacheRadicaux.h
+* \brief Interface du type CacheRadicaux
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <optional>
+#include <mutex>
+#include <memory>
+#include <functional>
+
+#include "Memoire.h"
+
+#ifndef _CACHERADICAUX__H
+#define _CACHERADICAUX__H
+
+namespace TP3
+{
+
+   /**
+   * \class CacheRadicaux
+   *
+   * \brief Cache LRU borné des résultats de rechercherRadical (mot -> radical).
+   *
+   * Les résultats négatifs (mot dans aucune liste de flexions) sont aussi conservés.
+   * Le cache est fragmenté selon le hachage du mot : chaque fragment a son propre verrou
+   * et sa propre liste LRU, ce qui permet des lectures concurrentes.
+   * Une capacité nulle désactive le cache.
+   *
+   */
+   class CacheRadicaux
+   {
+   public:
+
+      static const std::size_t NB_FRAGMENTS_DEFAUT = 8;
+
+      /**
+      * \brief Constructeur
+      *
+      * \post Un cache vide de la capacité demandée (totale, répartie entre les fragments) est créé.
+      */
+      explicit CacheRadicaux(std::size_t capacite = 0, std::size_t nbFragments = NB_FRAGMENTS_DEFAUT);
+
+      /**
+      * \brief Déplacement, sans allocation : source reste un cache inactif sans fragment,
+      *        recréés par redimensionner
+      *
+      * \pre Aucun autre fil d'exécution n'utilise source.
+      */
+      CacheRadicaux(CacheRadicaux&& source) noexcept;
+      CacheRadicaux& operator=(CacheRadicaux&& source) noexcept;
+
+      /**
+      * \brief Cherche mot dans le cache
+      *
+      * \post Si mot est présent, il devient le plus récemment utilisé de son fragment
+      *       et son résultat est copié dans resultat.
+      * \return vrai si mot est dans le cache
+      */
+      bool chercher(const std::string& mot, std::optional<std::string>& resultat);
+
+      /**
+      * \brief Conserve le résultat de la recherche de mot, en évinçant au besoin le moins récemment utilisé
+      */
+      void inserer(const std::string& mot, const std::optional<std::string>& resultat);
+
+      /**
+      * \brief Retire mot du cache s'il y est
+      */
+      void invalider(const std::string& mot);
+
+      /**
+      * \brief Vide le cache
+      */
+      void vider();
+
+      /**
+      * \brief Change la capacité du cache. Le contenu est vidé.
+      */
+      void redimensionner(std::size_t capacite);
+
+      bool estActif() const { return capaciteParFragment != 0; }
+
+      std::size_t capacite() const { return capaciteParFragment * nbFragments; }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+   private:
+
+      struct Fragment
+      {
+         typedef std::list< std::pair<std::string, std::optional<std::string> > > ListeLRU;
+
+         std::mutex verrou;
+         ListeLRU entrees;                                                // Du plus récent au plus ancien.
+         std::unordered_map<std::string, ListeLRU::iterator> positions;   // Mot -> position dans entrees.
+      };
+
+      Fragment& fragmentDe(const std::string& mot);
+
+      std::size_t nbFragments;
+      std::size_t capaciteParFragment;
+      std::unique_ptr<Fragment[]> fragments;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,78 @@
+/**
+* \file DicoPartage.cpp
+* \brief Le code des opérateurs de DicoPartage.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "DicoPartage.h"
+
+namespace TP3
+{
+
+    /**
+    * \brief Constructeur
+    *
+    * \post dico (déplacé, en O(1)) est la version courante.
+    */
+    DicoPartage::DicoPartage(DicoSynonymes&& dico)
+        : courant(std::make_shared<const DicoSynonymes>(std::move(dico)))
+    {
+    }
+
+    /**
+    * \brief Constructeur : la version courante est un dictionnaire vide
+    */
+    DicoPartage::DicoPartage() : courant(std::make_shared<const DicoSynonymes>())
+    {
+    }
+
+    /**
+    * \brief Retourne la version courante ; peut être appelée depuis n'importe quel fil
+    *
+    * \post La version retournée reste valide et inchangée tant que le pointeur est gardé.
+    */
+    std::shared_ptr<const DicoSynonymes> DicoPartage::acquerir() const
+    {
+        return std::atomic_load(&courant);
+    }
+
+    /**
+    * \brief Remplace atomiquement la version courante par dico (déplacé, en O(1))
+    *
+    * \return l'ancienne version
+    *
+    * \exception bad_alloc s'il n'y a pas assez de mémoire.
+    */
+    std::shared_ptr<const DicoSynonymes> DicoPartage::publier(DicoSynonymes&& dico)
+    {
+        std::shared_ptr<const DicoSynonymes> nouveau = std::make_shared<const DicoSynonymes>(std::move(dico));
+        std::lock_guard<std::mutex> garde(verrouEcrivains);
+        return std::atomic_exchange(&courant, nouveau);
+    }
+
+    /**
+    * \brief Applique modification à une copie de la version courante, puis publie la copie
+    *
+    * \post Si modification lance une exception, rien n'est publié et l'exception est relancée.
+    *
+    * \exception bad_alloc s'il n'y a pas assez de mémoire.
+    */
+    void DicoPartage::modifier(const std::function<void(DicoSynonymes&)>& modification)
+    {
+        std::shared_ptr<const DicoSynonymes> ancien;
+        {
+            std::lock_guard<std::mutex> garde(verrouEcrivains);
+            // les lecteurs continuent sur la version courante pendant la copie et la modification
+            DicoSynonymes copie = std::atomic_load(&courant)->cloner();
+            modification(copie);
+            ancien = std::atomic_exchange(&courant, std::make_shared<const DicoSynonymes>(std::move(copie)));
+        }
+        // ancien est détruit ici, hors du verrou, si aucun lecteur ne le tient encore
+    }
+
+}//Fin du namespace
@@ -0,0 +1,95 @@
+/**
+* \file DicoPartage.h
+* \brief Interface du type DicoPartage
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <memory>
+#include <mutex>
+#include <functional>
+
+#include "DicoSynonymes.h"
+
+#ifndef _DICOPARTAGE__H
+#define _DICOPARTAGE__H
+
+namespace TP3
+{
+
+   /**
+   * \class DicoPartage
+   *
+   * \brief Publie une version d'un DicoSynonymes à des lecteurs simultanés et la remplace atomiquement.
+   *
+   * Un lecteur obtient par acquerir un pointeur partagé sur la version courante, qu'il consulte
+   * aussi longtemps qu'il le garde. publier installe une nouvelle version sans attendre les
+   * lecteurs : ceux qui tiennent l'ancienne la consultent jusqu'au bout, et elle est détruite
+   * quand le dernier pointeur disparaît. Une version publiée n'est plus jamais modifiée.
+   *
+   * Pour recharger sans interrompre les lecteurs, on charge un nouveau dictionnaire à côté puis on
+   * le publie ; pour une petite modification, modifier l'applique à une copie (cloner) de la version courante.
+   *
+   */
+   class DicoPartage
+   {
+   public:
+
+      /**
+      * \brief Constructeur
+      *
+      * \post dico (déplacé, en O(1)) est la version courante.
+      */
+      explicit DicoPartage(DicoSynonymes&& dico);
+
+      /**
+      * \brief Constructeur : la version courante est un dictionnaire vide
+      */
+      DicoPartage();
+
+      DicoPartage(const DicoPartage&) = delete;
+      DicoPartage& operator=(const DicoPartage&) = delete;
+
+      /**
+      * \brief Retourne la version courante ; peut être appelée depuis n'importe quel fil
+      *
+      * \post La version retournée reste valide et inchangée tant que le pointeur est gardé.
+      */
+      std::shared_ptr<const DicoSynonymes> acquerir() const;
+
+      /**
+      * \brief Remplace atomiquement la version courante par dico (déplacé, en O(1))
+      *
+      * \post Les appels suivants de acquerir retournent la nouvelle version.
+      * \return l'ancienne version : si l'appelant garde le dernier pointeur sur celle-ci,
+      *         c'est lui, et non un lecteur, qui paie sa destruction.
+      *
+      * \exception bad_alloc s'il n'y a pas assez de mémoire.
+      */
+      std::shared_ptr<const DicoSynonymes> publier(DicoSynonymes&& dico);
+
+      /**
+      * \brief Applique modification à une copie de la version courante, puis publie la copie
+      *
+      * Les appels de modifier et de publier sont faits l'un après l'autre : aucune modification
+      * n'est perdue.
+      *
+      * \post Si modification lance une exception, rien n'est publié et l'exception est relancée.
+      *
+      * \exception bad_alloc s'il n'y a pas assez de mémoire.
+      */
+      void modifier(const std::function<void(DicoSynonymes&)>& modification);
+
+   private:
+
+      std::shared_ptr<const DicoSynonymes> courant;   // Lu et remplacé seulement par std::atomic_load / std::atomic_exchange.
+      std::mutex verrouEcrivains;                     // Rend publier et modifier mutuellement exclusifs.
+   };
+
+}//Fin du namespace
+
+#endif
@@ -14,13 +14,32 @@
 namespace TP3
 {
 
+    // En deçà de ce nombre de noeuds, les deux moitiés d'une scission sont traitées dans le même fil.
+    static const int SEUIL_PARALLELE = 4096;
+
+    /**
+    * \fn int profondeurParallele(unsigned int nbFils)
+    * \brief Nombre de niveaux de récursion à dédoubler pour occuper nbFils fils (0 : autant que de coeurs)
+    */
+    static int profondeurParallele(unsigned int nbFils)
+    {
+        if (nbFils == 0) nbFils = std::max(1u, std::thread::hardware_concurrency());
+        int profondeur = 0;
+        while ((2u << profondeur) <= nbFils) ++profondeur;
+        return profondeur;
+    }
+
     /**
     *\brief     Constructeur
     *
     *\post      Une instance vide de la classe a été initialisée
     *
     */
-    DicoSynonymes::DicoSynonymes() : racine(0),nbRadicaux(0), groupesSynonymes(std::vector< std::list<NoeudDicoSynonymes*> >{}){
+    template <class Traits>
+    DicoSynonymesGenerique<Traits>::DicoSynonymesGenerique() : racine(0),nbRadicaux(0), groupesSynonymes(std::vector< std::list<NoeudDicoSynonymes*> >{}),
+                                     compressionFlexions(false), grapheSynonymesAJour(false),
+                                     raciniseurAJour(false), raciniseurActif(false), seuilConsolidation(0), trace(0),
+                                     motsParLongueurAJour(false){
     }
 
     /**
@@ -35,21 +54,17 @@ namespace TP3
       *\exception bad_alloc s'il n'y a pas assez de mémoire
       * Cette méthode appelle chargerDicoSynonyme !
       */
-    DicoSynonymes::DicoSynonymes(std::ifstream &fichier){
-        if (!fichier.is_open())
-        {
-            racine = 0;
-            nbRadicaux = 0;
-            groupesSynonymes = std::vector< std::list<NoeudDicoSynonymes*> >{};
-        }
-        else
+    template <class Traits>
+    DicoSynonymesGenerique<Traits>::DicoSynonymesGenerique(std::ifstream &fichier) : DicoSynonymesGenerique(){
+        if (fichier.is_open())
         {
             chargerDicoSynonyme(fichier);
         }
     }
 
 	// Méthode fournie
-	void DicoSynonymes::chargerDicoSynonyme(std::ifstream& fichier)
+	template <class Traits>
+	void DicoSynonymesGenerique<Traits>::chargerDicoSynonyme(std::ifstream& fichier)
 	{
         if (!fichier.is_open())
             throw std::logic_error("DicoSynonymes::chargerDicoSynonyme: Le fichier n'est pas ouvert !");
@@ -77,21 +92,23 @@ namespace TP3
 			else if (cat == 2)
 			{
 				std::stringstream ss(ligne);
+				std::vector<std::string> flexions;
 				while (ss >> buffer)
-					ajouterFlexion(radical, buffer);
+					flexions.push_back(buffer);
+				ajouterFlexions(radical, flexions);
 				cat = 1;
 			}
 			else
 			{
 				std::stringstream ss(ligne);
 				ss >> radical;
-				ss >> buffer;
-				int position = -1;
-				ajouterSynonyme(radical, buffer, position);
+				std::vector<std::string> synonymes;
 				while (ss >> buffer)
-					ajouterSynonyme(radical, buffer, position);
+					synonymes.push_back(buffer);
+				ajouterGroupeSynonymes(radical, synonymes);
 			}
 		}
+		reconstruireFiltre();
 	}
 
     /**
@@ -100,7 +117,146 @@ namespace TP3
       *\post      Une instance de la classe est détruite.
       *
       */
-    DicoSynonymes::~DicoSynonymes(){
+    template <class Traits>
+    DicoSynonymesGenerique<Traits>::~DicoSynonymesGenerique(){
+        auxDetruire(racine);
+    }
+
+    /**
+      *\brief     Constructeur de déplacement, en O(1)
+      *
+      *\post      L'instance reçoit le contenu de autre, qui devient vide. Rien n'est alloué.
+      */
+    template <class Traits>
+    DicoSynonymesGenerique<Traits>::DicoSynonymesGenerique(DicoSynonymesGenerique&& autre) noexcept
+        : allocateurNoeuds(std::move(autre.allocateurNoeuds)), racine(autre.racine), nbRadicaux(autre.nbRadicaux),
+          groupesSynonymes(std::move(autre.groupesSynonymes)), suffixes(std::move(autre.suffixes)),
+          compressionFlexions(autre.compressionFlexions), indexTrigrammes(std::move(autre.indexTrigrammes)),
+          cacheRadicaux(std::move(autre.cacheRadicaux)), filtreMots(std::move(autre.filtreMots)),
+          grapheSynonymes(std::move(autre.grapheSynonymes)), grapheSynonymesAJour(autre.grapheSynonymesAJour),
+          raciniseurSuffixes(std::move(autre.raciniseurSuffixes)), raciniseurAJour(autre.raciniseurAJour),
+          raciniseurActif(autre.raciniseurActif), seuilConsolidation(autre.seuilConsolidation), trace(autre.trace),
+          motsParLongueur(std::move(autre.motsParLongueur)), radicauxBalayes(std::move(autre.radicauxBalayes)),
+          motsParLongueurAJour(autre.motsParLongueurAJour){
+        autre.viderApresDeplacement();
+    }
+
+    /**
+      *\brief     Affectation par déplacement : l'ancien contenu est détruit, celui de autre est pris en O(1)
+      *
+      *\post      autre devient vide. Se déplacer dans soi-même ne fait rien.
+      */
+    template <class Traits>
+    DicoSynonymesGenerique<Traits>& DicoSynonymesGenerique<Traits>::operator=(DicoSynonymesGenerique&& autre) noexcept{
+        if (this != &autre)
+        {
+            // l'ancien contenu part avec le temporaire
+            DicoSynonymesGenerique temporaire(std::move(autre));
+            echanger(temporaire);
+        }
+        return *this;
+    }
+
+    /**
+      *\brief     Échanger les contenus de deux dictionnaires, en O(1)
+      *
+      *\post      Les verrous restent à leur instance ; tout le reste est échangé, vues à jour comprises.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::echanger(DicoSynonymesGenerique& autre) noexcept{
+        if (this == &autre) return;
+
+        std::swap(allocateurNoeuds, autre.allocateurNoeuds);
+        std::swap(racine, autre.racine);
+        std::swap(nbRadicaux, autre.nbRadicaux);
+        std::swap(groupesSynonymes, autre.groupesSynonymes);
+        std::swap(suffixes, autre.suffixes);
+        std::swap(compressionFlexions, autre.compressionFlexions);
+        std::swap(indexTrigrammes, autre.indexTrigrammes);
+        std::swap(cacheRadicaux, autre.cacheRadicaux);
+        std::swap(filtreMots, autre.filtreMots);
+        std::swap(grapheSynonymes, autre.grapheSynonymes);
+        std::swap(grapheSynonymesAJour, autre.grapheSynonymesAJour);
+        std::swap(raciniseurSuffixes, autre.raciniseurSuffixes);
+        std::swap(raciniseurAJour, autre.raciniseurAJour);
+        std::swap(raciniseurActif, autre.raciniseurActif);
+        std::swap(seuilConsolidation, autre.seuilConsolidation);
+        std::swap(trace, autre.trace);
+        std::swap(motsParLongueur, autre.motsParLongueur);
+        std::swap(radicauxBalayes, autre.radicauxBalayes);
+        std::swap(motsParLongueurAJour, autre.motsParLongueurAJour);
+    }
+
+    /**
+    * \fn void viderApresDeplacement()
+    * \brief Fonction remettant à vide un dictionnaire dont le contenu vient d'être déplacé, sans allocation.
+    *        Le cache et le filtre déplacés sont inactifs ; les vues dérivées sont marquées périmées et
+    *        seront reconstruites (raciniseur et balayage commencent par vider) au premier usage.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::viderApresDeplacement() noexcept {
+        racine = 0;
+        nbRadicaux = 0;
+        groupesSynonymes.clear();
+        suffixes.vider();
+        compressionFlexions = false;
+        indexTrigrammes.vider();
+        grapheSynonymesAJour = false;
+        raciniseurAJour = false;
+        raciniseurActif = false;
+        seuilConsolidation = 0;
+        trace = 0;
+        motsParLongueur.vider();
+        radicauxBalayes.clear();
+        motsParLongueurAJour = false;
+    }
+
+    /**
+      *\brief     Copie profonde du dictionnaire
+      *
+      *\post      Le dictionnaire reste inchangé ; la copie n'en partage aucun noeud.
+      *
+      *\exception bad_alloc s'il n'y a pas assez de mémoire.
+      */
+    template <class Traits>
+    DicoSynonymesGenerique<Traits> DicoSynonymesGenerique<Traits>::cloner() const{
+        DicoSynonymesGenerique copie;
+        // même table de suffixes : les flexions compressées gardent les mêmes codes
+        copie.suffixes = suffixes;
+        copie.compressionFlexions = compressionFlexions;
+        copie.racine = copie.copierSousArbre(*this, racine);
+        copie.nbRadicaux = nbRadicaux;
+
+        // les deux arbres ont la même forme : leurs parcours en ordre se correspondent
+        std::vector<NoeudDicoSynonymes*> originaux, copies;
+        originaux.reserve(nbRadicaux);
+        copies.reserve(nbRadicaux);
+        auxParcoursEnOrdre(racine, originaux);
+        copie.auxParcoursEnOrdre(copie.racine, copies);
+        std::unordered_map<const NoeudDicoSynonymes*, NoeudDicoSynonymes*> correspondants;
+        correspondants.reserve(originaux.size());
+        for (std::size_t i = 0; i < originaux.size(); ++i)
+        {
+            copies[i]->appSynonymes = originaux[i]->appSynonymes;
+            correspondants.emplace(originaux[i], copies[i]);
+        }
+
+        copie.groupesSynonymes.reserve(groupesSynonymes.size());
+        for (auto &groupe : groupesSynonymes)
+        {
+            std::list<NoeudDicoSynonymes*> liste;
+            for (auto adresse : groupe)
+                liste.push_back(correspondants.at(adresse));
+            copie.groupesSynonymes.push_back(std::move(liste));
+        }
+
+        copie.indexTrigrammes = indexTrigrammes;
+        copie.filtreMots = filtreMots;
+        copie.cacheRadicaux.redimensionner(cacheRadicaux.capacite());
+        copie.raciniseurActif = raciniseurActif;
+        copie.seuilConsolidation = seuilConsolidation;
+        copie.trace = trace;
+        return copie;
     }
 
     /**
@@ -114,11 +270,15 @@ namespace TP3
       *\exception bad_alloc si il n'y a pas suffisament de mémoire.
       *\exception logic_error si le radical existe déjà.
       */
-    void DicoSynonymes::ajouterRadical(const std::string& motRadical){
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::ajouterRadical(const std::string& motRadicalBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::AjoutRadical, motRadicalBrut);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
         if (radicalDansDico(motRadical))
             throw std::logic_error("ajouterRadical : Le radical est déjà dans le dictionnaire");
 
         auxajouterRadical(motRadical, racine);
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
     }
 
     /**
@@ -131,7 +291,11 @@ namespace TP3
      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
      *\exception logic_error si motFlexion existe déjà ou motRadical n'existe pas.
      */
-    void DicoSynonymes::ajouterFlexion(const std::string& motRadical, const std::string& motFlexion){
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::ajouterFlexion(const std::string& motRadicalBrut, const std::string& motFlexionBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::AjoutFlexion, motRadicalBrut, motFlexionBrut);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        const std::string& motFlexion = Traits::normaliser(motFlexionBrut);
         if (!radicalDansDico(motRadical))
             throw std::logic_error("ajouterFlexion : Le radical n'est pas dans le dictionnaire");
 
@@ -139,6 +303,7 @@ namespace TP3
         // voir dans la fonction auxAjouterFlexion
 
         auxAjouterFlexion(motRadical, motFlexion, racine);
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
     }
 
     /**
@@ -156,24 +321,21 @@ namespace TP3
       *\exception logic_error si motSynonyme est déjà dans la liste des synonymes du motRadical
       *\exception logic_error si numGroupe n'est pas correct ou motRadical n'existe pas.
       */
-    void DicoSynonymes::ajouterSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe){
-        if (numGroupe != - 1 && numGroupe > groupesSynonymes.size() - 1)
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::ajouterSynonyme(const std::string& motRadicalBrut, const std::string& motSynonymeBrut, int& numGroupe){
+        TraceDico::Garde enregistrement(trace, TraceDico::AjoutSynonyme, motRadicalBrut, motSynonymeBrut, numGroupe);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        const std::string& motSynonyme = Traits::normaliser(motSynonymeBrut);
+        if (numGroupe != - 1 && (numGroupe < 0 || static_cast<std::size_t>(numGroupe) >= groupesSynonymes.size()))
             throw std::logic_error("ajouterSynonyme : Le numéro de groupe est invalide");
         if (!radicalDansDico(motRadical))
             throw std::logic_error("ajouterSynonyme : Le radical n'est pas dans le dictionnaire");
         if (!radicalDansDico(motSynonyme))
             ajouterRadical(motSynonyme);
 
-        std::vector<NoeudDicoSynonymes*> arbre = parcoursPreOrdre();
-        NoeudDicoSynonymes* adresseRadical;
-        NoeudDicoSynonymes* adresseSynonyme;
-
         //Détermine les adresses des mots radical et synonymes
-        for(auto noeud : arbre)
-        {
-            if (noeud->radical == motRadical) adresseRadical = noeud;
-            if(noeud->radical == motSynonyme) adresseSynonyme = noeud;
-        }
+        NoeudDicoSynonymes* adresseRadical = trouverNoeud(motRadical);
+        NoeudDicoSynonymes* adresseSynonyme = trouverNoeud(motSynonyme);
 
         // Si le groupe n'existe pas faire une nouvelle liste et l'ajouter au vecteur groupeSynonymes
         if (numGroupe == -1)
@@ -214,6 +376,504 @@ namespace TP3
         }
         // ajout du groupe de synonyme au synonyme
         adresseSynonyme->appSynonymes.push_back(numGroupe);
+        grapheSynonymesAJour = false;
+
+        if (seuilConsolidation > 0) numGroupe = consoliderGroupe(numGroupe);
+    }
+
+    /**
+     *\brief  Ajouter plusieurs flexions (motsFlexions) d'un radical (motRadical) en une seule descente.
+     *
+     *\pre    Il y a suffisament de mémoire.
+     *
+     *\post   Les flexions sont ajoutées, dans l'ordre, au dictionnaire des synonymes.
+     *
+     *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+     *\exception logic_error si une des flexions existe déjà (ou est répétée) ou motRadical n'existe pas.
+     *\       Dans ce cas, aucune flexion n'est ajoutée.
+     */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::ajouterFlexions(const std::string& motRadicalBrut, const std::vector<std::string>& motsFlexionsBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::AjoutFlexions, motRadicalBrut, motsFlexionsBrut);
+        std::vector<std::string> copieMotsFlexions;
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        const std::vector<std::string>& motsFlexions = normaliserTous(motsFlexionsBrut, copieMotsFlexions);
+        NoeudDicoSynonymes* noeud = trouverNoeud(motRadical);
+        if (noeud == 0)
+            throw std::logic_error("ajouterFlexions : Le radical n'est pas dans le dictionnaire");
+
+        // validation complète avant toute modification
+        std::vector<std::string> tries(motsFlexions);
+        std::sort(tries.begin(), tries.end());
+        if (std::adjacent_find(tries.begin(), tries.end()) != tries.end())
+            throw std::logic_error("ajouterFlexions : Une flexion est répétée dans le lot");
+        for (auto &flexion : motsFlexions)
+            if (flexionPresente(noeud, flexion))
+                throw std::logic_error("ajouterFlexions : La flexion est déjà présente dans le radical");
+
+        for (auto &flexion : motsFlexions)
+        {
+            insererFlexion(noeud, flexion);
+            indexTrigrammes.ajouterMot(noeud->radical, flexion);
+            filtreMots.ajouter(flexion);
+            cacheRadicaux.invalider(flexion);
+        }
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
+    }
+
+    /**
+      *\brief  Créer un nouveau groupe de synonymes contenant motRadical et motsSynonymes.
+      *
+      *\pre    Le radical se trouve déjà dans le dictionnaire
+      *\       Il y a suffisament de mémoire
+      *
+      *\post   Les synonymes absents du dictionnaire y sont ajoutés comme radicaux.
+      *\       Le numéro du nouveau groupe est retourné.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire
+      *\exception logic_error si motRadical n'existe pas ou si un synonyme est répété.
+      */
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::ajouterGroupeSynonymes(const std::string& motRadicalBrut, const std::vector<std::string>& motsSynonymesBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::AjoutGroupeSynonymes, motRadicalBrut, motsSynonymesBrut);
+        std::vector<std::string> copieMotsSynonymes;
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        const std::vector<std::string>& motsSynonymes = normaliserTous(motsSynonymesBrut, copieMotsSynonymes);
+        if (!radicalDansDico(motRadical))
+            throw std::logic_error("ajouterGroupeSynonymes : Le radical n'est pas dans le dictionnaire");
+
+        std::vector<std::string> tries(motsSynonymes);
+        tries.push_back(motRadical);
+        std::sort(tries.begin(), tries.end());
+        if (std::adjacent_find(tries.begin(), tries.end()) != tries.end())
+            throw std::logic_error("ajouterGroupeSynonymes : Un synonyme est répété dans le groupe");
+
+        for (auto &synonyme : motsSynonymes)
+            if (!radicalDansDico(synonyme)) ajouterRadical(synonyme);
+
+        // les adresses ne sont prises qu'une fois tous les ajouts (et rotations) faits
+        int numGroupe = groupesSynonymes.size();
+        NoeudDicoSynonymes* adresseRadical = trouverNoeud(motRadical);
+        std::list<NoeudDicoSynonymes*> nouvelleListe {adresseRadical};
+        adresseRadical->appSynonymes.push_back(numGroupe);
+        for (auto &synonyme : motsSynonymes)
+        {
+            NoeudDicoSynonymes* adresseSynonyme = trouverNoeud(synonyme);
+            nouvelleListe.push_back(adresseSynonyme);
+            adresseSynonyme->appSynonymes.push_back(numGroupe);
+        }
+        groupesSynonymes.push_back(nouvelleListe);
+        grapheSynonymesAJour = false;
+
+        if (seuilConsolidation > 0) numGroupe = consoliderGroupe(numGroupe);
+        return numGroupe;
+    }
+
+    /**
+      *\brief  Appliquer un lot de mutations.
+      *
+      *\pre    Il y a suffisament de mémoire.
+      *
+      *\post   Les mutations sont appliquées.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      *\exception logic_error dans les mêmes cas que la méthode correspondant à chaque mutation.
+      *\       Les mutations traitées avant la mutation fautive (dans l'ordre trié) restent appliquées.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::appliquerLot(std::vector<Mutation> mutations){
+        TraceDico::Garde enregistrement(trace, TraceDico::ApplicationLot, mutations);
+        if (NORMALISE)
+            for (auto &mutation : mutations)
+            {
+                mutation.radical = Traits::normaliser(mutation.radical);
+                mutation.flexion = Traits::normaliser(mutation.flexion);
+            }
+        std::stable_sort(mutations.begin(), mutations.end(),
+                         [](const Mutation& a, const Mutation& b) { return Traits::inferieur(a.radical, b.radical); });
+
+        // un seul parcours fusionné trouve le noeud de chaque radical du lot (debuts[g] : première
+        // mutation du radical g)
+        std::vector<std::string> radicaux;
+        std::vector<std::size_t> debuts;
+        for (std::size_t i = 0; i < mutations.size(); ++i)
+            if (i == 0 || mutations[i].radical != mutations[i - 1].radical)
+            {
+                radicaux.push_back(mutations[i].radical);
+                debuts.push_back(i);
+            }
+        debuts.push_back(mutations.size());
+        std::vector<NoeudDicoSynonymes*> noeuds(radicaux.size(), 0);
+        auxLocaliser(racine, radicaux, 0, radicaux.size(), noeuds);
+
+        // Les radicaux absents dont la première mutation est un ajout et qui ne sont pas
+        // supprimés dans le lot sont réunis à l'arbre tous ensemble.
+        std::vector<std::string> nouveauxRadicaux;
+        std::vector<std::size_t> groupesNouveaux;
+        std::vector<bool> dejaInsere(mutations.size(), false);
+        for (std::size_t g = 0; g < radicaux.size(); ++g)
+        {
+            bool supprime = false;
+            for (std::size_t i = debuts[g]; i < debuts[g + 1]; ++i)
+                if (mutations[i].type == Mutation::SuppressionRadical) supprime = true;
+            if (mutations[debuts[g]].type == Mutation::AjoutRadical && !supprime && noeuds[g] == 0)
+            {
+                nouveauxRadicaux.push_back(radicaux[g]);
+                groupesNouveaux.push_back(g);
+                dejaInsere[debuts[g]] = true;
+            }
+        }
+        std::vector<NoeudDicoSynonymes*> nouveaux = fusionnerRadicaux(nouveauxRadicaux);
+        for (std::size_t j = 0; j < nouveaux.size(); ++j) noeuds[groupesNouveaux[j]] = nouveaux[j];
+
+        // supprimer un radical à deux enfants déplace son successeur dans son noeud : seul le
+        // radical suivant du lot peut en être touché, on le cherche alors à nouveau
+        NoeudDicoSynonymes* noeud = 0;
+        std::size_t groupe = 0;
+        bool relocaliser = false;
+        for (std::size_t i = 0; i < mutations.size(); ++i)
+        {
+            const Mutation& mutation = mutations[i];
+            if (i == 0 || mutation.radical != mutations[i - 1].radical)
+            {
+                noeud = relocaliser ? trouverNoeud(mutation.radical) : noeuds[groupe];
+                relocaliser = false;
+                ++groupe;
+            }
+            if (dejaInsere[i]) continue;
+
+            switch (mutation.type)
+            {
+            case Mutation::AjoutRadical:
+                ajouterRadical(mutation.radical);
+                noeud = trouverNoeud(mutation.radical);
+                break;
+            case Mutation::AjoutFlexion:
+                if (noeud == 0)
+                    throw std::logic_error("appliquerLot : Le radical n'est pas dans le dictionnaire");
+                if (!insererFlexion(noeud, mutation.flexion))
+                    throw std::logic_error("appliquerLot : La flexion est déjà présente dans le radical");
+                indexTrigrammes.ajouterMot(noeud->radical, mutation.flexion);
+                filtreMots.ajouter(mutation.flexion);
+                cacheRadicaux.invalider(mutation.flexion);
+                break;
+            case Mutation::SuppressionFlexion:
+                if (noeud == 0)
+                    throw std::logic_error("appliquerLot : Le radical n'est pas dans le dictionnaire");
+                if (!retirerFlexion(noeud, mutation.flexion))
+                    throw std::logic_error("appliquerLot : La flexion n'est pas présente dans le radical");
+                filtreMots.signalerRetrait();
+                cacheRadicaux.invalider(mutation.flexion);
+                break;
+            case Mutation::SuppressionRadical:
+                supprimerRadical(mutation.radical);
+                noeud = 0;
+                relocaliser = true;
+                break;
+            }
+        }
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
+    }
+
+    /**
+      *\brief  Calculer les changements qui donnent au dictionnaire le contenu de fichier (format de chargerDicoSynonyme).
+      *
+      *\post   Le dictionnaire reste inchangé.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      *\exception logic_error si fichier serait refusé par chargerDicoSynonyme.
+      */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::Difference DicoSynonymesGenerique<Traits>::calculerDifference(std::istream& fichier) const{
+        Difference difference;
+        std::unordered_set<std::string> radicauxFichier;     // Radicaux qu'aurait le dictionnaire chargé.
+        std::vector<std::string> synonymesSansFlexion;       // Radicaux ajoutés par la section des groupes.
+
+        // même lecture que chargerDicoSynonyme, lignes vides et fin de fichier comprises
+        std::string ligne;
+        std::string buffer;
+        std::string radical;
+        int cat = 1;
+
+        while (!fichier.eof())
+        {
+            std::getline(fichier, ligne);
+
+            if (ligne == "$")
+            {
+                // un radical sans ligne de flexions n'en a aucune
+                if (cat == 2) differenceFlexions(radical, std::vector<std::string>(), difference.mutations);
+                cat = 3;
+                std::getline(fichier, ligne);
+            }
+            if (cat == 1)
+            {
+                radical = Traits::normaliser(ligne);
+                if (!radicauxFichier.insert(radical).second)
+                    throw std::logic_error("calculerDifference : Le radical est répété dans le fichier");
+                cat = 2;
+            }
+            else if (cat == 2)
+            {
+                std::stringstream ss(ligne);
+                std::vector<std::string> flexions;
+                while (ss >> buffer)
+                    flexions.push_back(Traits::normaliser(buffer));
+                differenceFlexions(radical, flexions, difference.mutations);
+                cat = 1;
+            }
+            else
+            {
+                std::stringstream ss(ligne);
+                ss >> radical;
+                if (NORMALISE) radical = Traits::normaliser(radical);
+                std::vector<std::string> membres {radical};
+                while (ss >> buffer)
+                    membres.push_back(Traits::normaliser(buffer));
+
+                if (radicauxFichier.count(radical) == 0)
+                    throw std::logic_error("calculerDifference : Le radical d'un groupe n'est pas dans le fichier");
+                std::vector<std::string> tries(membres);
+                std::sort(tries.begin(), tries.end());
+                if (std::adjacent_find(tries.begin(), tries.end()) != tries.end())
+                    throw std::logic_error("calculerDifference : Un synonyme est répété dans un groupe");
+                for (std::size_t i = 1; i < membres.size(); ++i)
+                    if (radicauxFichier.insert(membres[i]).second) synonymesSansFlexion.push_back(membres[i]);
+
+                // un groupe est gardé tel quel si ses membres, dans l'ordre, sont les mêmes
+                int numGroupe = difference.nbGroupes++;
+                bool identique = numGroupe < static_cast<int>(groupesSynonymes.size())
+                                 && groupesSynonymes[numGroupe].size() == membres.size()
+                                 && std::equal(membres.begin(), membres.end(), groupesSynonymes[numGroupe].begin(),
+                                               [](const std::string& membre, const NoeudDicoSynonymes* noeud)
+                                               { return membre == noeud->radical; });
+                if (!identique) difference.groupesModifies.emplace_back(numGroupe, membres);
+            }
+        }
+        if (cat == 2) differenceFlexions(radical, std::vector<std::string>(), difference.mutations);
+
+        for (auto &synonyme : synonymesSansFlexion)
+            differenceFlexions(synonyme, std::vector<std::string>(), difference.mutations);
+
+        std::vector<NoeudDicoSynonymes*> noeuds;
+        noeuds.reserve(nbRadicaux);
+        auxParcoursEnOrdre(racine, noeuds);
+        for (auto noeud : noeuds)
+        {
+            if (radicauxFichier.count(noeud->radical) == 0)
+                difference.mutations.push_back({Mutation::SuppressionRadical, noeud->radical, ""});
+            // chargerDicoSynonyme numérote les groupes d'un radical en ordre croissant
+            else if (std::adjacent_find(noeud->appSynonymes.begin(), noeud->appSynonymes.end(),
+                                        std::greater_equal<int>()) != noeud->appSynonymes.end())
+                difference.appartenancesATrier.push_back(noeud->radical);
+        }
+        return difference;
+    }
+
+    /**
+      *\brief  Appliquer une différence calculée par calculerDifference.
+      *
+      *\pre    Le dictionnaire n'a pas été modifié depuis le calcul de difference.
+      *\       Il y a suffisament de mémoire.
+      *
+      *\post   Le dictionnaire est identique à celui qu'on obtiendrait en chargeant le fichier.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::appliquerDifference(const Difference& difference){
+        // les radicaux supprimés sont retirés de leurs groupes, qui sont tous modifiés ou en trop
+        appliquerLot(difference.mutations);
+
+        // radicaux dont les numéros de groupes sont à refaire : membres, avant et après, des groupes changés
+        std::vector<NoeudDicoSynonymes*> aRefaire;
+        for (std::size_t g = difference.nbGroupes; g < groupesSynonymes.size(); ++g)
+            aRefaire.insert(aRefaire.end(), groupesSynonymes[g].begin(), groupesSynonymes[g].end());
+        bool groupesChanges = groupesSynonymes.size() != static_cast<std::size_t>(difference.nbGroupes)
+                              || !difference.groupesModifies.empty();
+        groupesSynonymes.resize(difference.nbGroupes);
+
+        std::vector<bool> estModifie(difference.nbGroupes, false);
+        std::unordered_map<NoeudDicoSynonymes*, std::vector<int> > nouvellesAppartenances;
+        for (auto &groupe : difference.groupesModifies)
+        {
+            int numGroupe = groupe.first;
+            estModifie[numGroupe] = true;
+            aRefaire.insert(aRefaire.end(), groupesSynonymes[numGroupe].begin(), groupesSynonymes[numGroupe].end());
+
+            std::list<NoeudDicoSynonymes*> nouvelleListe;
+            for (auto &membre : groupe.second)
+            {
+                NoeudDicoSynonymes* noeud = trouverNoeud(membre);
+                nouvelleListe.push_back(noeud);
+                aRefaire.push_back(noeud);
+                nouvellesAppartenances[noeud].push_back(numGroupe);
+            }
+            groupesSynonymes[numGroupe].swap(nouvelleListe);
+        }
+        for (auto &motRadical : difference.appartenancesATrier)
+            aRefaire.push_back(trouverNoeud(motRadical));
+
+        std::sort(aRefaire.begin(), aRefaire.end());
+        aRefaire.erase(std::unique(aRefaire.begin(), aRefaire.end()), aRefaire.end());
+        for (auto noeud : aRefaire)
+        {
+            std::vector<int> appartenances;
+            for (auto numGroupe : noeud->appSynonymes)
+                if (numGroupe < difference.nbGroupes && !estModifie[numGroupe]) appartenances.push_back(numGroupe);
+            auto it = nouvellesAppartenances.find(noeud);
+            if (it != nouvellesAppartenances.end())
+                appartenances.insert(appartenances.end(), it->second.begin(), it->second.end());
+            std::sort(appartenances.begin(), appartenances.end());
+            appartenances.erase(std::unique(appartenances.begin(), appartenances.end()), appartenances.end());
+            noeud->appSynonymes.swap(appartenances);
+        }
+        if (groupesChanges) grapheSynonymesAJour = false;
+    }
+
+    /**
+      *\brief  Recharger le dictionnaire à partir d'une nouvelle version de son fichier, en ne modifiant
+      *\       que ce qui a changé.
+      *
+      *\pre    fichier est ouvert.
+      *
+      *\post   Voir appliquerDifference.
+      *
+      *\exception logic_error si fichier n'est pas ouvert ou dans les cas de calculerDifference ;
+      *\       le dictionnaire reste alors inchangé.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::rechargerIncrementiel(std::ifstream& fichier){
+        if (!fichier.is_open())
+            throw std::logic_error("DicoSynonymes::rechargerIncrementiel: Le fichier n'est pas ouvert !");
+
+        appliquerDifference(calculerDifference(fichier));
+    }
+
+    /**
+      *\brief  Ajouter au dictionnaire le contenu de autre (union des radicaux).
+      *
+      *\pre    Il y a suffisament de mémoire.
+      *
+      *\post   Un radical présent des deux côtés reçoit les flexions de autre qui lui manquent.
+      *\       Les groupes de synonymes de autre sont ajoutés à la suite de ceux du dictionnaire.
+      *\       autre reste inchangé ; fusionner un dictionnaire avec lui-même ne fait rien.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::fusionner(const DicoSynonymesGenerique& autre, unsigned int nbFils){
+        if (&autre == this || autre.estVide()) return;
+
+        int profondeur = profondeurParallele(nbFils);
+        NoeudDicoSynonymes* copie = copierSousArbre(autre, autre.racine);
+
+        // l'index, le filtre et le cache ne sont pas touchés par la réunion des arbres : ils sont mis à jour en même temps
+        auto indexation = std::async(profondeur > 0 ? std::launch::async : std::launch::deferred, [&] {
+            std::vector<NoeudDicoSynonymes*> noeudsAutre;
+            noeudsAutre.reserve(autre.nbRadicaux);
+            autre.auxParcoursEnOrdre(autre.racine, noeudsAutre);
+            for (auto noeud : noeudsAutre)
+            {
+                indexTrigrammes.ajouterMot(noeud->radical, noeud->radical);
+                filtreMots.ajouter(noeud->radical);
+                for (auto &flexion : autre.flexionsDe(noeud))
+                {
+                    indexTrigrammes.ajouterMot(noeud->radical, flexion);
+                    filtreMots.ajouter(flexion);
+                    cacheRadicaux.invalider(flexion);
+                }
+            }
+        });
+        racine = auxFusionner(racine, copie, profondeur);
+        nbRadicaux = tailleSousArbre(racine);
+        indexation.get();
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
+
+        // le groupe g de autre devient le groupe decalage + g, ses membres étant les noeuds de même radical
+        int decalage = groupesSynonymes.size();
+        for (std::size_t g = 0; g < autre.groupesSynonymes.size(); ++g)
+        {
+            std::list<NoeudDicoSynonymes*> groupe;
+            for (auto adresse : autre.groupesSynonymes[g])
+            {
+                NoeudDicoSynonymes* noeud = trouverNoeud(adresse->radical);
+                groupe.push_back(noeud);
+                noeud->appSynonymes.push_back(decalage + g);
+            }
+            groupesSynonymes.push_back(std::move(groupe));
+        }
+
+        grapheSynonymesAJour = false;
+        raciniseurAJour = false;
+        motsParLongueurAJour = false;
+    }
+
+    /**
+      *\brief  Ne garder que les radicaux qui sont aussi dans autre.
+      *
+      *\post   Les radicaux absents de autre sont supprimés comme par supprimerRadical.
+      *\       autre reste inchangé.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::intersection(const DicoSynonymesGenerique& autre, unsigned int nbFils){
+        if (&autre == this) return;
+
+        std::vector<NoeudDicoSynonymes*> retires;
+        racine = auxIntersection(racine, autre.racine, profondeurParallele(nbFils), retires);
+        detruireRetires(retires);
+    }
+
+    /**
+      *\brief  Retirer du dictionnaire les radicaux qui sont dans autre.
+      *
+      *\post   Les radicaux présents dans autre sont supprimés comme par supprimerRadical.
+      *\       autre reste inchangé ; la différence d'un dictionnaire avec lui-même le vide.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::difference(const DicoSynonymesGenerique& autre, unsigned int nbFils){
+        std::vector<NoeudDicoSynonymes*> retires;
+        if (&autre == this)
+        {
+            auxParcoursEnOrdre(racine, retires);
+            racine = 0;
+        }
+        else
+        {
+            racine = auxDifference(racine, autre.racine, profondeurParallele(nbFils), retires);
+        }
+        detruireRetires(retires);
+    }
+
+    /**
+      *\brief  Supprimer les radicaux r tels que debut <= r < fin.
+      *
+      *\post   Les radicaux de l'intervalle sont supprimés comme par supprimerRadical.
+      *\       Rien n'est fait si fin <= debut.
+      *
+      *\return le nombre de radicaux supprimés.
+      */
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::supprimerIntervalle(const std::string& debutBrut, const std::string& finBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::SuppressionIntervalle, debutBrut, finBrut);
+        const std::string& debut = Traits::normaliser(debutBrut);
+        const std::string& fin = Traits::normaliser(finBrut);
+        if (!Traits::inferieur(debut, fin)) return 0;
+
+        NoeudDicoSynonymes *inferieurs, *egalDebut, *reste;
+        scinder(racine, debut, inferieurs, egalDebut, reste);
+        NoeudDicoSynonymes *milieu, *egalFin, *superieurs;
+        scinder(reste, fin, milieu, egalFin, superieurs);
+
+        // debut fait partie de l'intervalle, fin non
+        std::vector<NoeudDicoSynonymes*> retires;
+        if (egalDebut != 0) retires.push_back(egalDebut);
+        auxParcoursEnOrdre(milieu, retires);
+        if (egalFin != 0) superieurs = joindre(0, egalFin, superieurs);
+        racine = concatener(inferieurs, superieurs);
+
+        detruireRetires(retires);
+        return retires.size();
     }
 
     /**
@@ -230,11 +890,32 @@ namespace TP3
      *
      *\exception logic_error si l'arbre est vide ou motRadical n'existe pas.
      */
-    void DicoSynonymes::supprimerRadical(const std::string& motRadical){
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::supprimerRadical(const std::string& motRadicalBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::SuppressionRadical, motRadicalBrut);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
         if (estVide()) throw std::logic_error("supprimerRadical : L'arbre est vide");
         if (!radicalDansDico(motRadical))
             throw std::logic_error("supprimerRadical : Le radical n'est pas dans le dictionnaire");
+
+        filtreMots.signalerRetrait(1 + nombreFlexions(trouverNoeud(motRadical)));
+
+        // seuls les mots qui étaient des flexions de ce radical peuvent changer de résultat
+        if (cacheRadicaux.estActif())
+            for (auto &flexion : flexionsDe(trouverNoeud(motRadical)))
+                cacheRadicaux.invalider(flexion);
+
+        // aucun groupe de synonymes ne doit garder de pointeur sur le noeud supprimé
+        detacherDesGroupes(trouverNoeud(motRadical));
+        grapheSynonymesAJour = false;
+        raciniseurAJour = false;
+        motsParLongueurAJour = false;
+
         auxSupprimerRadical(motRadical, racine);
+
+        indexTrigrammes.retirerRadical(motRadical);
+        if (indexTrigrammes.doitEtreReconstruit()) reconstruireIndexTrigrammes();
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
     }
 
     /**
@@ -248,7 +929,11 @@ namespace TP3
      *\exception logic_error si si l'arbre est vide ou
      *\exception motFlexion n'existe pas ou motRadical n'existe pas.
      */
-    void DicoSynonymes::supprimerFlexion(const std::string& motRadical, const std::string& motFlexion){
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::supprimerFlexion(const std::string& motRadicalBrut, const std::string& motFlexionBrut){
+        TraceDico::Garde enregistrement(trace, TraceDico::SuppressionFlexion, motRadicalBrut, motFlexionBrut);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        const std::string& motFlexion = Traits::normaliser(motFlexionBrut);
         if (estVide()) throw std::logic_error("supprimerFlexion : L'arbre est vide");
         if (!radicalDansDico(motRadical))
             throw std::logic_error("supprimerFlexion : Le radical n'est pas dans le dictionnaire");
@@ -257,6 +942,7 @@ namespace TP3
         // voir dans la fonction auxSupprimerFlexion
 
         auxSupprimerFlexion(motRadical, motFlexion, racine);
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
     }
 
     /**
@@ -267,14 +953,19 @@ namespace TP3
       *
       *\post      Le synonyme est enlevé du dictionnaire des synonymes.
       *
-      *\exception logic_error si motSynonyme ou motRadical ou numGroupe n'existent pas.
+      *\exception logic_error si motSynonyme ou motRadical ou numGroupe n'existent pas,
+      *\exception ou si motRadical ou motSynonyme n'appartient pas au groupe numGroupe.
       */
-    void DicoSynonymes::supprimerSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe){
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::supprimerSynonyme(const std::string& motRadicalBrut, const std::string& motSynonymeBrut, int& numGroupe){
+        TraceDico::Garde enregistrement(trace, TraceDico::SuppressionSynonyme, motRadicalBrut, motSynonymeBrut, numGroupe);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        const std::string& motSynonyme = Traits::normaliser(motSynonymeBrut);
         if (!radicalDansDico(motRadical))
             throw std::logic_error("supprimerSynonyme : Le radical n'est pas dans le dictionnaire");
         if (!radicalDansDico(motSynonyme))
             throw std::logic_error("supprimerSynonyme : Le synonyme n'est pas dans le dictionnaire");
-        if (numGroupe > groupesSynonymes.size() - 1)
+        if (numGroupe < 0 || static_cast<std::size_t>(numGroupe) >= groupesSynonymes.size())
             throw std::logic_error("supprimerSynonyme : Le numéro de groupe est invalide");
 
         bool radicalEstPresent = false;
@@ -287,21 +978,19 @@ namespace TP3
         if (radicalEstPresent)
         {
             // si le radical est présent, on détermine quelle adresse enlever
-            NoeudDicoSynonymes* adresseAEnlever;
+            NoeudDicoSynonymes* adresseAEnlever = 0;
             for(auto adresse : groupesSynonymes[numGroupe])
             {
                 if(adresse->radical == motSynonyme) adresseAEnlever = adresse;
             }
+            if (adresseAEnlever == 0)
+                throw std::logic_error("supprimerSynonyme : Le synonyme n'appartient pas au groupe de synonymes");
             groupesSynonymes[numGroupe].remove(adresseAEnlever);
 
-            std::vector<int>::iterator it = adresseAEnlever->appSynonymes.begin();
-            for (int i = 0; i < adresseAEnlever->appSynonymes.size(); ++i) {
-                if(adresseAEnlever->appSynonymes[i] == numGroupe)
-                {
-                    std::next(it, i);
-                    adresseAEnlever->appSynonymes.erase(it);
-                }
-            }
+            auto it = std::find(adresseAEnlever->appSynonymes.begin(), adresseAEnlever->appSynonymes.end(), numGroupe);
+            if (it != adresseAEnlever->appSynonymes.end())
+                adresseAEnlever->appSynonymes.erase(it);
+            grapheSynonymesAJour = false;
         }
         else
         {
@@ -315,20 +1004,137 @@ namespace TP3
       *\post      Le dictionnaire est inchangée
       *
       */
-    bool DicoSynonymes::estVide() const{
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::estVide() const{
         return nbRadicaux == 0;
     }
 
+    /**
+     * \brief Vérifie si motRadical est un radical du dictionnaire
+     *
+     * \post Le dictionnaire reste inchangé.
+     */
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::contientRadical(const std::string& motRadicalBrut) const{
+        TraceDico::Garde enregistrement(trace, TraceDico::ContientRadical, motRadicalBrut);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        return radicalDansDico(motRadical);
+    }
+
     /**
      * \brief Retourne le nombre de radicaux dans le dictionnaire
      *
      * \post Le dictionnaire reste inchangé.
      *
      */
-    int DicoSynonymes::nombreRadicaux() const{
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::nombreRadicaux() const{
         return nbRadicaux;
     }
 
+    /**
+    * \brief Retourne le radical de rang k (0 pour le plus petit en ordre alphabétique)
+    *
+    * \post Le dictionnaire reste inchangé.
+    *
+    * \exception logic_error si k n'est pas entre 0 et nombreRadicaux() - 1.
+    */
+    template <class Traits>
+    std::string DicoSynonymesGenerique<Traits>::radicalAuRang(int k) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::RadicalAuRang, k);
+        if (k < 0 || k >= nbRadicaux) throw std::logic_error("radicalAuRang : Le rang est invalide");
+
+        NoeudDicoSynonymes* noeud = racine;
+        while (true)
+        {
+            int tailleGauche = tailleSousArbre(noeud->gauche);
+            if (k == tailleGauche) return noeud->radical;
+            if (k < tailleGauche) noeud = noeud->gauche;
+            else
+            {
+                k -= tailleGauche + 1;
+                noeud = noeud->droit;
+            }
+        }
+    }
+
+    /**
+    * \brief Retourne le nombre de radicaux strictement inférieurs à motRadical, c'est-à-dire
+    *        son rang s'il est dans le dictionnaire, ou le rang qu'il aurait s'il y était ajouté.
+    *
+    * \post Le dictionnaire reste inchangé.
+    */
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::rang(const std::string& motRadicalBrut) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::Rang, motRadicalBrut);
+        const std::string& motRadical = Traits::normaliser(motRadicalBrut);
+        int inferieurs = 0;
+        NoeudDicoSynonymes* noeud = racine;
+        while (noeud != 0)
+        {
+            if (!Traits::inferieur(noeud->radical, motRadical)) noeud = noeud->gauche;
+            else
+            {
+                inferieurs += tailleSousArbre(noeud->gauche) + 1;
+                noeud = noeud->droit;
+            }
+        }
+        return inferieurs;
+    }
+
+    /**
+    * \brief Retourne les radicaux de rangs debut à debut + taille - 1, en ordre alphabétique.
+    *        La page est plus courte (ou vide) si elle dépasse la fin du dictionnaire.
+    *
+    * \post Le dictionnaire reste inchangé.
+    *
+    * \exception logic_error si debut ou taille est négatif.
+    */
+    template <class Traits>
+    std::vector<std::string> DicoSynonymesGenerique<Traits>::page(int debut, int taille) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::Page, debut, taille);
+        if (debut < 0 || taille < 0) throw std::logic_error("page : Le début ou la taille est négatif");
+
+        // descente jusqu'au radical de rang debut ; la pile garde les ancêtres qui le suivent
+        std::vector<NoeudDicoSynonymes*> pile;
+        NoeudDicoSynonymes* noeud = racine;
+        int k = debut;
+        while (noeud != 0)
+        {
+            int tailleGauche = tailleSousArbre(noeud->gauche);
+            if (k < tailleGauche)
+            {
+                pile.push_back(noeud);
+                noeud = noeud->gauche;
+            }
+            else if (k == tailleGauche)
+            {
+                pile.push_back(noeud);
+                break;
+            }
+            else
+            {
+                k -= tailleGauche + 1;
+                noeud = noeud->droit;
+            }
+        }
+
+        // parcours en ordre à partir de là, taille radicaux au plus
+        std::vector<std::string> resultat;
+        while (!pile.empty() && static_cast<int>(resultat.size()) < taille)
+        {
+            noeud = pile.back();
+            pile.pop_back();
+            resultat.push_back(noeud->radical);
+            for (noeud = noeud->droit; noeud != 0; noeud = noeud->gauche)
+                pile.push_back(noeud);
+        }
+        return resultat;
+    }
+
     /**
      * \brief Retourne le radical du mot entré en paramètre
      *
@@ -341,38 +1147,16 @@ namespace TP3
      * \exception logic_error si la flexion n'est pas dans la liste de flexions du radical
      *
      */
-    std::string DicoSynonymes::rechercherRadical(const std::string& mot) const
+    template <class Traits>
+    std::string DicoSynonymesGenerique<Traits>::rechercherRadical(const std::string& mot) const
     {
+        TraceDico::Garde enregistrement(trace, TraceDico::RechercheRadical, mot);
         if (estVide()) throw std::logic_error("rechercherRadical : L'arbre est vide");
 
-        std::vector<NoeudDicoSynonymes*> arbre = parcoursPreOrdre();
-        std::vector<float> degresDeSimilitude;
-
-        for (auto noeud : arbre) {
-            // j'ajoute le degré de similitude fait par ma fonction similitude pour chaque mot de l'arbre et le mot entré en paramètre
-            degresDeSimilitude.push_back(similitude(noeud->radical, mot));
-        }
-
-        int posSimilitudeMax = 0;
-        // Je trouve le degré de similitude le plus élevé de mon vecteur
-        auto similitudeMax = *std::max_element(std::begin(degresDeSimilitude), std::end(degresDeSimilitude));
+        std::optional<std::string> resultat = trouverRadical(mot);
+        if (resultat) return *resultat;
 
-        for (int i = 0; i < degresDeSimilitude.size(); ++i) {
-            // Je détermine la position du degré maximum dans le vecteur
-            if (degresDeSimilitude[i] == similitudeMax)
-                posSimilitudeMax = i;
-        }
-
-        bool flexionEstPresente = false;
-
-        // J'assigne le noeud ayant le degré de similitude le plus élevé
-        auto noeud = arbre[posSimilitudeMax];
-
-        for (auto flexion : noeud->flexions) {
-            // je cherche si le mot est dans la liste de flexion du noeud
-            if (flexion == mot) return noeud->radical;
-        }
-        // si le mot n'est pas dans la liste de flexions, je lance une erreur
+        // si le mot n'est dans aucune liste de flexions, je lance une erreur
         throw std::logic_error("rechercherRadical : Le mot n'est dans aucune liste de flexions");
     }
 
@@ -385,8 +1169,10 @@ namespace TP3
       * \post Le dictionnaire reste inchangé.
       *
       */
-    float DicoSynonymes::similitude(const std::string& mot1, const std::string& mot2) const
+    template <class Traits>
+    float DicoSynonymesGenerique<Traits>::similitude(const std::string& mot1, const std::string& mot2) const
     {
+        TraceDico::Garde enregistrement(trace, TraceDico::Similitude, mot1, mot2);
         // retourne 1 - la distance de Levenstein entre les 2 mots divisé par la longueur du mot le plus long
         return 1 - (distanceLevenstein(mot1, mot2) / std::max(mot1.size(), mot2.size()));
     }
@@ -398,9 +1184,14 @@ namespace TP3
       * \post Le nombre de cellules de appSynonymes pour le radical entré en paramètre est retourné
       * \post Le dictionnaire reste inchangé.
       *
+      * \exception logic_error si radical n'existe pas.
       */
-    int DicoSynonymes::getNombreSens(std::string radical) const{
-        return auxGetNombreSens(radical, racine);
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::getNombreSens(std::string radical) const{
+        TraceDico::Garde enregistrement(trace, TraceDico::NombreSens, radical);
+        std::optional<int> nbSens = trouverNombreSens(radical);
+        if (!nbSens) throw std::logic_error("getNombreSens : Le radical n'est pas dans le dictionnaire");
+        return *nbSens;
     }
 
     /**
@@ -410,84 +1201,582 @@ namespace TP3
       * \post un string correspondant au premier synonyme est imprimé
       * \post Le dictionnaire reste inchangé.
       *
+      * \exception logic_error si radical n'existe pas ou si position n'est pas un sens du radical.
       */
-    std::string DicoSynonymes::getSens(std::string radical, int position) const{
-        int groupe = 0;
+    template <class Traits>
+    std::string DicoSynonymesGenerique<Traits>::getSens(std::string radical, int position) const{
+        TraceDico::Garde enregistrement(trace, TraceDico::Sens, radical, position);
+        std::optional<std::string> sens = trouverSens(radical, position);
+        if (!sens) throw std::logic_error("getSens : Le radical n'a pas de sens à cette position");
+        return *sens;
+    }
 
-        // détermine de quel groupe de synonyme il s'agit
-        for(auto liste : groupesSynonymes)
-        {
-            for(auto adresse : liste)
-            {
-                if(adresse->radical == radical)
+    /**
+    * \brief Donne tous les synonymes du mot entré en paramètre du groupeSynonyme du parametre position
+    *
+    *
+    * \post un vecteur est retourné avec tous les synonymes
+    * \post Le dictionnaire reste inchangé.
+    *
+    * \exception logic_error si radical n'existe pas ou si position n'est pas un sens du radical.
+    */
+    template <class Traits>
+    std::vector<std::string> DicoSynonymesGenerique<Traits>::getSynonymes(std::string radical, int position) const{
+        TraceDico::Garde enregistrement(trace, TraceDico::Synonymes, radical, position);
+        std::optional< std::vector<std::string> > synonymes = trouverSynonymes(radical, position);
+        if (!synonymes) throw std::logic_error("getSynonymes : Le radical n'a pas de sens à cette position");
+        return *synonymes;
+    }
+
+    /**
+      * \brief Donne toutes les flexions du mot entré en paramètre
+      *
+      *
+      * \post un vecteur est retourné avec toutes les flexions
+      * \post Le dictionnaire reste inchangé.
+      *
+      * \exception logic_error si radical n'existe pas.
+      */
+    template <class Traits>
+    std::vector<std::string> DicoSynonymesGenerique<Traits>::getFlexions(std::string radical) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::Flexions, radical);
+        std::optional< std::vector<std::string> > flexions = trouverFlexions(radical);
+        if (!flexions) throw std::logic_error("getFlexions : Le radical n'est pas dans le dictionnaire");
+        return *flexions;
+    }
+
+    /**
+      * \brief Version sans exception de rechercherRadical
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le radical dont mot est une flexion, ou rien si le dictionnaire est vide
+      *         ou si mot n'est dans aucune liste de flexions.
+      */
+    template <class Traits>
+    std::optional<std::string> DicoSynonymesGenerique<Traits>::trouverRadical(const std::string& motBrut) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::TrouverRadical, motBrut);
+        const std::string& mot = Traits::normaliser(motBrut);
+        if (estVide()) return std::nullopt;
+
+        // un mot écarté par le filtre n'est ni un radical ni une flexion : rien à chercher ni à conserver
+        std::optional<std::string> resultat;
+        if (filtreMots.peutContenir(mot) && !cacheRadicaux.chercher(mot, resultat))
+        {
+            resultat = auxRechercherRadical(mot);
+            cacheRadicaux.inserer(mot, resultat);
+        }
+        // les radicaux devinés ne vont pas dans le cache : ils changent avec les flexions des autres radicaux
+        if (!resultat && raciniseurActif) resultat = devinerRadical(mot);
+        return resultat;
+    }
+
+    /**
+      * \brief Version sans exception de getNombreSens
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le nombre de sens du radical, ou rien si radical n'existe pas.
+      */
+    template <class Traits>
+    std::optional<int> DicoSynonymesGenerique<Traits>::trouverNombreSens(const std::string& radicalBrut) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::TrouverNombreSens, radicalBrut);
+        const std::string& radical = Traits::normaliser(radicalBrut);
+        const NoeudDicoSynonymes* noeud = trouverNoeud(radical);
+        if (noeud == 0) return std::nullopt;
+        return static_cast<int>(noeud->appSynonymes.size());
+    }
+
+    /**
+      * \brief Version sans exception de getSens
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le premier synonyme du sens position, ou rien si radical n'existe pas,
+      *         si position n'est pas un de ses sens ou si le groupe ne contient aucun autre mot.
+      */
+    template <class Traits>
+    std::optional<std::string> DicoSynonymesGenerique<Traits>::trouverSens(const std::string& radicalBrut, int position) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::TrouverSens, radicalBrut, position);
+        const std::string& radical = Traits::normaliser(radicalBrut);
+        const NoeudDicoSynonymes* noeud = trouverNoeud(radical);
+        if (noeud == 0 || position < 0 || position >= static_cast<int>(noeud->appSynonymes.size()))
+            return std::nullopt;
+
+        // le sens est représenté par le premier mot du groupe qui n'est pas le radical lui-même
+        for (auto adresse : groupesSynonymes[noeud->appSynonymes[position]])
+        {
+            if (adresse->radical != radical) return adresse->radical;
+        }
+        return std::nullopt;
+    }
+
+    /**
+      * \brief Version sans exception de getSynonymes
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return les synonymes du sens position, ou rien si radical n'existe pas
+      *         ou si position n'est pas un de ses sens.
+      */
+    template <class Traits>
+    std::optional< std::vector<std::string> > DicoSynonymesGenerique<Traits>::trouverSynonymes(const std::string& radicalBrut, int position) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::TrouverSynonymes, radicalBrut, position);
+        const std::string& radical = Traits::normaliser(radicalBrut);
+        const NoeudDicoSynonymes* noeud = trouverNoeud(radical);
+        if (noeud == 0 || position < 0 || position >= static_cast<int>(noeud->appSynonymes.size()))
+            return std::nullopt;
+
+        std::vector<std::string> synonymes;
+        for (auto adresse : groupesSynonymes[noeud->appSynonymes[position]])
+        {
+            // pour chaque élément du groupe de synonyme, si ce n'est pas le même mot, je met le mot dans le vecteur
+            if (adresse->radical != radical) synonymes.push_back(adresse->radical);
+        }
+        return synonymes;
+    }
+
+    /**
+      * \brief Version sans exception de getFlexions
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return les flexions du radical, ou rien si radical n'existe pas.
+      */
+    template <class Traits>
+    std::optional< std::vector<std::string> > DicoSynonymesGenerique<Traits>::trouverFlexions(const std::string& radicalBrut) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::TrouverFlexions, radicalBrut);
+        const std::string& radical = Traits::normaliser(radicalBrut);
+        const NoeudDicoSynonymes* noeud = trouverNoeud(radical);
+        if (noeud == 0) return std::nullopt;
+        return flexionsDe(noeud);
+    }
+
+    /**
+      * \brief Donne tous les radicaux atteignables depuis radical en au plus k sauts de synonymie.
+      *
+      * \post un vecteur trié est retourné, sans le radical lui-même
+      * \post Le dictionnaire reste inchangé.
+      *
+      * \exception logic_error si radical n'existe pas.
+      */
+    template <class Traits>
+    std::vector<std::string> DicoSynonymesGenerique<Traits>::synonymesTransitifs(const std::string& radicalBrut, int k) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::SynonymesTransitifs, radicalBrut, k);
+        const std::string& radical = Traits::normaliser(radicalBrut);
+        const GrapheSynonymes& g = graphe();
+        long depart = g.identifiant(radical);
+        if (depart < 0)
+            throw std::logic_error("synonymesTransitifs : Le radical n'est pas dans le dictionnaire");
+
+        std::vector<std::string> synonymes;
+        for (auto identifiant : g.voisinage(depart, k))
+            synonymes.push_back(g.radical(identifiant));
+        return synonymes;
+    }
+
+    /**
+      * \brief Version en lot de synonymesTransitifs, répartie sur nbFils fils d'exécution
+      *        (0 : autant que de coeurs).
+      *
+      * \post Le résultat i correspond à radicaux[i] ; il est vide si radicaux[i] n'existe pas.
+      * \post Le dictionnaire reste inchangé.
+      */
+    template <class Traits>
+    std::vector< std::vector<std::string> > DicoSynonymesGenerique<Traits>::synonymesTransitifs(const std::vector<std::string>& radicauxBrut,
+                                                                               int k, unsigned int nbFils) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::SynonymesTransitifsLot, radicauxBrut, k, nbFils);
+        std::vector<std::string> copieRadicaux;
+        const std::vector<std::string>& radicaux = normaliserTous(radicauxBrut, copieRadicaux);
+        const GrapheSynonymes& g = graphe();
+        std::vector< std::vector<std::string> > resultats(radicaux.size());
+
+        if (nbFils == 0) nbFils = std::max(1u, std::thread::hardware_concurrency());
+        nbFils = std::min<std::size_t>(nbFils, std::max<std::size_t>(1, radicaux.size()));
+
+        // chaque fil traite une tranche contiguë des requêtes ; le graphe n'est que lu
+        auto traiter = [&](std::size_t debut, std::size_t fin) {
+            for (std::size_t i = debut; i < fin; ++i)
+            {
+                long depart = g.identifiant(radicaux[i]);
+                if (depart < 0) continue;
+                for (auto identifiant : g.voisinage(depart, k))
+                    resultats[i].push_back(g.radical(identifiant));
+            }
+        };
+
+        std::vector<std::thread> fils;
+        std::size_t taille = (radicaux.size() + nbFils - 1) / nbFils;
+        for (unsigned int f = 1; f < nbFils; ++f)
+            fils.emplace_back(traiter, std::min(radicaux.size(), f * taille), std::min(radicaux.size(), (f + 1) * taille));
+        traiter(0, std::min(radicaux.size(), taille));
+        for (auto &f : fils) f.join();
+
+        return resultats;
+    }
+
+    /**
+      * \brief Active ou désactive la représentation compressée des flexions.
+      *
+      * \post Toutes les flexions existantes sont converties dans la représentation demandée.
+      * \post Le contenu logique du dictionnaire reste inchangé.
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::compresserFlexions(bool activer)
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::CompressionFlexions, activer);
+        if (activer == compressionFlexions) return;
+
+        std::vector<NoeudDicoSynonymes*> arbre = parcoursPreOrdre();
+        for (auto noeud : arbre)
+        {
+            // les codes remplacent les flexions dans le même conteneur, et inversement
+            typename Traits::ConteneurFlexions converties;
+            for (auto entree : noeud->flexions)
+            {
+                if (activer) converties.ajouter(suffixes.compresser(noeud->radical, entree).vue());
+                else converties.ajouter(suffixes.decompresser(noeud->radical, entree));
+            }
+            converties.compacter();
+            noeud->flexions = std::move(converties);
+        }
+        if (!activer) suffixes.vider();
+        compressionFlexions = activer;
+    }
+
+    /**
+      * \brief Indique si les flexions sont conservées sous forme compressée
+      *
+      * \post Le dictionnaire reste inchangé.
+      */
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::flexionsSontCompressees() const
+    {
+        return compressionFlexions;
+    }
+
+    /**
+      * \brief Active le cache des résultats de rechercherRadical, ou le désactive si capacite vaut 0.
+      *
+      * \pre Aucune recherche n'est en cours dans un autre fil d'exécution.
+      *
+      * \post Le cache est vide et peut contenir au plus capacite mots.
+      */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::activerCache(std::size_t capacite)
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::ActivationCache, capacite);
+        cacheRadicaux.redimensionner(capacite);
+    }
+
+    /**
+    * \brief Devine le radical d'un mot qui n'est dans aucune liste de flexions, d'après les
+    *        terminaisons des flexions connues (voir RaciniseurSuffixes).
+    *
+    * \post Le dictionnaire reste inchangé.
+    * \return le premier candidat qui est un radical du dictionnaire, ou rien.
+    */
+    template <class Traits>
+    std::optional<std::string> DicoSynonymesGenerique<Traits>::devinerRadical(const std::string& motBrut) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::DevinerRadical, motBrut);
+        const std::string& mot = Traits::normaliser(motBrut);
+        for (auto &candidat : raciniseur().candidats(mot))
+            if (trouverNoeud(candidat) != 0) return candidat;
+        return std::nullopt;
+    }
+
+    /**
+    * \brief Si activer est vrai, trouverRadical et rechercherRadical se rabattent sur
+    *        devinerRadical quand mot n'est dans aucune liste de flexions.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::activerRaciniseur(bool activer)
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::ActivationRaciniseur, activer);
+        raciniseurActif = activer;
+    }
+
+    /**
+    * \brief Recherche approximative : compare mot à tous les radicaux et à toutes les flexions
+    *        et retourne le radical du mot le plus proche (distance de Levenshtein).
+    *
+    * Si l'index de trigrammes peut filtrer mot pour distanceMax, seuls les radicaux qu'il retient
+    * sont comparés ; sinon, tous les mots sont balayés.
+    *
+    * \post Le dictionnaire reste inchangé.
+    * \return le radical trouvé, ou rien si aucun mot n'est à une distance d'au plus distanceMax.
+    *         À distance égale, le radical qui vient en premier en ordre alphabétique est retourné.
+    */
+    template <class Traits>
+    std::optional<std::string> DicoSynonymesGenerique<Traits>::radicalLePlusProche(const std::string& motBrut, unsigned int distanceMax) const
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::RadicalLePlusProche, motBrut, distanceMax);
+        const std::string& mot = Traits::normaliser(motBrut);
+
+        // Quand le mot a assez de trigrammes, l'index élimine les radicaux qui n'en partagent pas
+        // assez avec lui ; seuls les survivants sont comparés. Sinon, on balaie tous les mots.
+        if (indexTrigrammes.peutFiltrer(mot, distanceMax))
+        {
+            const NoeudDicoSynonymes* meilleurNoeud = 0;
+            unsigned int meilleureDistance = distanceMax + 1;
+            for (auto &candidat : indexTrigrammes.candidats(mot, distanceMax))
+            {
+                const NoeudDicoSynonymes* noeud = trouverNoeud(candidat);
+                if (noeud == 0) continue;
+
+                unsigned int distance = distanceMax + 1;
+                auto comparer = [&](const std::string& motNoeud) {
+                    std::size_t ecart = motNoeud.size() > mot.size() ? motNoeud.size() - mot.size() : mot.size() - motNoeud.size();
+                    if (ecart < distance)
+                        distance = std::min(distance, static_cast<unsigned int>(distanceLevenstein(mot, motNoeud)));
+                };
+                comparer(noeud->radical);
+                for (auto &flexion : flexionsDe(noeud)) comparer(flexion);
+
+                if (distance < meilleureDistance
+                    || (distance == meilleureDistance && meilleurNoeud != 0 && Traits::inferieur(noeud->radical, meilleurNoeud->radical)))
                 {
-                    groupe = adresse->appSynonymes[position];
+                    meilleureDistance = distance;
+                    meilleurNoeud = noeud;
                 }
             }
+            if (meilleurNoeud == 0) return std::nullopt;
+            return meilleurNoeud->radical;
         }
 
-        std::vector<NoeudDicoSynonymes*> sens;
+        std::vector<RadicauxParLongueur::Resultat> proches = balayage().chercher(mot, distanceMax);
 
-        // converti la liste en vecteur. J'ai fait cela car j'avais toujours des segfaults en essayant
-        // de le faire avec un iterateur dans la liste
-        for (auto &s : groupesSynonymes[groupe])
+        const RadicauxParLongueur::Resultat* meilleur = 0;
+        for (auto &proche : proches)
         {
-            sens.push_back(s);
+            if (meilleur == 0 || proche.distance < meilleur->distance
+                || (proche.distance == meilleur->distance && proche.proprietaire < meilleur->proprietaire))
+                meilleur = &proche;
         }
+        if (meilleur == 0) return std::nullopt;
+        return radicauxBalayes[meilleur->proprietaire];
+    }
 
-        // si le premier élément du vecteur est équivalent au mot, on retourne le prochain élément
-        if (sens[0]->radical == radical)
+    /**
+    * \brief Mesure la mémoire occupée par chaque composante du dictionnaire
+    *
+    * \pre Aucune modification n'est en cours dans un autre fil d'exécution.
+    *
+    * \post Le dictionnaire reste inchangé.
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::StatistiquesMemoire DicoSynonymesGenerique<Traits>::statistiquesMemoire() const
+    {
+        StatistiquesMemoire statistiques = StatistiquesMemoire();
+        statistiques.noeuds = nbRadicaux * sizeof(NoeudDicoSynonymes);
+        for (auto noeud : parcoursPreOrdre())
         {
-            return sens[1]->radical;
+            statistiques.radicaux += octetsChaine(noeud->radical);
+            statistiques.flexions += noeud->flexions.memoire();
+            statistiques.appartenances += octetsVecteur(noeud->appSynonymes);
         }
 
-        return groupesSynonymes[groupe].front()->radical;
+        statistiques.groupes = octetsVecteur(groupesSynonymes);
+        for (auto &groupe : groupesSynonymes) statistiques.groupes += octetsListe(groupe);
+
+        statistiques.tableSuffixes = suffixes.memoire();
+        statistiques.indexTrigrammes = indexTrigrammes.memoire();
+        statistiques.cache = cacheRadicaux.memoire();
+        statistiques.filtre = filtreMots.memoire();
+        {
+            std::lock_guard<std::mutex> garde(verrouGraphe);
+            statistiques.graphe = grapheSynonymes.memoire();
+        }
+        {
+            std::lock_guard<std::mutex> garde(verrouRaciniseur);
+            statistiques.raciniseur = raciniseurSuffixes.memoire();
+        }
+        {
+            std::lock_guard<std::mutex> garde(verrouMotsParLongueur);
+            statistiques.balayage = motsParLongueur.memoire() + octetsVecteur(radicauxBalayes);
+            for (auto &radical : radicauxBalayes) statistiques.balayage += octetsChaine(radical);
+        }
+        return statistiques;
     }
 
     /**
-    * \brief Donne tous les synonymes du mot entré en paramètre du groupeSynonyme du parametre position
+    * \brief Réduit la mémoire occupée par le dictionnaire.
     *
+    * \post Le contenu logique du dictionnaire reste inchangé, sauf que les groupes de synonymes
+    *       vides sont retirés : les groupes suivants sont renumérotés.
     *
-    * \post un vecteur est retourné avec tous les synonymes
-    * \post Le dictionnaire reste inchangé.
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::compacter()
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::Compactage);
+        // groupes vides retirés ; nouveauNumero[g] vaut -1 pour un groupe retiré
+        std::vector<int> nouveauNumero(groupesSynonymes.size(), -1);
+        std::vector< std::list<NoeudDicoSynonymes*> > groupes;
+        for (std::size_t g = 0; g < groupesSynonymes.size(); ++g)
+        {
+            if (groupesSynonymes[g].empty()) continue;
+            nouveauNumero[g] = groupes.size();
+            groupes.push_back(std::move(groupesSynonymes[g]));
+        }
+        groupesSynonymes.swap(groupes);
+        groupesSynonymes.shrink_to_fit();
+
+        std::vector<NoeudDicoSynonymes*> noeuds = parcoursPreOrdre();
+
+        // en mode compressé, la table est refaite avec les seules terminaisons encore utilisées
+        std::vector< std::vector<std::string> > flexionsDecompressees;
+        if (compressionFlexions)
+        {
+            for (auto noeud : noeuds) flexionsDecompressees.push_back(flexionsDe(noeud));
+            suffixes = TableSuffixes();
+        }
+
+        for (std::size_t i = 0; i < noeuds.size(); ++i)
+        {
+            NoeudDicoSynonymes* noeud = noeuds[i];
+            noeud->radical.shrink_to_fit();
+
+            std::vector<int> appartenances;
+            for (auto numGroupe : noeud->appSynonymes)
+                if (nouveauNumero[numGroupe] != -1) appartenances.push_back(nouveauNumero[numGroupe]);
+            appartenances.shrink_to_fit();
+            noeud->appSynonymes.swap(appartenances);
+
+            if (compressionFlexions)
+            {
+                noeud->flexions.vider();
+                for (auto &flexion : flexionsDecompressees[i])
+                    noeud->flexions.ajouter(suffixes.compresser(noeud->radical, flexion).vue());
+            }
+            noeud->flexions.compacter();
+        }
+
+        indexTrigrammes = IndexTrigrammes();
+        reconstruireIndexTrigrammes();
+        reconstruireFiltre();
+
+        grapheSynonymes = GrapheSynonymes();
+        grapheSynonymesAJour = false;
+        raciniseurSuffixes = RaciniseurSuffixes();
+        raciniseurAJour = false;
+        motsParLongueur = RadicauxParLongueur();
+        std::vector<std::string>().swap(radicauxBalayes);
+        motsParLongueurAJour = false;
+    }
+
+    /**
+    * \brief Fusionne les groupes de synonymes qui se recouvrent.
+    *
+    * \post Les groupes fusionnés dans un autre et les groupes vides sont retirés : les groupes
+    *       restants sont renumérotés. appSynonymes suit la nouvelle numérotation, sans doublon.
+    * \return le nombre de groupes retirés.
     *
+    * \exception logic_error si seuil n'est pas dans ]0, 1].
     */
-    std::vector<std::string> DicoSynonymes::getSynonymes(std::string radical, int position) const{
-        int groupe = 0;
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::consoliderGroupes(float seuil)
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::ConsolidationGroupes, seuil);
+        if (!(seuil > 0 && seuil <= 1))
+            throw std::logic_error("consoliderGroupes : Le seuil doit être dans ]0, 1]");
 
-        // détermine de quel groupe de synonyme il s'agit
-        for(auto liste : groupesSynonymes)
+        int nbRetires = 0;
+        bool premierePasse = true;
+        for (;;)
         {
-            for(auto adresse : liste)
+            // chaque paire est examinée une fois, depuis son groupe de plus petit numéro
+            EnsemblesDisjoints ensembles(groupesSynonymes.size());
+            for (std::size_t g = 0; g < groupesSynonymes.size(); ++g)
+                for (auto autre : groupesRecouvrants(g, seuil))
+                    if (autre > static_cast<int>(g)) ensembles.unir(g, autre);
+
+            // une fusion peut faire se recouvrir des groupes qui ne se recouvraient pas : on refait
+            // des passes tant qu'il y a des fusions (la première retire aussi les groupes vides)
+            bool fusions = ensembles.nombreEnsembles() < groupesSynonymes.size();
+            if (!fusions && !premierePasse) break;
+
+            // le groupe fusionné prend la place du premier de ses groupes qui n'est pas vide
+            std::vector<int> nouveauNumero(groupesSynonymes.size(), -1);
+            std::vector< std::vector<int> > fusionnes;
+            for (std::size_t g = 0; g < groupesSynonymes.size(); ++g)
             {
-                if(adresse->radical == radical)
+                if (groupesSynonymes[g].empty()) continue;
+                std::size_t representant = ensembles.trouver(g);
+                if (nouveauNumero[representant] == -1)
                 {
-                    groupe = adresse->appSynonymes[position];
+                    nouveauNumero[representant] = fusionnes.size();
+                    fusionnes.emplace_back();
                 }
+                fusionnes[nouveauNumero[representant]].push_back(g);
             }
-        }
-        std::vector<std::string> synonymes;
+            for (std::size_t g = 0; g < groupesSynonymes.size(); ++g)
+                if (!groupesSynonymes[g].empty()) nouveauNumero[g] = nouveauNumero[ensembles.trouver(g)];
 
-        for(auto adresse : groupesSynonymes[groupe])
-        {
-            // pour chaque élément du groupe de synonyme, si ce n'est pas le même mot, je met le mot dans le vecteur
-            if(adresse->radical != radical) synonymes.push_back(adresse->radical);
+            std::vector< std::list<NoeudDicoSynonymes*> > groupes(fusionnes.size());
+            std::unordered_set<const NoeudDicoSynonymes*> membres;
+            for (std::size_t n = 0; n < fusionnes.size(); ++n)
+            {
+                if (fusionnes[n].size() == 1)
+                {
+                    groupes[n].swap(groupesSynonymes[fusionnes[n][0]]);
+                    continue;
+                }
+                membres.clear();
+                for (auto g : fusionnes[n])
+                    for (auto adresse : groupesSynonymes[g])
+                        if (membres.insert(adresse).second) groupes[n].push_back(adresse);
+            }
+
+            for (auto noeud : parcoursPreOrdre())
+            {
+                std::vector<int> appartenances;
+                for (auto numGroupe : noeud->appSynonymes)
+                {
+                    int numero = nouveauNumero[numGroupe];
+                    if (numero != -1 && std::find(appartenances.begin(), appartenances.end(), numero) == appartenances.end())
+                        appartenances.push_back(numero);
+                }
+                noeud->appSynonymes.swap(appartenances);
+            }
+
+            nbRetires += groupesSynonymes.size() - groupes.size();
+            groupesSynonymes.swap(groupes);
+            premierePasse = false;
+            if (!fusions) break;
         }
+        grapheSynonymesAJour = false;
+        return nbRetires;
+    }
 
-        return synonymes;
+    /**
+    * \brief Consolidation en ligne des groupes créés ou agrandis, 0 pour la désactiver
+    *
+    * \exception logic_error si seuil n'est pas dans [0, 1].
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::consoliderEnLigne(float seuil)
+    {
+        TraceDico::Garde enregistrement(trace, TraceDico::ConsolidationEnLigne, seuil);
+        if (!(seuil >= 0 && seuil <= 1))
+            throw std::logic_error("consoliderEnLigne : Le seuil doit être dans [0, 1]");
+        seuilConsolidation = seuil;
     }
 
     /**
-      * \brief Donne toutes les flexions du mot entré en paramètre
-      *
-      *
-      * \post un vecteur est retourné avec toutes les flexions
-      * \post Le dictionnaire reste inchangé.
-      *
-      */
-    std::vector<std::string> DicoSynonymes::getFlexions(std::string radical) const
+    * \brief Enregistre dorénavant les appels publics dans trace, ou arrête si trace est nul
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::enregistrerTrace(TraceDico* trace)
     {
-        return auxGetFlexions(radical, racine);
+        this->trace = trace;
     }
 
     //Mettez l'implantation des autres méthodes (surtout privées) ici.
@@ -498,15 +1787,20 @@ namespace TP3
     * \param[in] motRadical le mot à ajouter à l'arbre AVL
     * \param[in] root la racine de l'arbre ou du sous-arbre où ajouter le mot
     */
-    void DicoSynonymes::auxajouterRadical(const std::string &motRadical, DicoSynonymes::NoeudDicoSynonymes *&root) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxajouterRadical(const std::string &motRadical, NoeudDicoSynonymes *&root) {
         if (!root)
         {
-            root = new NoeudDicoSynonymes(motRadical);
+            root = creerNoeud(motRadical);
             nbRadicaux++;
+            grapheSynonymesAJour = false;
+            motsParLongueurAJour = false;
+            indexTrigrammes.ajouterMot(motRadical, motRadical);
+            filtreMots.ajouter(motRadical);
             return;
         }
-        if (motRadical > root->radical) auxajouterRadical(motRadical, root->droit);
-        else if (motRadical < root->radical) auxajouterRadical( motRadical, root->gauche);
+        if (Traits::inferieur(root->radical, motRadical)) auxajouterRadical(motRadical, root->droit);
+        else if (Traits::inferieur(motRadical, root->radical)) auxajouterRadical( motRadical, root->gauche);
 
         equilibrer(root);
     }
@@ -518,17 +1812,19 @@ namespace TP3
       * \param[in] motFlexion la flexion à ajouter
       * \param[in] root la racine de l'arbre ou du sous-arbre où ajouter la flexion
       */
-    void DicoSynonymes::auxAjouterFlexion(const std::string &motRadical, const std::string &motFlexion,
-                                          DicoSynonymes::NoeudDicoSynonymes *&root) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxAjouterFlexion(const std::string &motRadical, const std::string &motFlexion,
+                                          NoeudDicoSynonymes *&root) {
         if (root->radical == motRadical)
         {
-            for (auto flexion : root->flexions) {
-                if(motFlexion == flexion) throw std::logic_error("ajouterFlexion : La flexion est déjà présente dans le radical");
-            }
-            root->flexions.push_back(motFlexion);
+            if (!insererFlexion(root, motFlexion))
+                throw std::logic_error("ajouterFlexion : La flexion est déjà présente dans le radical");
+            indexTrigrammes.ajouterMot(root->radical, motFlexion);
+            filtreMots.ajouter(motFlexion);
+            cacheRadicaux.invalider(motFlexion);
         }
-        else if (motRadical > root->radical) auxAjouterFlexion(motRadical, motFlexion, root->droit);
-        else if (motRadical < root->radical) auxAjouterFlexion( motRadical, motFlexion, root->gauche);
+        else if (Traits::inferieur(root->radical, motRadical)) auxAjouterFlexion(motRadical, motFlexion, root->droit);
+        else if (Traits::inferieur(motRadical, root->radical)) auxAjouterFlexion( motRadical, motFlexion, root->gauche);
     }
 
     /**
@@ -537,9 +1833,10 @@ namespace TP3
   * \param[in] motRadical le mot à supprimer
   * \param[in] root la racine de l'arbre ou du sous-arbre où supprimer le radical
   */
-    void DicoSynonymes::auxSupprimerRadical(const std::string &motRadical, DicoSynonymes::NoeudDicoSynonymes *&root) {
-        if (motRadical < root->radical) auxSupprimerRadical(motRadical, root->gauche);
-        else if (root->radical < motRadical) auxSupprimerRadical(motRadical, root->droit);
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxSupprimerRadical(const std::string &motRadical, NoeudDicoSynonymes *&root) {
+        if (Traits::inferieur(motRadical, root->radical)) auxSupprimerRadical(motRadical, root->gauche);
+        else if (Traits::inferieur(root->radical, motRadical)) auxSupprimerRadical(motRadical, root->droit);
         // si le radical a deux enfants nous devons enlever le successeur minimal à droite
         else if (root->gauche != 0 && root->droit != 0)
         {
@@ -551,7 +1848,7 @@ namespace TP3
             auto vieuxNoeud  = root;
             // si le noeud a un enfant à gauche on l'assigne sinon on prend le droit
             root = (root->gauche != 0) ? root->gauche : root->droit;
-            delete vieuxNoeud;
+            detruireNoeud(vieuxNoeud);
             --nbRadicaux;
         }
         equilibrer(root);
@@ -564,21 +1861,21 @@ namespace TP3
     * \param[in] motFlexion la flexion à supprimer
     * \param[in] root la racine de l'arbre ou du sous-arbre où supprimer la flexion
 */
-    void DicoSynonymes::auxSupprimerFlexion(const std::string &motRadical, const std::string &motFlexion,
-                                            DicoSynonymes::NoeudDicoSynonymes *&root) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxSupprimerFlexion(const std::string &motRadical, const std::string &motFlexion,
+                                            NoeudDicoSynonymes *&root) {
         if (root->radical == motRadical)
         {
-            for (auto flexion : root->flexions) {
-                if(motFlexion == flexion)
-                {
-                    root->flexions.remove(motFlexion);
-                    return;
-                }
+            if (retirerFlexion(root, motFlexion))
+            {
+                filtreMots.signalerRetrait();
+                cacheRadicaux.invalider(motFlexion);
+                return;
             }
             throw std::logic_error("ajouterFlexion : La flexion n'est pas présente dans le radical");
         }
-        else if (motRadical > root->radical) auxSupprimerFlexion(motRadical, motFlexion, root->droit);
-        else if (motRadical < root->radical) auxSupprimerFlexion( motRadical, motFlexion, root->gauche);
+        else if (Traits::inferieur(root->radical, motRadical)) auxSupprimerFlexion(motRadical, motFlexion, root->droit);
+        else if (Traits::inferieur(motRadical, root->radical)) auxSupprimerFlexion( motRadical, motFlexion, root->gauche);
 
     }
 
@@ -589,11 +1886,25 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return int la hauteur du noeud
     */
-    int DicoSynonymes::hauteur(DicoSynonymes::NoeudDicoSynonymes *root) const {
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::hauteur(NoeudDicoSynonymes *root) const {
         if (!root) return -1;
         return root->hauteur;
     }
 
+    /**
+    * \fn int tailleSousArbre(DicoSynonymes::NoeudDicoSynonymes *root) const
+    * \brief Fonction retournant le nombre de noeuds du sous-arbre
+    * \param[in] root la racine du sous-arbre
+    * \post L'arbre reste inchangé.
+    * \return int le nombre de noeuds, 0 pour un sous-arbre vide
+    */
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::tailleSousArbre(NoeudDicoSynonymes *root) const {
+        if (!root) return 0;
+        return root->taille;
+    }
+
     /**
    * \fn bool radicalDansDico(const std::string &motRadical) const
    * \brief Fonction déterminant si un radical se trouve dans le dictionnaire
@@ -601,7 +1912,9 @@ namespace TP3
    * \post L'arbre reste inchangé.
    * \return bool vrai si le mot est présent, false sinon
     */
-    bool DicoSynonymes::radicalDansDico(const std::string &motRadical) const {
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::radicalDansDico(const std::string &motRadical) const {
+        if (!filtreMots.peutContenir(motRadical)) return false;
         return auxradicalDansDico(motRadical, racine);
     }
 
@@ -613,10 +1926,11 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return bool vrai si le mot est présent, false sinon
     */
-    bool DicoSynonymes::auxradicalDansDico(const std::string &motRadical, NoeudDicoSynonymes *root) const {
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::auxradicalDansDico(const std::string &motRadical, NoeudDicoSynonymes *root) const {
         if (!root) return false;
         if (motRadical == root->radical) return true;
-        if (motRadical < root->radical) return auxradicalDansDico(motRadical, root->gauche);
+        if (Traits::inferieur(motRadical, root->radical)) return auxradicalDansDico(motRadical, root->gauche);
         return auxradicalDansDico(motRadical, root->droit);
     }
 
@@ -625,7 +1939,8 @@ namespace TP3
     * \brief Fonction servant à équilibrer l'arbre AVL
     * \param[in] root le noeud à équilibrer
     */
-    void DicoSynonymes::equilibrer(DicoSynonymes::NoeudDicoSynonymes *&root) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::equilibrer(NoeudDicoSynonymes *&root) {
          if (debalancementAGauche(root)) // déséquilibre à gauche
          {
              if (sousArbrePencheADroite(root->gauche)) // noeud sous-critique penche à droite
@@ -651,7 +1966,10 @@ namespace TP3
          {
             // mise à jour de la hauteur
              if (root != 0)
+             {
                  root->hauteur = 1 + std::max(hauteur(root->gauche), hauteur(root->droit));
+                 root->taille = 1 + tailleSousArbre(root->gauche) + tailleSousArbre(root->droit);
+             }
          }
     }
 
@@ -660,12 +1978,15 @@ namespace TP3
     * \brief Fonction servant à équilibrer l'arbre AVL en faisant une rotation zigzigGauche
     * \param[in] noeud le noeud à rotationner
     */
-    void DicoSynonymes::zigZigGauche(NoeudDicoSynonymes *&noeud) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::zigZigGauche(NoeudDicoSynonymes *&noeud) {
         auto nouvelleRacine = noeud->gauche;
         noeud->gauche = nouvelleRacine->droit;
         nouvelleRacine->droit = noeud;
         noeud->hauteur = 1 + std::max(hauteur(noeud->gauche), hauteur(noeud->droit));
         nouvelleRacine->hauteur = 1 + std::max(hauteur(nouvelleRacine->gauche), hauteur(nouvelleRacine->droit));
+        noeud->taille = 1 + tailleSousArbre(noeud->gauche) + tailleSousArbre(noeud->droit);
+        nouvelleRacine->taille = 1 + tailleSousArbre(nouvelleRacine->gauche) + tailleSousArbre(nouvelleRacine->droit);
         noeud = nouvelleRacine;
     }
 
@@ -674,12 +1995,15 @@ namespace TP3
     * \brief Fonction servant à équilibrer l'arbre AVL en faisant une rotation zigzigDroit
     * \param[in] noeud le noeud à rotationner
     */
-    void DicoSynonymes::zigZigDroit(NoeudDicoSynonymes *&noeud) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::zigZigDroit(NoeudDicoSynonymes *&noeud) {
         auto nouvelleRacine = noeud->droit;
         noeud->droit = nouvelleRacine->gauche;
         nouvelleRacine->gauche = noeud;
         noeud->hauteur = 1 + std::max(hauteur(noeud->droit), hauteur(noeud->gauche));
         nouvelleRacine->hauteur = 1 + std::max(hauteur(nouvelleRacine->droit), hauteur(nouvelleRacine->gauche));
+        noeud->taille = 1 + tailleSousArbre(noeud->gauche) + tailleSousArbre(noeud->droit);
+        nouvelleRacine->taille = 1 + tailleSousArbre(nouvelleRacine->gauche) + tailleSousArbre(nouvelleRacine->droit);
         noeud = nouvelleRacine;
     }
 
@@ -688,7 +2012,8 @@ namespace TP3
     * \brief Fonction servant à équilibrer l'arbre AVL en faisant une rotation zigZagGauche
     * \param[in] noeud le noeud à rotationner
     */
-    void DicoSynonymes::zigZagGauche(DicoSynonymes::NoeudDicoSynonymes *&noeud) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::zigZagGauche(NoeudDicoSynonymes *&noeud) {
         zigZigDroit(noeud->gauche);
         zigZigGauche(noeud);
     }
@@ -698,7 +2023,8 @@ namespace TP3
     * \brief Fonction servant à équilibrer l'arbre AVL en faisant une rotation zigZagDroit
     * \param[in] noeud le noeud à rotationner
     */
-    void DicoSynonymes::zigZagDroit(DicoSynonymes::NoeudDicoSynonymes *&noeud) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::zigZagDroit(NoeudDicoSynonymes *&noeud) {
         zigZigGauche(noeud->droit);
         zigZigDroit(noeud);
     }
@@ -710,7 +2036,8 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return bool vrai s'il y a un débalancement à gauche, faux sinon
     */
-    bool DicoSynonymes::debalancementAGauche(DicoSynonymes::NoeudDicoSynonymes *noeud) const {
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::debalancementAGauche(NoeudDicoSynonymes *noeud) const {
         if(!noeud) return false;
         return 1 < hauteur(noeud->gauche) - hauteur(noeud->droit);
     }
@@ -722,7 +2049,8 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return bool vrai s'il y a un débalancement à droite, faux sinon
     */
-    bool DicoSynonymes::debalancementADroite(DicoSynonymes::NoeudDicoSynonymes *noeud) const {
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::debalancementADroite(NoeudDicoSynonymes *noeud) const {
         if(!noeud) return false;
         return 1 < hauteur(noeud->droit) - hauteur(noeud->gauche);
     }
@@ -734,7 +2062,8 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return bool vrai si le sous-arbre penche à droite, faux sinon
     */
-    bool DicoSynonymes::sousArbrePencheADroite(DicoSynonymes::NoeudDicoSynonymes *noeud) const {
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::sousArbrePencheADroite(NoeudDicoSynonymes *noeud) const {
         if(!noeud) return false;
         return hauteur(noeud->gauche) < hauteur(noeud->droit);
     }
@@ -746,7 +2075,8 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return bool vrai si le sous-arbre penche à gauche, faux sinon
     */
-    bool DicoSynonymes::sousArbrePencheAGauche(DicoSynonymes::NoeudDicoSynonymes *noeud) const {
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::sousArbrePencheAGauche(NoeudDicoSynonymes *noeud) const {
         if(!noeud) return false;
         return hauteur(noeud->gauche) > hauteur(noeud->droit);
     }
@@ -756,68 +2086,28 @@ namespace TP3
     * \brief Fonction servant à enlever le successeur minimal à droite
     * \param[in] noeud le noeud à changer
     */
-    void DicoSynonymes::enleverSuccMinDroit(DicoSynonymes::NoeudDicoSynonymes *noeud) {
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::enleverSuccMinDroit(NoeudDicoSynonymes *noeud) {
         auto noeudTemporaire = noeud->droit;
-        auto parent = noeud;
 
         //Je vais chercher le successeur minimal donc le neoud le plus en bas à gauche
         while(noeudTemporaire->gauche != 0)
         {
-            parent = noeudTemporaire;
             noeudTemporaire = noeudTemporaire->gauche;
         }
 
-        // Je swap les deux noeuds
+        // Je swap les deux noeuds. Les flexions suivent le radical : en mode compressé,
+        // leurs codes n'ont de sens que par rapport à leur propre radical.
         noeud->radical = noeudTemporaire->radical;
+        noeud->flexions = noeudTemporaire->flexions;
 
-        // Je supprime le bon noeud
-        if (noeudTemporaire == parent->gauche)
-            auxSupprimerRadical(noeudTemporaire->radical, parent->gauche );
-        else
-            auxSupprimerRadical(noeudTemporaire->radical, parent->droit);
-    }
+        // Les groupes du successeur pointent maintenant sur noeud, qui porte son radical
+        remplacerDansGroupes(noeudTemporaire, noeud);
+        noeud->appSynonymes = noeudTemporaire->appSynonymes;
 
-    /**
-    * \fn bool auxGetNombreSens(const std::string &motRadical, NoeudDicoSynonymes *root) const
-    * \brief Fonction récursive servant à chercher le nombre de sens d'un mot
-    * \param[in] motRadical le mot à chercher
-    * \param[in] root le noeud où aller chercher le mot
-    * \post L'arbre reste inchangé.
-    * \return int le nombre de sens du mot
-    */
-    int DicoSynonymes::auxGetNombreSens(const std::string &motRadical, DicoSynonymes::NoeudDicoSynonymes *root) const {
-        int nbSens;
-        if (root->radical == motRadical)
-        {
-            return root->appSynonymes.size();
-        }
-        else if (motRadical > root->radical) nbSens = auxGetNombreSens(motRadical, root->droit);
-        else if (motRadical < root->radical) nbSens = auxGetNombreSens( motRadical, root->gauche);
-
-        return nbSens;
-    }
-
-    /**
-    * \fn  std::vector<std::string> auxGetFlexions(const std::string &motRadical, NoeudDicoSynonymes *root) const
-    * \brief Fonction récursive servant à chercher les flexions d'un mot
-    * \param[in] motRadical le mot à chercher pour retourner sa liste de flexions
-    * \param[in] root le noeud où aller chercher le mot
-    * \post L'arbre reste inchangé.
-    * \return std::vector<std::string> le vecteur de toutes les flexions du mot radical
-    */
-    std::vector<std::string> DicoSynonymes::auxGetFlexions(const std::string& motRadical, DicoSynonymes::NoeudDicoSynonymes *root) const {
-        std::vector<std::string> flexions;
-        if (root->radical == motRadical)
-        {
-            for (auto flexion : root->flexions) {
-                flexions.push_back(flexion);
-            }
-            return flexions;
-        }
-        else if (motRadical > root->radical) flexions = auxGetFlexions(motRadical, root->droit);
-        else if (motRadical < root->radical) flexions = auxGetFlexions( motRadical, root->gauche);
-
-        return flexions;
+        // Je supprime le bon noeud. La descente part de noeud->droit pour que
+        // toutes les hauteurs du chemin jusqu'au successeur soient remises à jour.
+        auxSupprimerRadical(noeud->radical, noeud->droit);
     }
 
     /**
@@ -826,7 +2116,8 @@ namespace TP3
     * \post L'arbre reste inchangé.
     * \return std::vector<DicoSynonymes::NoeudDicoSynonymes*> le vecteur de toutes les adresses de l'Arbre dans un parcours pré-ordre
     */
-    std::vector<DicoSynonymes::NoeudDicoSynonymes*> DicoSynonymes::parcoursPreOrdre() const {
+    template <class Traits>
+    std::vector<typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes*> DicoSynonymesGenerique<Traits>::parcoursPreOrdre() const {
 
             std::vector<NoeudDicoSynonymes*> accumulateur;
             auxParcoursPreOrdre(racine, accumulateur);
@@ -841,7 +2132,8 @@ namespace TP3
     * \param[in] accumulateur le vecteur de noeuds
     * \post L'arbre reste inchangé.
     */
-    void DicoSynonymes::auxParcoursPreOrdre(DicoSynonymes::NoeudDicoSynonymes *sousArbre,
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxParcoursPreOrdre(NoeudDicoSynonymes *sousArbre,
                                             std::vector<NoeudDicoSynonymes *> &accumulateur) const {
             if (!sousArbre) return;
 
@@ -851,26 +2143,848 @@ namespace TP3
     }
 
     /**
-    * \fn  float distanceLevenstein(Dconst std::string &mot1, const std::string &mot2) const
-    * \brief Fonction calculant la distance entre deux mots
+    * \fn  float distanceLevenstein(std::string_view mot1, std::string_view mot2)
+    * \brief Fonction calculant la distance entre deux mots, une ligne de la matrice à la fois.
+    *        Aussi utilisée par ImageDico.
     * \param[in] mot1 le premier mot à comparer
     * \param[in] mot2 le deuxième mot à comparer
-    * \post L'arbre reste inchangé.
-    * \return float la similitude entre les 2 mots : 1 == mots identiques 0 == mots complètement différents
+    * \return float la distance de Levenshtein entre les 2 mots
     */
-    float DicoSynonymes::distanceLevenstein(const std::string &mot1, const std::string &mot2) const {
+    template <class Traits>
+    float DicoSynonymesGenerique<Traits>::distanceLevenstein(std::string_view mot1, std::string_view mot2) {
         const std::size_t len1 = mot1.size(), len2 = mot2.size();
-        std::vector<std::vector<unsigned int>> d(len1 + 1, std::vector<unsigned int>(len2 + 1));
-
-        d[0][0] = 0;
-        for(unsigned int i = 1; i <= len1; ++i) d[i][0] = i;
-        for(unsigned int i = 1; i <= len2; ++i) d[0][i] = i;
+        std::vector<unsigned int> ligne(len2 + 1);
+        for(unsigned int j = 0; j <= len2; ++j) ligne[j] = j;
 
         for(unsigned int i = 1; i <= len1; ++i)
+        {
+            unsigned int diagonale = ligne[0];
+            ligne[0] = i;
             for(unsigned int j = 1; j <= len2; ++j)
-                d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (mot1[i - 1] == mot2[j - 1] ? 0 : 1) });
-        return d[len1][len2];
+            {
+                unsigned int haut = ligne[j];
+                ligne[j] = std::min({ haut + 1, ligne[j - 1] + 1, diagonale + (mot1[i - 1] == mot2[j - 1] ? 0 : 1) });
+                diagonale = haut;
+            }
+        }
+        return ligne[len2];
+    }
+
+    /**
+    * \fn bool flexionPresente(const NoeudDicoSynonymes *noeud, const std::string &motFlexion) const
+    * \brief Fonction déterminant si motFlexion est une flexion du noeud, quelle que soit la représentation.
+    *        En mode compressé, on compare les codes sans décompresser.
+    * \param[in] noeud le noeud du radical
+    * \param[in] motFlexion la flexion à chercher
+    * \post L'arbre reste inchangé.
+    * \return bool vrai si la flexion est présente, faux sinon
+    */
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::flexionPresente(const NoeudDicoSynonymes *noeud, const std::string &motFlexion) const {
+        if (!compressionFlexions) return noeud->flexions.contient(motFlexion);
+
+        TableSuffixes::Code code;
+        return suffixes.coder(noeud->radical, motFlexion, code) && noeud->flexions.contient(code.vue());
+    }
+
+    /**
+    * \fn bool insererFlexion(NoeudDicoSynonymes *noeud, const std::string &motFlexion)
+    * \brief Fonction ajoutant motFlexion aux flexions du noeud dans la représentation courante
+    * \param[in] noeud le noeud du radical
+    * \param[in] motFlexion la flexion à ajouter
+    * \return bool vrai si la flexion a été ajoutée, faux si elle était déjà présente
+    */
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::insererFlexion(NoeudDicoSynonymes *noeud, const std::string &motFlexion) {
+        raciniseurAJour = false;
+        motsParLongueurAJour = false;
+        if (!compressionFlexions) return noeud->flexions.ajouter(motFlexion);
+
+        if (flexionPresente(noeud, motFlexion)) return false;
+        return noeud->flexions.ajouter(suffixes.compresser(noeud->radical, motFlexion).vue());
+    }
+
+    /**
+    * \fn bool retirerFlexion(NoeudDicoSynonymes *noeud, const std::string &motFlexion)
+    * \brief Fonction retirant motFlexion des flexions du noeud dans la représentation courante
+    * \param[in] noeud le noeud du radical
+    * \param[in] motFlexion la flexion à retirer
+    * \return bool vrai si la flexion a été retirée, faux si elle n'était pas présente
+    */
+    template <class Traits>
+    bool DicoSynonymesGenerique<Traits>::retirerFlexion(NoeudDicoSynonymes *noeud, const std::string &motFlexion) {
+        raciniseurAJour = false;
+        motsParLongueurAJour = false;
+        if (!compressionFlexions) return noeud->flexions.retirer(motFlexion);
+
+        TableSuffixes::Code code;
+        return suffixes.coder(noeud->radical, motFlexion, code) && noeud->flexions.retirer(code.vue());
+    }
+
+    /**
+    * \fn std::vector<std::string> flexionsDe(const NoeudDicoSynonymes *noeud) const
+    * \brief Fonction retournant les flexions du noeud, décompressées au besoin
+    * \param[in] noeud le noeud du radical
+    * \post L'arbre reste inchangé.
+    * \return std::vector<std::string> les flexions dans l'ordre d'insertion
+    */
+    template <class Traits>
+    std::vector<std::string> DicoSynonymesGenerique<Traits>::flexionsDe(const NoeudDicoSynonymes *noeud) const {
+        if (!compressionFlexions) return noeud->flexions.versVecteur();
+
+        std::vector<std::string> flexions;
+        flexions.reserve(noeud->flexions.taille());
+        for (auto code : noeud->flexions)
+            flexions.push_back(suffixes.decompresser(noeud->radical, code));
+        return flexions;
+    }
+    /**
+    * \fn NoeudDicoSynonymes* trouverNoeud(const std::string &motRadical) const
+    * \brief Fonction retournant le noeud contenant motRadical
+    * \param[in] motRadical le radical à chercher
+    * \post L'arbre reste inchangé.
+    * \return le noeud du radical, 0 s'il n'est pas dans le dictionnaire
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::trouverNoeud(const std::string &motRadical) const {
+        if (!filtreMots.peutContenir(motRadical)) return 0;
+        NoeudDicoSynonymes* noeud = racine;
+        while (noeud != 0 && noeud->radical != motRadical)
+            noeud = Traits::inferieur(motRadical, noeud->radical) ? noeud->gauche : noeud->droit;
+        return noeud;
+    }
+
+    /**
+    * \fn std::optional<std::string> auxRechercherRadical(const std::string &mot) const
+    * \brief Fonction cherchant, sans passer par le cache, le radical dont mot est une flexion
+    * \param[in] mot le mot à chercher
+    * \post L'arbre reste inchangé.
+    * \return le radical trouvé, ou rien si mot n'est dans aucune liste de flexions
+    */
+    template <class Traits>
+    std::optional<std::string> DicoSynonymesGenerique<Traits>::auxRechercherRadical(const std::string &mot) const {
+        // L'index ne retourne que les radicaux dont le radical ou une flexion contient tous les
+        // trigrammes du mot : ce sont les seuls dont mot peut être une flexion.
+        std::vector<std::string> candidats = indexTrigrammes.candidats(mot, 0);
+
+        const NoeudDicoSynonymes* meilleurNoeud = 0;
+        float similitudeMax = -1;
+        for (auto &candidat : candidats) {
+            const NoeudDicoSynonymes* noeud = trouverNoeud(candidat);
+            // je vérifie si le mot est dans la liste de flexion du candidat
+            if (noeud == 0 || !flexionPresente(noeud, mot)) continue;
+
+            float degre = similitude(noeud->radical, mot);
+            if (degre > similitudeMax)
+            {
+                similitudeMax = degre;
+                meilleurNoeud = noeud;
+            }
+        }
+        if (meilleurNoeud != 0) return meilleurNoeud->radical;
+        return std::nullopt;
+    }
+
+    /**
+    * \fn void reconstruireIndexTrigrammes()
+    * \brief Fonction reconstruisant l'index de trigrammes à partir de l'arbre, ce qui élimine
+    *        les entrées des radicaux supprimés
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::reconstruireIndexTrigrammes() {
+        indexTrigrammes.vider();
+        for (auto noeud : parcoursPreOrdre())
+        {
+            indexTrigrammes.ajouterMot(noeud->radical, noeud->radical);
+            for (auto &flexion : flexionsDe(noeud))
+                indexTrigrammes.ajouterMot(noeud->radical, flexion);
+        }
+    }
+
+    /**
+    * \fn void reconstruireFiltre()
+    * \brief Fonction reconstruisant le filtre de Bloom à partir de l'arbre, ce qui élimine les bits
+    *        des mots retirés. Le filtre est dimensionné pour le double des mots actuels : il ne sera
+    *        reconstruit pour avoir débordé qu'après autant d'ajouts.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::reconstruireFiltre() {
+        std::vector<NoeudDicoSynonymes*> noeuds = parcoursPreOrdre();
+        std::size_t nbMots = 0;
+        for (auto noeud : noeuds) nbMots += 1 + nombreFlexions(noeud);
+
+        filtreMots.dimensionner(2 * nbMots);
+        for (auto noeud : noeuds)
+        {
+            filtreMots.ajouter(noeud->radical);
+            for (auto &flexion : flexionsDe(noeud))
+                filtreMots.ajouter(flexion);
+        }
+    }
+
+    /**
+    * \fn std::size_t nombreFlexions(const NoeudDicoSynonymes *noeud) const
+    * \brief Fonction retournant le nombre de flexions du noeud, sans les décompresser
+    */
+    template <class Traits>
+    std::size_t DicoSynonymesGenerique<Traits>::nombreFlexions(const NoeudDicoSynonymes *noeud) const {
+        return noeud->flexions.taille();
+    }
+    /**
+    * \fn void auxParcoursEnOrdre(NoeudDicoSynonymes *sousArbre, std::vector<NoeudDicoSynonymes *> &accumulateur) const
+    * \brief Fonction récursive accumulant les pointeurs de noeuds en ordre croissant de radical
+    * \param[in] sousArbre le sous-arbre à parcourir
+    * \param[in] accumulateur le vecteur de noeuds
+    * \post L'arbre reste inchangé.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxParcoursEnOrdre(NoeudDicoSynonymes *sousArbre,
+                                           std::vector<NoeudDicoSynonymes *> &accumulateur) const {
+        if (!sousArbre) return;
+
+        auxParcoursEnOrdre(sousArbre->gauche, accumulateur);
+        accumulateur.push_back(sousArbre);
+        auxParcoursEnOrdre(sousArbre->droit, accumulateur);
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* construireEquilibre(const std::vector<NoeudDicoSynonymes*> &noeuds, int debut, int fin)
+    * \brief Fonction récursive reliant les noeuds triés [debut, fin[ en un arbre parfaitement équilibré.
+    *        Les noeuds eux-mêmes sont réutilisés : les pointeurs des groupes de synonymes restent valides.
+    * \param[in] noeuds les noeuds en ordre croissant de radical
+    * \return la racine du sous-arbre construit
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::construireEquilibre(const std::vector<NoeudDicoSynonymes*> &noeuds,
+                                                                         int debut, int fin) {
+        if (debut >= fin) return 0;
+
+        int milieu = debut + (fin - debut) / 2;
+        NoeudDicoSynonymes* noeud = noeuds[milieu];
+        noeud->gauche = construireEquilibre(noeuds, debut, milieu);
+        noeud->droit = construireEquilibre(noeuds, milieu + 1, fin);
+        noeud->hauteur = 1 + std::max(hauteur(noeud->gauche), hauteur(noeud->droit));
+        noeud->taille = fin - debut;
+        return noeud;
+    }
+
+    /**
+    * \fn std::vector<NoeudDicoSynonymes*> fusionnerRadicaux(const std::vector<std::string> &motsRadicaux)
+    * \brief Fonction insérant d'un coup des radicaux absents de l'arbre : leurs noeuds forment un arbre
+    *        équilibré, réuni à l'arbre par auxFusionner en un seul parcours (scinder / joindre), sans
+    *        reconstruire les noeuds existants
+    * \param[in] motsRadicaux les radicaux à insérer, triés, distincts et absents de l'arbre
+    * \return les noeuds créés, dans l'ordre de motsRadicaux
+    */
+    template <class Traits>
+    std::vector<typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes*>
+    DicoSynonymesGenerique<Traits>::fusionnerRadicaux(const std::vector<std::string> &motsRadicaux) {
+        std::vector<NoeudDicoSynonymes*> nouveaux;
+        if (motsRadicaux.empty()) return nouveaux;
+
+        nouveaux.reserve(motsRadicaux.size());
+        for (auto &motRadical : motsRadicaux)
+        {
+            nouveaux.push_back(creerNoeud(motRadical));
+            indexTrigrammes.ajouterMot(motRadical, motRadical);
+            filtreMots.ajouter(motRadical);
+        }
+        motsParLongueurAJour = false;
+
+        racine = auxFusionner(racine, construireEquilibre(nouveaux, 0, nouveaux.size()), 0);
+        nbRadicaux += nouveaux.size();
+        grapheSynonymesAJour = false;
+        return nouveaux;
+    }
+
+    /**
+    * \fn void auxLocaliser(NoeudDicoSynonymes *sousArbre, const std::vector<std::string> &motsRadicaux,
+    *                       std::size_t debut, std::size_t fin, std::vector<NoeudDicoSynonymes*> &noeuds) const
+    * \brief Parcours fusionné : range dans noeuds[i] le noeud de motsRadicaux[i], pour i dans [debut, fin[.
+    *        Les mots inférieurs au radical du sous-arbre descendent à gauche, les autres à droite ; un
+    *        sous-arbre n'est visité que si un mot peut s'y trouver.
+    * \param[in] motsRadicaux des radicaux triés et distincts
+    * \param[out] noeuds les noeuds trouvés ; les cases des radicaux absents ne sont pas touchées
+    * \post L'arbre reste inchangé.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxLocaliser(NoeudDicoSynonymes *sousArbre, const std::vector<std::string> &motsRadicaux,
+                                                      std::size_t debut, std::size_t fin,
+                                                      std::vector<NoeudDicoSynonymes*> &noeuds) const {
+        if (!sousArbre || debut >= fin) return;
+
+        std::size_t milieu = std::lower_bound(motsRadicaux.begin() + debut, motsRadicaux.begin() + fin, sousArbre->radical,
+                                              Traits::inferieur) - motsRadicaux.begin();
+        std::size_t suite = milieu;
+        if (milieu < fin && !Traits::inferieur(sousArbre->radical, motsRadicaux[milieu]))
+            noeuds[suite++] = sousArbre;
+        auxLocaliser(sousArbre->gauche, motsRadicaux, debut, milieu, noeuds);
+        auxLocaliser(sousArbre->droit, motsRadicaux, suite, fin, noeuds);
+    }
+
+    /**
+    * \fn void differenceFlexions(const std::string &motRadical, const std::vector<std::string> &motsFlexions,
+    *                             std::vector<Mutation> &mutations) const
+    * \brief Fonction ajoutant à mutations ce qu'il faut pour que motRadical existe et ait exactement
+    *        motsFlexions, dans cet ordre. Les flexions conservées ne sont pas touchées lorsque les
+    *        retraits et les ajouts (à la fin) suffisent à obtenir cet ordre ; sinon, elles sont toutes refaites.
+    * \param[in] motRadical le radical, présent ou non dans l'arbre
+    * \param[in] motsFlexions ses flexions dans le fichier
+    * \post L'arbre reste inchangé.
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::differenceFlexions(const std::string &motRadical, const std::vector<std::string> &motsFlexions,
+                                           std::vector<Mutation> &mutations) const {
+        std::vector<std::string> tries(motsFlexions);
+        std::sort(tries.begin(), tries.end());
+        if (std::adjacent_find(tries.begin(), tries.end()) != tries.end())
+            throw std::logic_error("calculerDifference : Une flexion est répétée dans le fichier");
+
+        std::vector<std::string> anciennes;
+        NoeudDicoSynonymes* noeud = trouverNoeud(motRadical);
+        if (noeud == 0)
+            mutations.push_back({Mutation::AjoutRadical, motRadical, ""});
+        else
+            anciennes = flexionsDe(noeud);
+        if (anciennes == motsFlexions) return;
+
+        // peu de flexions par radical : les recherches linéaires suffisent
+        auto contient = [](const std::vector<std::string>& flexions, const std::string& flexion)
+                        { return std::find(flexions.begin(), flexions.end(), flexion) != flexions.end(); };
+        std::vector<std::string> obtenues;
+        for (auto &flexion : anciennes)
+            if (contient(motsFlexions, flexion)) obtenues.push_back(flexion);
+        for (auto &flexion : motsFlexions)
+            if (!contient(anciennes, flexion)) obtenues.push_back(flexion);
+        bool toutRefaire = obtenues != motsFlexions;
+
+        for (auto &flexion : anciennes)
+            if (toutRefaire || !contient(motsFlexions, flexion))
+                mutations.push_back({Mutation::SuppressionFlexion, motRadical, flexion});
+        for (auto &flexion : motsFlexions)
+            if (toutRefaire || !contient(anciennes, flexion))
+                mutations.push_back({Mutation::AjoutFlexion, motRadical, flexion});
+    }
+    /**
+    * \fn const GrapheSynonymes& graphe() const
+    * \brief Fonction retournant la vue CSR des groupes de synonymes, reconstruite si un radical
+    *        ou un groupe a changé depuis sa dernière construction
+    * \post Le contenu du dictionnaire reste inchangé.
+    * \return le graphe à jour
+    */
+    template <class Traits>
+    const GrapheSynonymes& DicoSynonymesGenerique<Traits>::graphe() const {
+        std::lock_guard<std::mutex> garde(verrouGraphe);
+        if (grapheSynonymesAJour) return grapheSynonymes;
+
+        std::vector<NoeudDicoSynonymes*> noeuds;
+        noeuds.reserve(nbRadicaux);
+        auxParcoursEnOrdre(racine, noeuds);
+        // le graphe cherche ses noms dans l'ordre de std::string, qui peut différer de Traits::inferieur
+        auto ordreChaines = [](const NoeudDicoSynonymes* a, const NoeudDicoSynonymes* b)
+                            { return a->radical < b->radical; };
+        if (!std::is_sorted(noeuds.begin(), noeuds.end(), ordreChaines))
+            std::sort(noeuds.begin(), noeuds.end(), ordreChaines);
+
+        std::unordered_map<const NoeudDicoSynonymes*, std::uint32_t> identifiants;
+        std::vector<std::string> radicaux;
+        radicaux.reserve(noeuds.size());
+        for (std::uint32_t i = 0; i < noeuds.size(); ++i)
+        {
+            identifiants.emplace(noeuds[i], i);
+            radicaux.push_back(noeuds[i]->radical);
+        }
+
+        std::vector< std::vector<std::uint32_t> > membres(groupesSynonymes.size());
+        for (std::size_t g = 0; g < groupesSynonymes.size(); ++g)
+            for (auto adresse : groupesSynonymes[g])
+                membres[g].push_back(identifiants[adresse]);
+
+        grapheSynonymes.construire(radicaux, membres);
+        grapheSynonymesAJour = true;
+        return grapheSynonymes;
+    }
+
+    /**
+    * \fn const RaciniseurSuffixes& raciniseur() const
+    * \brief Retourne le raciniseur, réappris à partir de toutes les flexions s'il n'est plus à jour
+    */
+    template <class Traits>
+    const RaciniseurSuffixes& DicoSynonymesGenerique<Traits>::raciniseur() const {
+        std::lock_guard<std::mutex> garde(verrouRaciniseur);
+        if (raciniseurAJour) return raciniseurSuffixes;
+
+        raciniseurSuffixes.vider();
+        for (auto noeud : parcoursPreOrdre())
+            for (auto &flexion : flexionsDe(noeud))
+                raciniseurSuffixes.apprendre(noeud->radical, flexion);
+        raciniseurAJour = true;
+        return raciniseurSuffixes;
+    }
+
+    /**
+    * \fn const RadicauxParLongueur& balayage() const
+    * \brief Retourne la copie par longueur des radicaux et des flexions, refaite si elle n'est plus à jour.
+    *        Le propriétaire de chaque mot est le rang de son radical en ordre alphabétique.
+    */
+    template <class Traits>
+    const RadicauxParLongueur& DicoSynonymesGenerique<Traits>::balayage() const {
+        std::lock_guard<std::mutex> garde(verrouMotsParLongueur);
+        if (motsParLongueurAJour) return motsParLongueur;
+
+        std::vector<NoeudDicoSynonymes*> noeuds;
+        noeuds.reserve(nbRadicaux);
+        auxParcoursEnOrdre(racine, noeuds);
+
+        motsParLongueur.vider();
+        radicauxBalayes.clear();
+        for (std::uint32_t i = 0; i < noeuds.size(); ++i)
+        {
+            radicauxBalayes.push_back(noeuds[i]->radical);
+            motsParLongueur.ajouter(noeuds[i]->radical, i);
+            for (auto &flexion : flexionsDe(noeuds[i]))
+                motsParLongueur.ajouter(flexion, i);
+        }
+        motsParLongueurAJour = true;
+        return motsParLongueur;
+    }
+
+    /**
+    * \fn void detacherDesGroupes(NoeudDicoSynonymes *noeud)
+    * \brief Fonction retirant noeud de tous ses groupes de synonymes
+    * \param[in] noeud le noeud à retirer
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::detacherDesGroupes(NoeudDicoSynonymes *noeud) {
+        for (auto numGroupe : noeud->appSynonymes)
+            groupesSynonymes[numGroupe].remove(noeud);
+        noeud->appSynonymes.clear();
+    }
+
+    /**
+    * \fn void remplacerDansGroupes(NoeudDicoSynonymes *ancien, NoeudDicoSynonymes *nouveau)
+    * \brief Fonction faisant pointer sur nouveau les groupes de synonymes qui pointaient sur ancien
+    * \param[in] ancien le noeud qui va disparaître
+    * \param[in] nouveau le noeud qui le remplace
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::remplacerDansGroupes(NoeudDicoSynonymes *ancien, NoeudDicoSynonymes *nouveau) {
+        for (auto numGroupe : ancien->appSynonymes)
+            std::replace(groupesSynonymes[numGroupe].begin(), groupesSynonymes[numGroupe].end(), ancien, nouveau);
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* joindre(NoeudDicoSynonymes *gauche, NoeudDicoSynonymes *milieu, NoeudDicoSynonymes *droit)
+    * \brief Fonction récursive formant un arbre AVL de gauche, milieu et droit, tous les radicaux de gauche
+    *        précédant celui de milieu et tous ceux de droit le suivant. On descend le long du bord du plus
+    *        haut des deux arbres jusqu'à un sous-arbre de même hauteur que l'autre, puis on rééquilibre en remontant.
+    * \param[in] milieu un noeud détaché, dont les enfants sont remplacés
+    * \return la racine de l'arbre formé, en O(|hauteur(gauche) - hauteur(droit)| + 1)
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::joindre(NoeudDicoSynonymes *gauche, NoeudDicoSynonymes *milieu,
+                                                             NoeudDicoSynonymes *droit) {
+        if (hauteur(gauche) > hauteur(droit) + 1)
+        {
+            gauche->droit = joindre(gauche->droit, milieu, droit);
+            equilibrer(gauche);
+            return gauche;
+        }
+        if (hauteur(droit) > hauteur(gauche) + 1)
+        {
+            droit->gauche = joindre(gauche, milieu, droit->gauche);
+            equilibrer(droit);
+            return droit;
+        }
+        milieu->gauche = gauche;
+        milieu->droit = droit;
+        milieu->hauteur = 1 + std::max(hauteur(gauche), hauteur(droit));
+        milieu->taille = 1 + tailleSousArbre(gauche) + tailleSousArbre(droit);
+        return milieu;
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* concatener(NoeudDicoSynonymes *gauche, NoeudDicoSynonymes *droit)
+    * \brief Fonction formant un arbre AVL de gauche et droit, tous les radicaux de gauche précédant ceux de droit
+    * \return la racine de l'arbre formé
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::concatener(NoeudDicoSynonymes *gauche, NoeudDicoSynonymes *droit) {
+        if (!gauche) return droit;
+        if (!droit) return gauche;
+        NoeudDicoSynonymes* minimum = detacherMinimum(droit);
+        return joindre(gauche, minimum, droit);
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* detacherMinimum(NoeudDicoSynonymes *&sousArbre)
+    * \brief Fonction récursive retirant du sous-arbre le noeud du plus petit radical, sans le détruire
+    * \param[in] sousArbre un sous-arbre non vide, rééquilibré en remontant
+    * \return le noeud retiré
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::detacherMinimum(NoeudDicoSynonymes *&sousArbre) {
+        if (sousArbre->gauche == 0)
+        {
+            NoeudDicoSynonymes* minimum = sousArbre;
+            sousArbre = sousArbre->droit;
+            return minimum;
+        }
+        NoeudDicoSynonymes* minimum = detacherMinimum(sousArbre->gauche);
+        equilibrer(sousArbre);
+        return minimum;
+    }
+
+    /**
+    * \fn void scinder(NoeudDicoSynonymes *sousArbre, const std::string &cle, NoeudDicoSynonymes *&inferieurs,
+    *                  NoeudDicoSynonymes *&egal, NoeudDicoSynonymes *&superieurs)
+    * \brief Fonction récursive séparant le sous-arbre en deux arbres AVL, les radicaux inférieurs à cle
+    *        et les radicaux supérieurs à cle, en O(log n). Les noeuds ne sont pas copiés.
+    * \param[out] egal le noeud de cle, détaché, ou 0 si cle n'est pas dans le sous-arbre
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::scinder(NoeudDicoSynonymes *sousArbre, const std::string &cle, NoeudDicoSynonymes *&inferieurs,
+                                NoeudDicoSynonymes *&egal, NoeudDicoSynonymes *&superieurs) {
+        if (!sousArbre)
+        {
+            inferieurs = egal = superieurs = 0;
+            return;
+        }
+
+        NoeudDicoSynonymes *gauche = sousArbre->gauche, *droit = sousArbre->droit;
+        if (Traits::inferieur(cle, sousArbre->radical))
+        {
+            scinder(gauche, cle, inferieurs, egal, superieurs);
+            superieurs = joindre(superieurs, sousArbre, droit);
+        }
+        else if (Traits::inferieur(sousArbre->radical, cle))
+        {
+            scinder(droit, cle, inferieurs, egal, superieurs);
+            inferieurs = joindre(gauche, sousArbre, inferieurs);
+        }
+        else
+        {
+            inferieurs = gauche;
+            superieurs = droit;
+            egal = sousArbre;
+            egal->gauche = egal->droit = 0;
+            egal->hauteur = 0;
+            egal->taille = 1;
+        }
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* copierSousArbre(const DicoSynonymes &autre, const NoeudDicoSynonymes *sousArbre)
+    * \brief Fonction récursive copiant un sous-arbre de autre avec sa forme, ses radicaux et ses flexions
+    *        (dans la représentation de ce dictionnaire), mais sans appartenances aux groupes
+    * \return la racine de la copie
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::copierSousArbre(const DicoSynonymesGenerique &autre,
+                                                                     const NoeudDicoSynonymes *sousArbre) {
+        if (!sousArbre) return 0;
+
+        NoeudDicoSynonymes* copie = creerNoeud(sousArbre->radical);
+        if (!compressionFlexions && !autre.compressionFlexions)
+            copie->flexions = sousArbre->flexions;
+        else
+            for (auto &flexion : autre.flexionsDe(sousArbre))
+                insererFlexion(copie, flexion);
+        copie->gauche = copierSousArbre(autre, sousArbre->gauche);
+        copie->droit = copierSousArbre(autre, sousArbre->droit);
+        copie->hauteur = sousArbre->hauteur;
+        copie->taille = sousArbre->taille;
+        return copie;
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* auxFusionner(NoeudDicoSynonymes *sousArbre, NoeudDicoSynonymes *copie, int profondeurParallele)
+    * \brief Fonction récursive réunissant sousArbre et copie : sousArbre est scindé au radical de la racine de
+    *        copie, chaque moitié est réunie au sous-arbre correspondant de copie, puis les deux résultats sont
+    *        joints. Un noeud de copie dont le radical est déjà présent donne ses flexions au noeud existant
+    *        (qui garde ses groupes) et est détruit. Les nouvelles flexions ne touchent qu'un noeud à la fois :
+    *        les deux moitiés peuvent être traitées en parallèle.
+    * \param[in] profondeurParallele nombre de niveaux qui peuvent encore se dédoubler
+    * \return la racine de l'union
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::auxFusionner(NoeudDicoSynonymes *sousArbre, NoeudDicoSynonymes *copie,
+                                                                  int profondeurParallele) {
+        if (!copie) return sousArbre;
+        if (!sousArbre) return copie;
+
+        bool enParallele = profondeurParallele > 0 && tailleSousArbre(sousArbre) + tailleSousArbre(copie) > SEUIL_PARALLELE;
+        NoeudDicoSynonymes *copieGauche = copie->gauche, *copieDroit = copie->droit;
+        NoeudDicoSynonymes *inferieurs, *egal, *superieurs;
+        scinder(sousArbre, copie->radical, inferieurs, egal, superieurs);
+
+        NoeudDicoSynonymes* milieu = copie;
+        if (egal != 0)
+        {
+            // même radical, même table : les codes se comparent comme les flexions
+            for (auto entree : copie->flexions) egal->flexions.ajouter(entree);
+            detruireNoeud(copie);
+            milieu = egal;
+        }
+
+        NoeudDicoSynonymes *gauche, *droit;
+        if (enParallele)
+        {
+            auto futur = std::async(std::launch::async,
+                                    [&] { return auxFusionner(inferieurs, copieGauche, profondeurParallele - 1); });
+            droit = auxFusionner(superieurs, copieDroit, profondeurParallele - 1);
+            gauche = futur.get();
+        }
+        else
+        {
+            gauche = auxFusionner(inferieurs, copieGauche, 0);
+            droit = auxFusionner(superieurs, copieDroit, 0);
+        }
+        return joindre(gauche, milieu, droit);
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* auxIntersection(NoeudDicoSynonymes *sousArbre, const NoeudDicoSynonymes *autre,
+    *                                         int profondeurParallele, std::vector<NoeudDicoSynonymes*> &retires)
+    * \brief Fonction récursive ne gardant de sousArbre que les radicaux présents dans le sous-arbre autre
+    * \param[out] retires les noeuds enlevés de l'arbre, à détruire par detruireRetires
+    * \return la racine du sous-arbre conservé
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::auxIntersection(NoeudDicoSynonymes *sousArbre,
+                                                                     const NoeudDicoSynonymes *autre,
+                                                                     int profondeurParallele,
+                                                                     std::vector<NoeudDicoSynonymes*> &retires) {
+        if (!sousArbre) return 0;
+        if (!autre)
+        {
+            auxParcoursEnOrdre(sousArbre, retires);
+            return 0;
+        }
+
+        bool enParallele = profondeurParallele > 0 && tailleSousArbre(sousArbre) + autre->taille > SEUIL_PARALLELE;
+        NoeudDicoSynonymes *inferieurs, *egal, *superieurs;
+        scinder(sousArbre, autre->radical, inferieurs, egal, superieurs);
+
+        NoeudDicoSynonymes *gauche, *droit;
+        if (enParallele)
+        {
+            std::vector<NoeudDicoSynonymes*> retiresGauche;
+            auto futur = std::async(std::launch::async, [&] {
+                return auxIntersection(inferieurs, autre->gauche, profondeurParallele - 1, retiresGauche);
+            });
+            droit = auxIntersection(superieurs, autre->droit, profondeurParallele - 1, retires);
+            gauche = futur.get();
+            retires.insert(retires.end(), retiresGauche.begin(), retiresGauche.end());
+        }
+        else
+        {
+            gauche = auxIntersection(inferieurs, autre->gauche, 0, retires);
+            droit = auxIntersection(superieurs, autre->droit, 0, retires);
+        }
+        if (egal != 0) return joindre(gauche, egal, droit);
+        return concatener(gauche, droit);
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* auxDifference(NoeudDicoSynonymes *sousArbre, const NoeudDicoSynonymes *autre,
+    *                                       int profondeurParallele, std::vector<NoeudDicoSynonymes*> &retires)
+    * \brief Fonction récursive enlevant de sousArbre les radicaux présents dans le sous-arbre autre
+    * \param[out] retires les noeuds enlevés de l'arbre, à détruire par detruireRetires
+    * \return la racine du sous-arbre conservé
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::auxDifference(NoeudDicoSynonymes *sousArbre,
+                                                                   const NoeudDicoSynonymes *autre,
+                                                                   int profondeurParallele,
+                                                                   std::vector<NoeudDicoSynonymes*> &retires) {
+        if (!sousArbre || !autre) return sousArbre;
+
+        bool enParallele = profondeurParallele > 0 && tailleSousArbre(sousArbre) + autre->taille > SEUIL_PARALLELE;
+        NoeudDicoSynonymes *inferieurs, *egal, *superieurs;
+        scinder(sousArbre, autre->radical, inferieurs, egal, superieurs);
+        if (egal != 0) retires.push_back(egal);
+
+        NoeudDicoSynonymes *gauche, *droit;
+        if (enParallele)
+        {
+            std::vector<NoeudDicoSynonymes*> retiresGauche;
+            auto futur = std::async(std::launch::async, [&] {
+                return auxDifference(inferieurs, autre->gauche, profondeurParallele - 1, retiresGauche);
+            });
+            droit = auxDifference(superieurs, autre->droit, profondeurParallele - 1, retires);
+            gauche = futur.get();
+            retires.insert(retires.end(), retiresGauche.begin(), retiresGauche.end());
+        }
+        else
+        {
+            gauche = auxDifference(inferieurs, autre->gauche, 0, retires);
+            droit = auxDifference(superieurs, autre->droit, 0, retires);
+        }
+        return concatener(gauche, droit);
+    }
+
+    /**
+    * \fn void detruireRetires(const std::vector<NoeudDicoSynonymes*> &retires)
+    * \brief Fonction détruisant des noeuds déjà enlevés de l'arbre, comme le ferait supprimerRadical :
+    *        ils sont détachés de leurs groupes, de l'index de trigrammes et du cache
+    * \param[in] retires les noeuds à détruire
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::detruireRetires(const std::vector<NoeudDicoSynonymes*> &retires) {
+        nbRadicaux = tailleSousArbre(racine);
+        if (retires.empty()) return;
+
+        for (auto noeud : retires)
+        {
+            if (cacheRadicaux.estActif())
+                for (auto &flexion : flexionsDe(noeud))
+                    cacheRadicaux.invalider(flexion);
+            detacherDesGroupes(noeud);
+            indexTrigrammes.retirerRadical(noeud->radical);
+            filtreMots.signalerRetrait(1 + nombreFlexions(noeud));
+            detruireNoeud(noeud);
+        }
+        grapheSynonymesAJour = false;
+        raciniseurAJour = false;
+        motsParLongueurAJour = false;
+        if (indexTrigrammes.doitEtreReconstruit()) reconstruireIndexTrigrammes();
+        if (filtreMots.doitEtreReconstruit()) reconstruireFiltre();
+    }
+
+    /**
+    * \fn void auxDetruire(NoeudDicoSynonymes *sousArbre)
+    * \brief Fonction récursive libérant tous les noeuds d'un sous-arbre, sans toucher aux groupes ni aux index
+    * \param[in] sousArbre le sous-arbre à libérer
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::auxDetruire(NoeudDicoSynonymes *sousArbre) {
+        if (!sousArbre) return;
+
+        auxDetruire(sousArbre->gauche);
+        auxDetruire(sousArbre->droit);
+        detruireNoeud(sousArbre);
+    }
+
+    /**
+    * \fn NoeudDicoSynonymes* creerNoeud(const std::string &motRadical)
+    * \brief Fonction allouant, par l'allocateur de Traits, un noeud isolé pour motRadical
+    * \return le noeud, à libérer par detruireNoeud
+    */
+    template <class Traits>
+    typename DicoSynonymesGenerique<Traits>::NoeudDicoSynonymes* DicoSynonymesGenerique<Traits>::creerNoeud(const std::string &motRadical) {
+        NoeudDicoSynonymes* noeud = TraitsAllocateurNoeuds::allocate(allocateurNoeuds, 1);
+        try
+        {
+            TraitsAllocateurNoeuds::construct(allocateurNoeuds, noeud, motRadical);
+        }
+        catch (...)
+        {
+            TraitsAllocateurNoeuds::deallocate(allocateurNoeuds, noeud, 1);
+            throw;
+        }
+        return noeud;
+    }
+
+    /**
+    * \fn void detruireNoeud(NoeudDicoSynonymes *noeud)
+    * \brief Fonction libérant un noeud alloué par creerNoeud
+    */
+    template <class Traits>
+    void DicoSynonymesGenerique<Traits>::detruireNoeud(NoeudDicoSynonymes *noeud) {
+        TraitsAllocateurNoeuds::destroy(allocateurNoeuds, noeud);
+        TraitsAllocateurNoeuds::deallocate(allocateurNoeuds, noeud, 1);
+    }
+
+    /**
+    * \fn const std::vector<std::string>& normaliserTous(const std::vector<std::string>& mots, std::vector<std::string>& copie)
+    * \brief Fonction retournant mots tel quel si Traits ne normalise pas, sinon copie remplie de
+    *        la forme normalisée de chaque mot
+    */
+    template <class Traits>
+    const std::vector<std::string>& DicoSynonymesGenerique<Traits>::normaliserTous(const std::vector<std::string>& mots,
+                                                                                 std::vector<std::string>& copie) {
+        if (!NORMALISE) return mots;
+
+        copie.reserve(mots.size());
+        for (auto &mot : mots) copie.push_back(Traits::normaliser(mot));
+        return copie;
+    }
+
+    /**
+    * \fn std::vector<int> groupesRecouvrants(int numGroupe, float seuil) const
+    * \brief Fonction retournant, en ordre croissant, les autres groupes dont les membres communs
+    *        avec numGroupe représentent au moins la fraction seuil du plus petit des deux groupes
+    * \pre appSynonymes de chaque membre d'un groupe contient une fois le numéro de ce groupe.
+    */
+    template <class Traits>
+    std::vector<int> DicoSynonymesGenerique<Traits>::groupesRecouvrants(int numGroupe, float seuil) const {
+        // les groupes partageant au moins un membre sont trouvés par les appartenances des membres ;
+        // une fois triés, les membres communs avec un groupe sont le nombre de ses occurrences
+        std::vector<int> autres;
+        for (auto adresse : groupesSynonymes[numGroupe])
+            for (auto autre : adresse->appSynonymes)
+                if (autre != numGroupe) autres.push_back(autre);
+        std::sort(autres.begin(), autres.end());
+
+        std::vector<int> recouvrants;
+        std::size_t taille = groupesSynonymes[numGroupe].size();
+        for (std::size_t i = 0, j; i < autres.size(); i = j)
+        {
+            for (j = i + 1; j < autres.size() && autres[j] == autres[i]; ++j) ;
+            std::size_t plusPetit = std::min(taille, groupesSynonymes[autres[i]].size());
+            if (j - i >= seuil * plusPetit) recouvrants.push_back(autres[i]);
+        }
+        return recouvrants;
+    }
+
+    /**
+    * \fn int consoliderGroupe(int numGroupe)
+    * \brief Fonction fusionnant numGroupe et les groupes qui le recouvrent (seuilConsolidation)
+    *        dans le plus ancien d'entre eux, jusqu'à ce que plus aucun groupe ne le recouvre
+    * \post Les groupes absorbés sont vides ; le dernier groupe est retiré s'il a été absorbé.
+    * \return le numéro du groupe qui a tout reçu
+    */
+    template <class Traits>
+    int DicoSynonymesGenerique<Traits>::consoliderGroupe(int numGroupe) {
+        std::vector<int> recouvrants = groupesRecouvrants(numGroupe, seuilConsolidation);
+        while (!recouvrants.empty())
+        {
+            int receveur = std::min(numGroupe, recouvrants.front());
+            recouvrants.push_back(numGroupe);
+
+            std::unordered_set<const NoeudDicoSynonymes*> membres(groupesSynonymes[receveur].begin(),
+                                                                  groupesSynonymes[receveur].end());
+            for (auto absorbe : recouvrants)
+            {
+                if (absorbe == receveur) continue;
+                for (auto adresse : groupesSynonymes[absorbe])
+                {
+                    if (membres.insert(adresse).second) groupesSynonymes[receveur].push_back(adresse);
+
+                    // le numéro absorbé devient celui du receveur, sauf si le membre y est déjà
+                    std::vector<int>& appartenances = adresse->appSynonymes;
+                    auto it = std::find(appartenances.begin(), appartenances.end(), absorbe);
+                    if (it == appartenances.end()) continue;
+                    if (std::find(appartenances.begin(), appartenances.end(), receveur) == appartenances.end())
+                        *it = receveur;
+                    else
+                        appartenances.erase(it);
+                }
+                groupesSynonymes[absorbe].clear();
+            }
+            while (static_cast<int>(groupesSynonymes.size()) - 1 > receveur && groupesSynonymes.back().empty()
+                   && std::find(recouvrants.begin(), recouvrants.end(), static_cast<int>(groupesSynonymes.size()) - 1) != recouvrants.end())
+                groupesSynonymes.pop_back();
+
+            numGroupe = receveur;
+            recouvrants = groupesRecouvrants(numGroupe, seuilConsolidation);
+        }
+        return numGroupe;
     }
 
+    template class DicoSynonymesGenerique<TraitsDico>;
+    template class DicoSynonymesGenerique<TraitsSansCasseNiAccents>;
+    template class DicoSynonymesGenerique<TraitsFlexionsSeparees>;
 
-}//Fin du namespace
\ No newline at end of file
+}//Fin du namespace
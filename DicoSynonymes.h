@@ -19,6 +19,26 @@
 #include <queue>
 #include <math.h>
 #include <algorithm>
+#include <functional>
+#include <optional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <future>
+#include <type_traits>
+
+#include "ListeFlexions.h"
+#include "TableSuffixes.h"
+#include "IndexTrigrammes.h"
+#include "CacheRadicaux.h"
+#include "FiltreBloom.h"
+#include "GrapheSynonymes.h"
+#include "RaciniseurSuffixes.h"
+#include "RadicauxParLongueur.h"
+#include "TraitsDico.h"
+#include "EnsemblesDisjoints.h"
+#include "TraceDico.h"
 
 #ifndef _DICOSYNONYMES__H
 #define _DICOSYNONYMES__H
@@ -27,12 +47,19 @@ namespace TP3
 {
 
    /**
-   * \class DicoSynonymes
+   * \class DicoSynonymesGenerique
    *
    * \brief classe représentant un dictionnaire des synonymes
    *
+   * Traits (voir TraitsDico.h) fixe à la compilation la normalisation des mots, l'ordre des
+   * radicaux, l'allocateur des noeuds et le conteneur des flexions. Tous les mots reçus sont
+   * normalisés ; les mots retournés sont sous leur forme normalisée. DicoSynonymes est
+   * l'instanciation habituelle. Le code est dans DicoSynonymes.cpp, qui instancie
+   * explicitement les traits de TraitsDico.h ; d'autres traits y demandent une ligne de plus.
+   *
    */
-   class DicoSynonymes
+   template <class Traits = TraitsDico>
+   class DicoSynonymesGenerique
    {
    public:
 
@@ -42,7 +69,7 @@ namespace TP3
       *\post      Une instance vide de la classe a été initialisée
       *
       */
-      DicoSynonymes();
+      DicoSynonymesGenerique();
 
       /**
       *\brief  Constructeur de dictionnaire à partir d'un fichier
@@ -56,7 +83,7 @@ namespace TP3
       *\exception bad_alloc s'il n'y a pas assez de mémoire
       * Cette méthode appelle chargerDicoSynonyme !
       */
-      DicoSynonymes(std::ifstream &fichier);
+      DicoSynonymesGenerique(std::ifstream &fichier);
 
 
       /**
@@ -65,7 +92,49 @@ namespace TP3
       *\post      Une instance de la classe est détruite.
       *
       */
-      ~DicoSynonymes();
+      ~DicoSynonymesGenerique();
+
+      // Les noeuds appartiennent au dictionnaire : une copie se fait explicitement par cloner.
+      DicoSynonymesGenerique(const DicoSynonymesGenerique&) = delete;
+      DicoSynonymesGenerique& operator=(const DicoSynonymesGenerique&) = delete;
+
+      /**
+      *\brief     Constructeur de déplacement, en O(1)
+      *
+      *\pre       Aucun autre fil d'exécution n'utilise autre.
+      *
+      *\post      L'instance reçoit le contenu de autre, qui devient vide. Rien n'est alloué.
+      */
+      DicoSynonymesGenerique(DicoSynonymesGenerique&& autre) noexcept;
+
+      /**
+      *\brief     Affectation par déplacement : l'ancien contenu est détruit, celui de autre est pris en O(1)
+      *
+      *\pre       Aucun autre fil d'exécution n'utilise l'instance ni autre.
+      *
+      *\post      autre devient vide. Se déplacer dans soi-même ne fait rien.
+      */
+      DicoSynonymesGenerique& operator=(DicoSynonymesGenerique&& autre) noexcept;
+
+      /**
+      *\brief     Échanger les contenus de deux dictionnaires, en O(1)
+      *
+      *\pre       Aucun autre fil d'exécution n'utilise l'instance ni autre.
+      */
+      void echanger(DicoSynonymesGenerique& autre) noexcept;
+
+      /**
+      *\brief     Copie profonde du dictionnaire
+      *
+      * Les radicaux, les flexions (dans la même représentation), les groupes et leur numérotation,
+      * l'index de trigrammes et le filtre sont copiés. Le cache garde sa capacité mais part vide ;
+      * les vues reconstruites au besoin (graphe, raciniseur, copie par longueur) le seront dans la copie.
+      *
+      *\post      Le dictionnaire reste inchangé ; la copie n'en partage aucun noeud.
+      *
+      *\exception bad_alloc s'il n'y a pas assez de mémoire.
+      */
+      DicoSynonymesGenerique cloner() const;
 
       /**
       *\brief     Ajouter un radical au dictionnaire des synonymes
@@ -109,6 +178,175 @@ namespace TP3
       */
       void ajouterSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe);
 
+      /**
+      *\brief  Ajouter plusieurs flexions (motsFlexions) d'un radical (motRadical) en une seule descente.
+      *
+      *\pre    Il y a suffisament de mémoire.
+      *
+      *\post   Les flexions sont ajoutées, dans l'ordre, au dictionnaire des synonymes.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      *\exception logic_error si une des flexions existe déjà (ou est répétée) ou motRadical n'existe pas.
+      *\       Dans ce cas, aucune flexion n'est ajoutée.
+      */
+      void ajouterFlexions(const std::string& motRadical, const std::vector<std::string>& motsFlexions);
+
+      /**
+      *\brief  Créer un nouveau groupe de synonymes contenant motRadical et motsSynonymes.
+      *
+      *\pre    Le radical se trouve déjà dans le dictionnaire
+      *\       Il y a suffisament de mémoire
+      *
+      *\post   Les synonymes absents du dictionnaire y sont ajoutés comme radicaux.
+      *\       Le numéro du nouveau groupe est retourné.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire
+      *\exception logic_error si motRadical n'existe pas ou si un synonyme est répété.
+      */
+      int ajouterGroupeSynonymes(const std::string& motRadical, const std::vector<std::string>& motsSynonymes);
+
+      /**
+      * \struct Mutation
+      *
+      * \brief Une modification de radical ou de flexion, à appliquer en lot avec appliquerLot
+      */
+      struct Mutation
+      {
+         enum Type { AjoutRadical, AjoutFlexion, SuppressionFlexion, SuppressionRadical };
+
+         Type type;
+         std::string radical;
+         std::string flexion;     // Ignoré pour AjoutRadical et SuppressionRadical.
+      };
+
+      /**
+      *\brief  Appliquer un lot de mutations.
+      *
+      * Les mutations sont triées par radical (l'ordre relatif des mutations d'un même radical
+      * est conservé). Quelle que soit la taille du lot, les radicaux nouveaux sont réunis à
+      * l'arbre d'un seul coup, puis les noeuds de tous les radicaux du lot sont trouvés par un
+      * seul parcours fusionné de l'arbre plutôt que par une descente chacun.
+      *
+      *\pre    Il y a suffisament de mémoire.
+      *
+      *\post   Les mutations sont appliquées.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      *\exception logic_error dans les mêmes cas que la méthode correspondant à chaque mutation.
+      *\       Les mutations traitées avant la mutation fautive (dans l'ordre trié) restent appliquées.
+      */
+      void appliquerLot(std::vector<Mutation> mutations);
+
+      /**
+      * \struct Difference
+      *
+      * \brief Les changements qui font passer le dictionnaire au contenu d'un fichier, voir calculerDifference
+      */
+      struct Difference
+      {
+         std::vector<Mutation> mutations;         // Radicaux et flexions, pour appliquerLot.
+         std::vector< std::pair<int, std::vector<std::string> > > groupesModifies;   // Numéro et membres du groupe dans le fichier.
+         int nbGroupes = 0;                       // Nombre de groupes de synonymes du fichier.
+         std::vector<std::string> appartenancesATrier;   // Radicaux dont les numéros de groupes ne sont pas croissants.
+      };
+
+      /**
+      *\brief  Calculer les changements qui donnent au dictionnaire le contenu de fichier (format de chargerDicoSynonyme).
+      *
+      * Le fichier est lu ligne par ligne ; chaque radical est comparé au dictionnaire dès que sa ligne
+      * de flexions est lue, et seules les différences sont gardées. La méthode ne fait que lire le
+      * dictionnaire : elle peut s'exécuter dans un autre fil pendant que le dictionnaire continue de
+      * répondre aux consultations.
+      *
+      *\post   Le dictionnaire reste inchangé.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      *\exception logic_error si fichier serait refusé par chargerDicoSynonyme (radical, flexion
+      *\       ou synonyme répété, groupe dont le radical n'existe pas).
+      */
+      Difference calculerDifference(std::istream& fichier) const;
+
+      /**
+      *\brief  Appliquer une différence calculée par calculerDifference.
+      *
+      *\pre    Le dictionnaire n'a pas été modifié depuis le calcul de difference.
+      *\       Il y a suffisament de mémoire.
+      *
+      *\post   Le dictionnaire est identique à celui qu'on obtiendrait en chargeant le fichier avec
+      *\       chargerDicoSynonyme : mêmes radicaux, flexions dans le même ordre, mêmes groupes sous
+      *\       les mêmes numéros.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void appliquerDifference(const Difference& difference);
+
+      /**
+      *\brief  Recharger le dictionnaire à partir d'une nouvelle version de son fichier, en ne modifiant
+      *\       que ce qui a changé.
+      *
+      * Équivaut à appliquerDifference(calculerDifference(fichier)). Pour continuer de servir pendant la
+      * lecture du fichier, appeler calculerDifference dans un autre fil puis appliquerDifference, qui
+      * seule demande un accès exclusif et ne coûte que O(k log n) pour k changements.
+      *
+      *\pre    fichier est ouvert.
+      *
+      *\post   Voir appliquerDifference.
+      *
+      *\exception logic_error si fichier n'est pas ouvert ou dans les cas de calculerDifference ;
+      *\       le dictionnaire reste alors inchangé.
+      */
+      void rechargerIncrementiel(std::ifstream& fichier);
+
+      /**
+      *\brief  Ajouter au dictionnaire le contenu de autre (union des radicaux).
+      *
+      * Les radicaux de autre sont copiés puis insérés par scission et jonction des arbres AVL,
+      * ce qui coûte O(m log(n/m + 1)) pour m radicaux dans autre et n dans le dictionnaire.
+      * Les deux moitiés de chaque scission sont traitées en parallèle sur au plus nbFils fils
+      * d'exécution (0 : autant que de coeurs).
+      *
+      *\pre    Il y a suffisament de mémoire.
+      *
+      *\post   Un radical présent des deux côtés reçoit les flexions de autre qui lui manquent.
+      *\       Les groupes de synonymes de autre sont ajoutés à la suite de ceux du dictionnaire,
+      *\       dans le même ordre : le groupe g de autre devient le groupe nbGroupes + g.
+      *\       autre reste inchangé ; fusionner un dictionnaire avec lui-même ne fait rien.
+      *
+      *\exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void fusionner(const DicoSynonymesGenerique& autre, unsigned int nbFils = 0);
+
+      /**
+      *\brief  Ne garder que les radicaux qui sont aussi dans autre.
+      *
+      * Même algorithme et même coût que fusionner. Les flexions et les groupes des radicaux
+      * conservés sont ceux du dictionnaire ; ceux de autre sont ignorés.
+      *
+      *\post   Les radicaux absents de autre sont supprimés comme par supprimerRadical.
+      *\       autre reste inchangé.
+      */
+      void intersection(const DicoSynonymesGenerique& autre, unsigned int nbFils = 0);
+
+      /**
+      *\brief  Retirer du dictionnaire les radicaux qui sont dans autre.
+      *
+      * Même algorithme et même coût que fusionner.
+      *
+      *\post   Les radicaux présents dans autre sont supprimés comme par supprimerRadical.
+      *\       autre reste inchangé ; la différence d'un dictionnaire avec lui-même le vide.
+      */
+      void difference(const DicoSynonymesGenerique& autre, unsigned int nbFils = 0);
+
+      /**
+      *\brief  Supprimer les radicaux r tels que debut <= r < fin, en O(log n + k) pour k radicaux supprimés.
+      *
+      *\post   Les radicaux de l'intervalle sont supprimés comme par supprimerRadical.
+      *\       Rien n'est fait si fin <= debut.
+      *
+      *\return le nombre de radicaux supprimés.
+      */
+      int supprimerIntervalle(const std::string& debut, const std::string& fin);
+
       /**
       *\brief     Supprimer un radical du dictionnaire des synonymes
       *\brief     tout en s’assurant de maintenir l'équilibre de l'arbre.
@@ -146,7 +384,8 @@ namespace TP3
       *
       *\post      Le synonyme est enlevé du dictionnaire des synonymes.
       *
-      *\exception logic_error si motSynonyme ou motRadical ou numGroupe n'existent pas.
+      *\exception logic_error si motSynonyme ou motRadical ou numGroupe n'existent pas,
+      *\exception ou si motRadical ou motSynonyme n'appartient pas au groupe numGroupe.
       */
       void supprimerSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe);
 
@@ -158,6 +397,16 @@ namespace TP3
       */
       bool estVide() const;
 
+      /**
+      * \brief Vérifie si motRadical est un radical du dictionnaire
+      *
+      * Un filtre de Bloom sur les radicaux et les flexions écarte la plupart des mots absents
+      * sans descendre l'arbre.
+      *
+      * \post Le dictionnaire reste inchangé.
+      */
+      bool contientRadical(const std::string& motRadical) const;
+
       /**
       * \brief Retourne le nombre de radicaux dans le dictionnaire
       *
@@ -166,6 +415,33 @@ namespace TP3
       */
       int nombreRadicaux() const;
 
+      /**
+      * \brief Retourne le radical de rang k (0 pour le plus petit en ordre alphabétique)
+      *
+      * \post Le dictionnaire reste inchangé.
+      *
+      * \exception logic_error si k n'est pas entre 0 et nombreRadicaux() - 1.
+      */
+      std::string radicalAuRang(int k) const;
+
+      /**
+      * \brief Retourne le nombre de radicaux strictement inférieurs à motRadical, c'est-à-dire
+      *        son rang s'il est dans le dictionnaire, ou le rang qu'il aurait s'il y était ajouté.
+      *
+      * \post Le dictionnaire reste inchangé.
+      */
+      int rang(const std::string& motRadical) const;
+
+      /**
+      * \brief Retourne les radicaux de rangs debut à debut + taille - 1, en ordre alphabétique.
+      *        La page est plus courte (ou vide) si elle dépasse la fin du dictionnaire.
+      *
+      * \post Le dictionnaire reste inchangé.
+      *
+      * \exception logic_error si debut ou taille est négatif.
+      */
+      std::vector<std::string> page(int debut, int taille) const;
+
       /**
       * \brief Affiche à l'écran l'arbre niveau par niveau de façon à voir si l'arbre
       * est bien balancé.
@@ -173,7 +449,7 @@ namespace TP3
       * \post Le dictionnaire reste inchangé.
       *	Ne touchez pas s.v.p. à cette méthode !
       */
-      friend std::ostream& operator<<(std::ostream& out, const DicoSynonymes& d)
+      friend std::ostream& operator<<(std::ostream& out, const DicoSynonymesGenerique& d)
       {
     	  if (d.racine != 0)
     	  {
@@ -229,6 +505,9 @@ namespace TP3
       /**
       * \brief Retourne le radical du mot entré en paramètre
       *
+      * Les radicaux candidats sont d'abord filtrés par l'index de trigrammes, puis vérifiés :
+      * parmi ceux dont mot est une flexion, on retourne le plus semblable selon similitude.
+      *
       * \pre mot est dans la liste des flexions d'un radical
       *
       * \post Le dictionnaire reste inchangé.
@@ -236,7 +515,7 @@ namespace TP3
       *
       * \exception logic_error si l'arbre est vide
       * \exception logic_error si la flexion n'est pas dans la liste de flexions du radical
-      *
+      * Cette méthode appelle trouverRadical !
       */
       std::string rechercherRadical(const std::string& mot) const;
 
@@ -259,6 +538,7 @@ namespace TP3
       * \post Le nombre de cellules de appSynonymes pour le radical entré en paramètre est retourné
       * \post Le dictionnaire reste inchangé.
       *
+      * \exception logic_error si radical n'existe pas.
       */
       int getNombreSens(std::string radical) const;
 
@@ -270,6 +550,7 @@ namespace TP3
       * \post un string correspondant au premier synonyme est imprimé
       * \post Le dictionnaire reste inchangé.
       *
+      * \exception logic_error si radical n'existe pas ou si position n'est pas un sens du radical.
       */
       std::string getSens(std::string radical, int position) const;
 
@@ -281,6 +562,7 @@ namespace TP3
       * \post un vecteur est retourné avec tous les synonymes
       * \post Le dictionnaire reste inchangé.
       *
+      * \exception logic_error si radical n'existe pas ou si position n'est pas un sens du radical.
       */
       std::vector<std::string> getSynonymes(std::string radical, int position) const;
 
@@ -291,13 +573,238 @@ namespace TP3
       * \post un vecteur est retourné avec toutes les flexions
       * \post Le dictionnaire reste inchangé.
       *
+      * \exception logic_error si radical n'existe pas.
       */
       std::vector<std::string> getFlexions(std::string radical) const;
 
+      /**
+      * \brief Version sans exception de rechercherRadical
+      *
+      * Un mot écarté par le filtre de Bloom des radicaux et des flexions ne passe ni par le
+      * cache ni par l'index de trigrammes.
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le radical dont mot est une flexion, ou rien si le dictionnaire est vide
+      *         ou si mot n'est dans aucune liste de flexions.
+      */
+      std::optional<std::string> trouverRadical(const std::string& mot) const;
+
+      /**
+      * \brief Version sans exception de getNombreSens
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le nombre de sens du radical, ou rien si radical n'existe pas.
+      */
+      std::optional<int> trouverNombreSens(const std::string& radical) const;
+
+      /**
+      * \brief Version sans exception de getSens
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le premier synonyme du sens position, ou rien si radical n'existe pas,
+      *         si position n'est pas un de ses sens ou si le groupe ne contient aucun autre mot.
+      */
+      std::optional<std::string> trouverSens(const std::string& radical, int position) const;
+
+      /**
+      * \brief Version sans exception de getSynonymes
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return les synonymes du sens position, ou rien si radical n'existe pas
+      *         ou si position n'est pas un de ses sens.
+      */
+      std::optional< std::vector<std::string> > trouverSynonymes(const std::string& radical, int position) const;
+
+      /**
+      * \brief Version sans exception de getFlexions
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return les flexions du radical, ou rien si radical n'existe pas.
+      */
+      std::optional< std::vector<std::string> > trouverFlexions(const std::string& radical) const;
+
+      /**
+      * \brief Donne tous les radicaux atteignables depuis radical en au plus k sauts de synonymie.
+      *        Un saut va d'un radical aux autres membres de chacun de ses groupes de synonymes.
+      *
+      * \post un vecteur trié est retourné, sans le radical lui-même
+      * \post Le dictionnaire reste inchangé.
+      *
+      * \exception logic_error si radical n'existe pas.
+      */
+      std::vector<std::string> synonymesTransitifs(const std::string& radical, int k) const;
+
+      /**
+      * \brief Version en lot de synonymesTransitifs, répartie sur nbFils fils d'exécution
+      *        (0 : autant que de coeurs).
+      *
+      * \post Le résultat i correspond à radicaux[i] ; il est vide si radicaux[i] n'existe pas.
+      * \post Le dictionnaire reste inchangé.
+      */
+      std::vector< std::vector<std::string> > synonymesTransitifs(const std::vector<std::string>& radicaux, int k,
+                                                                  unsigned int nbFils = 0) const;
+
+      /**
+      * \brief Active ou désactive la représentation compressée des flexions.
+      *
+      * En mode compressé, chaque flexion est conservée sous la forme (longueur du préfixe
+      * partagé avec le radical, identifiant de terminaison) dans une table de suffixes
+      * commune à tout le dictionnaire, et n'est reconstruite qu'au besoin.
+      *
+      * \post Toutes les flexions existantes sont converties dans la représentation demandée.
+      * \post Le contenu logique du dictionnaire reste inchangé.
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void compresserFlexions(bool activer);
+
+      /**
+      * \brief Indique si les flexions sont conservées sous forme compressée
+      *
+      * \post Le dictionnaire reste inchangé.
+      */
+      bool flexionsSontCompressees() const;
+
+      /**
+      * \brief Active le cache des résultats de rechercherRadical, ou le désactive si capacite vaut 0.
+      *
+      * Le cache conserve aussi les résultats négatifs. Il est invalidé mot par mot par
+      * ajouterFlexion, supprimerFlexion et supprimerRadical.
+      *
+      * \pre Aucune recherche n'est en cours dans un autre fil d'exécution.
+      *
+      * \post Le cache est vide et peut contenir au plus capacite mots.
+      */
+      void activerCache(std::size_t capacite);
+
+      /**
+      * \brief Devine le radical d'un mot qui n'est dans aucune liste de flexions, d'après les
+      *        terminaisons des flexions connues (voir RaciniseurSuffixes).
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le premier candidat qui est un radical du dictionnaire, ou rien.
+      */
+      std::optional<std::string> devinerRadical(const std::string& mot) const;
+
+      /**
+      * \brief Si activer est vrai, trouverRadical et rechercherRadical se rabattent sur
+      *        devinerRadical quand mot n'est dans aucune liste de flexions.
+      */
+      void activerRaciniseur(bool activer);
+
+      /**
+      * \brief Recherche approximative : compare mot à tous les radicaux et à toutes les flexions
+      *        et retourne le radical du mot le plus proche (distance de Levenshtein).
+      *
+      * \post Le dictionnaire reste inchangé.
+      * \return le radical trouvé, ou rien si aucun mot n'est à une distance d'au plus distanceMax.
+      *         À distance égale, le radical qui vient en premier en ordre alphabétique est retourné.
+      */
+      std::optional<std::string> radicalLePlusProche(const std::string& mot, unsigned int distanceMax) const;
+
+      /**
+      * \struct StatistiquesMemoire
+      *
+      * \brief Octets occupés par chaque composante du dictionnaire (voir Memoire.h)
+      */
+      struct StatistiquesMemoire
+      {
+         std::size_t noeuds;            // Les noeuds de l'arbre eux-mêmes.
+         std::size_t radicaux;          // Le texte des radicaux trop longs pour tenir dans les noeuds.
+         std::size_t flexions;          // Les tampons de flexions et les flexions compressées.
+         std::size_t appartenances;     // Les tableaux appSynonymes.
+         std::size_t groupes;           // Le tableau groupesSynonymes et ses listes.
+         std::size_t tableSuffixes;
+         std::size_t indexTrigrammes;
+         std::size_t cache;
+         std::size_t filtre;
+         std::size_t graphe;
+         std::size_t raciniseur;
+         std::size_t balayage;          // La copie par longueur de radicalLePlusProche.
+
+         std::size_t total() const
+         {
+            return noeuds + radicaux + flexions + appartenances + groupes + tableSuffixes
+                   + indexTrigrammes + cache + filtre + graphe + raciniseur + balayage;
+         }
+      };
 
+      /**
+      * \brief Mesure la mémoire occupée par chaque composante du dictionnaire
+      *
+      * \pre Aucune modification n'est en cours dans un autre fil d'exécution.
+      *
+      * \post Le dictionnaire reste inchangé.
+      */
+      StatistiquesMemoire statistiquesMemoire() const;
+
+      /**
+      * \brief Réduit la mémoire occupée par le dictionnaire.
+      *
+      * Les capacités inutilisées sont libérées, la table des suffixes est refaite avec les seules
+      * terminaisons encore utilisées, l'index de trigrammes est reconstruit sans ses entrées
+      * retirées et les vues reconstruites au besoin (graphe, raciniseur, copie par longueur)
+      * sont libérées.
+      *
+      * \post Le contenu logique du dictionnaire reste inchangé, sauf que les groupes de synonymes
+      *       vides sont retirés : les groupes suivants sont renumérotés.
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void compacter();
+
+      /**
+      * \brief Fusionne les groupes de synonymes qui se recouvrent.
+      *
+      * Deux groupes se recouvrent si leurs membres communs représentent au moins la fraction
+      * seuil du plus petit des deux : avec 1, un groupe n'est fusionné qu'avec un groupe qui le
+      * contient. Les fusions (union-find, voir EnsemblesDisjoints) sont transitives et répétées
+      * jusqu'à ce qu'aucun groupe n'en recouvre un autre. Le groupe fusionné prend le plus petit
+      * numéro de ses groupes ; ses membres sont ceux de ses groupes dans l'ordre des numéros, sans
+      * doublon.
+      *
+      * \post Les groupes fusionnés dans un autre et les groupes vides sont retirés : les groupes
+      *       restants sont renumérotés, comme par compacter. Dans appSynonymes, chaque numéro est
+      *       remplacé par celui du groupe fusionné, à la position de sa première occurrence.
+      * \return le nombre de groupes retirés.
+      *
+      * \exception logic_error si seuil n'est pas dans ]0, 1].
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      int consoliderGroupes(float seuil);
+
+      /**
+      * \brief Consolidation en ligne : si seuil est dans ]0, 1], chaque groupe créé ou agrandi
+      *        par ajouterSynonyme ou ajouterGroupeSynonymes est aussitôt fusionné dans le plus
+      *        ancien des groupes qui le recouvrent (voir consoliderGroupes). 0 la désactive.
+      *
+      * Aucun groupe n'est renuméroté : un groupe absorbé reste vide, sauf s'il est le dernier,
+      * et le numéro retourné par ajouterSynonyme ou ajouterGroupeSynonymes est celui du groupe
+      * qui a tout reçu. appliquerDifference ne consolide pas.
+      *
+      * \exception logic_error si seuil n'est pas dans [0, 1].
+      */
+      void consoliderEnLigne(float seuil);
+
+      /**
+      * \brief Enregistre dorénavant les appels publics dans trace (voir TraceDico et RejeuTrace),
+      *        ou arrête de les enregistrer si trace est nul.
+      *
+      * Sont enregistrés les ajouts et les suppressions, appliquerLot, les recherches et les
+      * changements de configuration (compresserFlexions, activerCache, activerRaciniseur, compacter,
+      * consoliderGroupes, consoliderEnLigne), avec les arguments tels que reçus. Les appels faits par
+      * chargerDicoSynonyme le sont un à un. Les opérations entre dictionnaires, les rechargements
+      * et les déplacements ne sont pas enregistrés ; une copie faite par cloner enregistre dans la
+      * même trace.
+      *
+      * \pre trace reste valide tant qu'il est utilisé ; aucun appel n'est en cours dans un autre fil.
+      */
+      void enregistrerTrace(TraceDico* trace);
 
    private:
 
+      friend class ImageDico;
+
       /**
       * \class NoeudDicoSynonymes
       *
@@ -308,19 +815,45 @@ namespace TP3
       {
       public:
          std::string radical;             		// Un radical qui est un élément fondamental d'un mot, auquel s'ajoutent suffixes et préfixes.
-         std::list<std::string> flexions;   	// Une liste chaînée de chaîne de caractères représentant les flexions du radical.
+         typename Traits::ConteneurFlexions flexions;	// Les flexions du radical (ListeFlexions par défaut), ou leurs codes (voir TableSuffixes) si la compression est active.
          std::vector<int> appSynonymes;   		// Un tableau contenant les indices (entiers) des groupes de synonymes auquel appartient le radical.
          int hauteur;                    		// La hauteur de ce noeud (afin de maintenir l'équilibre de l'arbre AVL).
+         int taille;                     		// Le nombre de noeuds du sous-arbre (afin de trouver un radical par son rang).
          NoeudDicoSynonymes *gauche, *droit;	// Les pointeurs sur les enfants du noeud.
-         NoeudDicoSynonymes(const std::string& m) : radical(m), hauteur(0), gauche(0), droit(0) { }
+         NoeudDicoSynonymes(const std::string& m) : radical(m), hauteur(0), taille(1), gauche(0), droit(0) { }
       };
 
+      typedef typename std::allocator_traits<typename Traits::Allocateur>::template rebind_alloc<NoeudDicoSynonymes> AllocateurNoeuds;
+      typedef std::allocator_traits<AllocateurNoeuds> TraitsAllocateurNoeuds;
+
+      // Vrai si Traits::normaliser fait une copie, faux si c'est l'identité (aucun coût).
+      static constexpr bool NORMALISE = !std::is_reference<decltype(Traits::normaliser(std::string()))>::value;
 
 
+
+      AllocateurNoeuds allocateurNoeuds;                    // Alloue les noeuds de l'arbre (voir creerNoeud).
       NoeudDicoSynonymes *racine;                           // pointeur vers la racine de l'arbre des radicaux.
       int nbRadicaux;                                       // Nombre de noeuds dans l'arbre
       std::vector< std::list<NoeudDicoSynonymes*> > groupesSynonymes;   // Tableau de groupes de synonymes dont chaque élément est une liste
       	  	  	  	  	  	  	  	  	  	  	  	  	  	  	  	  	// de pointeurs sur des noeuds de l'arbre représentant les radicaux.
+      TableSuffixes suffixes;                               // Table des terminaisons partagées par les flexions compressées.
+      bool compressionFlexions;                             // Vrai si les flexions des noeuds sont remplacées par leurs codes.
+      IndexTrigrammes indexTrigrammes;                      // Index des trigrammes des radicaux et des flexions.
+      mutable CacheRadicaux cacheRadicaux;                  // Cache mot -> radical de rechercherRadical (désactivé par défaut).
+      FiltreBloom filtreMots;                               // Radicaux et flexions, consulté avant de descendre l'arbre.
+      mutable GrapheSynonymes grapheSynonymes;              // Vue CSR des groupes, reconstruite au besoin.
+      mutable bool grapheSynonymesAJour;                    // Faux si un radical ou un groupe a changé depuis la construction.
+      mutable std::mutex verrouGraphe;                      // Protège la reconstruction de grapheSynonymes.
+      mutable RaciniseurSuffixes raciniseurSuffixes;        // Règles de terminaisons apprises des flexions, reconstruites au besoin.
+      mutable bool raciniseurAJour;                         // Faux si une flexion a changé depuis l'apprentissage.
+      mutable std::mutex verrouRaciniseur;                  // Protège l'apprentissage de raciniseurSuffixes.
+      bool raciniseurActif;                                 // Vrai si trouverRadical se rabat sur devinerRadical.
+      float seuilConsolidation;                             // Seuil de consoliderEnLigne, 0 si désactivée.
+      TraceDico* trace;                                     // Reçoit les appels publics, 0 si désactivé.
+      mutable RadicauxParLongueur motsParLongueur;          // Radicaux et flexions groupés par longueur pour les balayages approximatifs.
+      mutable std::vector<std::string> radicauxBalayes;     // Radical de chaque propriétaire de motsParLongueur.
+      mutable bool motsParLongueurAJour;                    // Faux si un radical ou une flexion a changé depuis la copie.
+      mutable std::mutex verrouMotsParLongueur;             // Protège la reconstruction de motsParLongueur.
 
       // Ajoutez vos méthodes privées ici !
 
@@ -329,6 +862,7 @@ namespace TP3
        void auxSupprimerRadical(const std::string& motRadical, NoeudDicoSynonymes *&root);
        void auxSupprimerFlexion(const std::string& motRadical, const std::string& motFlexion, NoeudDicoSynonymes *&root);
        int hauteur(NoeudDicoSynonymes *root) const;
+       int tailleSousArbre(NoeudDicoSynonymes *root) const;
        bool radicalDansDico(const std::string& motRadical) const;
        bool auxradicalDansDico(const std::string &motRadical, NoeudDicoSynonymes *root) const;
        void equilibrer(NoeudDicoSynonymes *&racine);
@@ -341,13 +875,59 @@ namespace TP3
        bool sousArbrePencheADroite(NoeudDicoSynonymes *noeud) const;
        bool sousArbrePencheAGauche(NoeudDicoSynonymes *noeud) const;
        void enleverSuccMinDroit(NoeudDicoSynonymes *noeud);
-       int auxGetNombreSens(const std::string& motRadical, NoeudDicoSynonymes *root) const;
-       std::vector<std::string> auxGetFlexions(const std::string& motRadical, NoeudDicoSynonymes *root) const;
        std::vector<NoeudDicoSynonymes*> parcoursPreOrdre() const;
        void auxParcoursPreOrdre(NoeudDicoSynonymes* sousArbre, std::vector<NoeudDicoSynonymes*>& accumulateur) const;
-       float distanceLevenstein(const std::string& mot1, const std::string& mot2) const;
+       static float distanceLevenstein(std::string_view mot1, std::string_view mot2);
+       bool flexionPresente(const NoeudDicoSynonymes *noeud, const std::string& motFlexion) const;
+       bool insererFlexion(NoeudDicoSynonymes *noeud, const std::string& motFlexion);
+       bool retirerFlexion(NoeudDicoSynonymes *noeud, const std::string& motFlexion);
+       std::vector<std::string> flexionsDe(const NoeudDicoSynonymes *noeud) const;
+       NoeudDicoSynonymes* trouverNoeud(const std::string& motRadical) const;
+       std::optional<std::string> auxRechercherRadical(const std::string& mot) const;
+       void reconstruireIndexTrigrammes();
+       void reconstruireFiltre();
+       void viderApresDeplacement() noexcept;
+       std::size_t nombreFlexions(const NoeudDicoSynonymes *noeud) const;
+       void auxParcoursEnOrdre(NoeudDicoSynonymes* sousArbre, std::vector<NoeudDicoSynonymes*>& accumulateur) const;
+       NoeudDicoSynonymes* construireEquilibre(const std::vector<NoeudDicoSynonymes*>& noeuds, int debut, int fin);
+       std::vector<NoeudDicoSynonymes*> fusionnerRadicaux(const std::vector<std::string>& motsRadicaux);
+       void auxLocaliser(NoeudDicoSynonymes* sousArbre, const std::vector<std::string>& motsRadicaux,
+                         std::size_t debut, std::size_t fin, std::vector<NoeudDicoSynonymes*>& noeuds) const;
+       void differenceFlexions(const std::string& motRadical, const std::vector<std::string>& motsFlexions,
+                               std::vector<Mutation>& mutations) const;
+       const GrapheSynonymes& graphe() const;
+       const RaciniseurSuffixes& raciniseur() const;
+       const RadicauxParLongueur& balayage() const;
+       void detacherDesGroupes(NoeudDicoSynonymes *noeud);
+       void remplacerDansGroupes(NoeudDicoSynonymes *ancien, NoeudDicoSynonymes *nouveau);
+       NoeudDicoSynonymes* joindre(NoeudDicoSynonymes *gauche, NoeudDicoSynonymes *milieu, NoeudDicoSynonymes *droit);
+       NoeudDicoSynonymes* concatener(NoeudDicoSynonymes *gauche, NoeudDicoSynonymes *droit);
+       NoeudDicoSynonymes* detacherMinimum(NoeudDicoSynonymes *&sousArbre);
+       void scinder(NoeudDicoSynonymes *sousArbre, const std::string& cle, NoeudDicoSynonymes *&inferieurs,
+                    NoeudDicoSynonymes *&egal, NoeudDicoSynonymes *&superieurs);
+       NoeudDicoSynonymes* copierSousArbre(const DicoSynonymesGenerique& autre, const NoeudDicoSynonymes *sousArbre);
+       NoeudDicoSynonymes* auxFusionner(NoeudDicoSynonymes *sousArbre, NoeudDicoSynonymes *copie, int profondeurParallele);
+       NoeudDicoSynonymes* auxIntersection(NoeudDicoSynonymes *sousArbre, const NoeudDicoSynonymes *autre,
+                                           int profondeurParallele, std::vector<NoeudDicoSynonymes*>& retires);
+       NoeudDicoSynonymes* auxDifference(NoeudDicoSynonymes *sousArbre, const NoeudDicoSynonymes *autre,
+                                         int profondeurParallele, std::vector<NoeudDicoSynonymes*>& retires);
+       void detruireRetires(const std::vector<NoeudDicoSynonymes*>& retires);
+       void auxDetruire(NoeudDicoSynonymes *sousArbre);
+       NoeudDicoSynonymes* creerNoeud(const std::string& motRadical);
+       void detruireNoeud(NoeudDicoSynonymes *noeud);
+       std::vector<int> groupesRecouvrants(int numGroupe, float seuil) const;
+       int consoliderGroupe(int numGroupe);
+       static const std::vector<std::string>& normaliserTous(const std::vector<std::string>& mots,
+                                                             std::vector<std::string>& copie);
    };
 
+   typedef DicoSynonymesGenerique<TraitsDico> DicoSynonymes;
+
+   // Instanciées dans DicoSynonymes.cpp.
+   extern template class DicoSynonymesGenerique<TraitsDico>;
+   extern template class DicoSynonymesGenerique<TraitsSansCasseNiAccents>;
+   extern template class DicoSynonymesGenerique<TraitsFlexionsSeparees>;
+
 }//Fin du namespace
 
 #endif
\ No newline at end of file
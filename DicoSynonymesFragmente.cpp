@@ -0,0 +1,297 @@
+/**
+* \file DicoSynonymesFragmente.cpp
+* \brief Le code des opérateurs de DicoSynonymesFragmente.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+* Ordre de prise des verrous : fragments en ordre croissant d'adresse, puis verrouGroupes.
+*
+*/
+
+#include "DicoSynonymesFragmente.h"
+
+namespace TP3
+{
+
+    /**
+    * \brief Constructeur
+    *
+    * \post Un dictionnaire vide de nbFragments fragments (au moins 1) est créé.
+    */
+    DicoSynonymesFragmente::DicoSynonymesFragmente(std::size_t nbFragments)
+    {
+        if (nbFragments == 0) nbFragments = 1;
+        for (std::size_t i = 0; i < nbFragments; ++i)
+            fragments.emplace_back(new Fragment());
+    }
+
+    /**
+    * \brief Charge un dictionnaire au format de DicoSynonymes::chargerDicoSynonyme
+    *
+    * \exception logic_error si fichier n'est pas ouvert
+    */
+    void DicoSynonymesFragmente::chargerDicoSynonyme(std::ifstream& fichier)
+    {
+        if (!fichier.is_open())
+            throw std::logic_error("DicoSynonymesFragmente::chargerDicoSynonyme: Le fichier n'est pas ouvert !");
+
+        std::string ligne;
+        std::string buffer;
+        std::string radical;
+        int cat = 1;
+
+        while (std::getline(fichier, ligne))
+        {
+            if (ligne == "$")
+            {
+                cat = 3;
+                continue;
+            }
+            if (cat == 1)
+            {
+                radical = ligne;
+                ajouterRadical(radical);
+                cat = 2;
+            }
+            else if (cat == 2)
+            {
+                std::stringstream ss(ligne);
+                while (ss >> buffer)
+                    ajouterFlexion(radical, buffer);
+                cat = 1;
+            }
+            else
+            {
+                std::stringstream ss(ligne);
+                ss >> radical;
+                int position = -1;
+                while (ss >> buffer)
+                    ajouterSynonyme(radical, buffer, position);
+            }
+        }
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::ajouterRadical
+    */
+    void DicoSynonymesFragmente::ajouterRadical(const std::string& motRadical)
+    {
+        Fragment& fragment = fragmentDe(motRadical);
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dico.ajouterRadical(motRadical);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::ajouterFlexion
+    */
+    void DicoSynonymesFragmente::ajouterFlexion(const std::string& motRadical, const std::string& motFlexion)
+    {
+        Fragment& fragment = fragmentDe(motRadical);
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dico.ajouterFlexion(motRadical, motFlexion);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::supprimerFlexion
+    */
+    void DicoSynonymesFragmente::supprimerFlexion(const std::string& motRadical, const std::string& motFlexion)
+    {
+        Fragment& fragment = fragmentDe(motRadical);
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dico.supprimerFlexion(motRadical, motFlexion);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::supprimerRadical. Le radical est aussi retiré de tous ses groupes.
+    */
+    void DicoSynonymesFragmente::supprimerRadical(const std::string& motRadical)
+    {
+        Fragment& fragment = fragmentDe(motRadical);
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dico.supprimerRadical(motRadical);
+
+        std::unique_lock<std::shared_mutex> verrouG(verrouGroupes);
+        auto it = appSynonymes.find(motRadical);
+        if (it == appSynonymes.end()) return;
+        for (auto numGroupe : it->second)
+        {
+            std::vector<std::string>& groupe = groupesSynonymes[numGroupe];
+            groupe.erase(std::remove(groupe.begin(), groupe.end(), motRadical), groupe.end());
+        }
+        appSynonymes.erase(it);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::ajouterSynonyme
+    */
+    void DicoSynonymesFragmente::ajouterSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe)
+    {
+        if (!contientRadical(motRadical))
+            throw std::logic_error("ajouterSynonyme : Le radical n'est pas dans le dictionnaire");
+
+        Fragment& fragmentSynonyme = fragmentDe(motSynonyme);
+        {
+            std::unique_lock<std::shared_mutex> verrou(fragmentSynonyme.verrou);
+            if (!fragmentSynonyme.dico.contientRadical(motSynonyme))
+                fragmentSynonyme.dico.ajouterRadical(motSynonyme);
+        }
+
+        // les deux radicaux ne doivent pas disparaître pendant qu'on modifie les groupes
+        Fragment* premier = &fragmentDe(motRadical);
+        Fragment* second = &fragmentSynonyme;
+        if (std::less<Fragment*>()(second, premier)) std::swap(premier, second);
+        std::shared_lock<std::shared_mutex> verrou1(premier->verrou);
+        std::shared_lock<std::shared_mutex> verrou2;
+        if (second != premier) verrou2 = std::shared_lock<std::shared_mutex>(second->verrou);
+
+        if (!premier->dico.contientRadical(premier == &fragmentSynonyme ? motSynonyme : motRadical)
+            || !second->dico.contientRadical(second == &fragmentSynonyme ? motSynonyme : motRadical))
+            throw std::logic_error("ajouterSynonyme : Le radical a été supprimé pendant l'ajout");
+
+        std::unique_lock<std::shared_mutex> verrouG(verrouGroupes);
+        if (numGroupe != -1 && (numGroupe < 0 || numGroupe >= static_cast<int>(groupesSynonymes.size())))
+            throw std::logic_error("ajouterSynonyme : Le numéro de groupe est invalide");
+
+        if (numGroupe == -1)
+        {
+            groupesSynonymes.push_back(std::vector<std::string> {motRadical, motSynonyme});
+            numGroupe = groupesSynonymes.size() - 1;
+        }
+        else
+        {
+            std::vector<std::string>& groupe = groupesSynonymes[numGroupe];
+            if (std::find(groupe.begin(), groupe.end(), motSynonyme) != groupe.end())
+                throw std::logic_error("ajouterSynonyme : Le synonyme est déjà présent dans le groupe");
+            if (std::find(groupe.begin(), groupe.end(), motRadical) == groupe.end())
+                groupe.push_back(motRadical);
+            groupe.push_back(motSynonyme);
+        }
+
+        std::vector<int>& appRadical = appSynonymes[motRadical];
+        if (std::find(appRadical.begin(), appRadical.end(), numGroupe) == appRadical.end())
+            appRadical.push_back(numGroupe);
+        appSynonymes[motSynonyme].push_back(numGroupe);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::supprimerSynonyme
+    */
+    void DicoSynonymesFragmente::supprimerSynonyme(const std::string& motRadical, const std::string& motSynonyme, int numGroupe)
+    {
+        std::unique_lock<std::shared_mutex> verrouG(verrouGroupes);
+        if (numGroupe < 0 || numGroupe >= static_cast<int>(groupesSynonymes.size()))
+            throw std::logic_error("supprimerSynonyme : Le numéro de groupe est invalide");
+
+        std::vector<std::string>& groupe = groupesSynonymes[numGroupe];
+        if (std::find(groupe.begin(), groupe.end(), motRadical) == groupe.end())
+            throw std::logic_error("supprimerSynonyme : Le radical n'appartient pas au groupe de synonymes");
+        auto it = std::find(groupe.begin(), groupe.end(), motSynonyme);
+        if (it == groupe.end())
+            throw std::logic_error("supprimerSynonyme : Le synonyme n'appartient pas au groupe de synonymes");
+        groupe.erase(it);
+
+        std::vector<int>& appSynonyme = appSynonymes[motSynonyme];
+        appSynonyme.erase(std::find(appSynonyme.begin(), appSynonyme.end(), numGroupe));
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverRadical. Tous les fragments sont consultés ; si plusieurs
+    *        radicaux ont mot comme flexion, le plus semblable est retourné.
+    */
+    std::optional<std::string> DicoSynonymesFragmente::trouverRadical(const std::string& mot) const
+    {
+        std::optional<std::string> meilleur;
+        float similitudeMax = -1;
+        for (auto &fragment : fragments)
+        {
+            std::shared_lock<std::shared_mutex> verrou(fragment->verrou);
+            std::optional<std::string> radical = fragment->dico.trouverRadical(mot);
+            if (!radical) continue;
+
+            float degre = fragment->dico.similitude(*radical, mot);
+            if (degre > similitudeMax)
+            {
+                similitudeMax = degre;
+                meilleur = radical;
+            }
+        }
+        return meilleur;
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverFlexions
+    */
+    std::optional< std::vector<std::string> > DicoSynonymesFragmente::trouverFlexions(const std::string& motRadical) const
+    {
+        Fragment& fragment = fragmentDe(motRadical);
+        std::shared_lock<std::shared_mutex> verrou(fragment.verrou);
+        return fragment.dico.trouverFlexions(motRadical);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverNombreSens
+    */
+    std::optional<int> DicoSynonymesFragmente::trouverNombreSens(const std::string& motRadical) const
+    {
+        if (!contientRadical(motRadical)) return std::nullopt;
+
+        std::shared_lock<std::shared_mutex> verrouG(verrouGroupes);
+        auto it = appSynonymes.find(motRadical);
+        return it == appSynonymes.end() ? 0 : static_cast<int>(it->second.size());
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverSynonymes
+    */
+    std::optional< std::vector<std::string> > DicoSynonymesFragmente::trouverSynonymes(const std::string& motRadical, int position) const
+    {
+        if (!contientRadical(motRadical)) return std::nullopt;
+
+        std::shared_lock<std::shared_mutex> verrouG(verrouGroupes);
+        auto it = appSynonymes.find(motRadical);
+        if (it == appSynonymes.end() || position < 0 || position >= static_cast<int>(it->second.size()))
+            return std::nullopt;
+
+        std::vector<std::string> synonymes;
+        for (auto &membre : groupesSynonymes[it->second[position]])
+            if (membre != motRadical) synonymes.push_back(membre);
+        return synonymes;
+    }
+
+    /**
+    * \brief Vérifie si motRadical est dans le dictionnaire
+    */
+    bool DicoSynonymesFragmente::contientRadical(const std::string& motRadical) const
+    {
+        Fragment& fragment = fragmentDe(motRadical);
+        std::shared_lock<std::shared_mutex> verrou(fragment.verrou);
+        return fragment.dico.contientRadical(motRadical);
+    }
+
+    /**
+    * \brief Nombre total de radicaux, tous fragments confondus
+    */
+    int DicoSynonymesFragmente::nombreRadicaux() const
+    {
+        int total = 0;
+        for (auto &fragment : fragments)
+        {
+            std::shared_lock<std::shared_mutex> verrou(fragment->verrou);
+            total += fragment->dico.nombreRadicaux();
+        }
+        return total;
+    }
+
+    /**
+    * \fn Fragment& fragmentDe(const std::string& motRadical) const
+    * \brief Retourne le fragment responsable de motRadical
+    */
+    DicoSynonymesFragmente::Fragment& DicoSynonymesFragmente::fragmentDe(const std::string& motRadical) const
+    {
+        return *fragments[std::hash<std::string>()(motRadical) % fragments.size()];
+    }
+
+}//Fin du namespace
@@ -0,0 +1,144 @@
+/**
+* \file DicoSynonymesFragmente.h
+* \brief Interface du type DicoSynonymesFragmente
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <functional>
+
+#include "DicoSynonymes.h"
+
+#ifndef _DICOSYNONYMESFRAGMENTE__H
+#define _DICOSYNONYMESFRAGMENTE__H
+
+namespace TP3
+{
+
+   /**
+   * \class DicoSynonymesFragmente
+   *
+   * \brief Dictionnaire des synonymes réparti en fragments indépendants pour les écritures concurrentes.
+   *
+   * Chaque radical appartient au fragment donné par le hachage de son texte ; chaque fragment
+   * est un DicoSynonymes (arbre AVL) protégé par son propre verrou lecteurs/écrivain.
+   * Les groupes de synonymes traversent les fragments : ils sont conservés à part, dans une
+   * table protégée par son propre verrou, et désignent les radicaux par leur texte.
+   * Ordre de prise des verrous : les fragments, en ordre croissant d'adresse, puis celui des
+   * groupes. Un écrivain peut donc prendre le verrou des groupes en tenant des verrous de
+   * fragment, mais aucun verrou de fragment n'est jamais pris en tenant celui des groupes.
+   *
+   * Toutes les méthodes peuvent être appelées simultanément depuis plusieurs fils d'exécution.
+   *
+   */
+   class DicoSynonymesFragmente
+   {
+   public:
+
+      /**
+      * \brief Constructeur
+      *
+      * \post Un dictionnaire vide de nbFragments fragments (au moins 1) est créé.
+      */
+      explicit DicoSynonymesFragmente(std::size_t nbFragments = 16);
+
+      /**
+      * \brief Charge un dictionnaire au format de DicoSynonymes::chargerDicoSynonyme
+      *
+      * \exception logic_error si fichier n'est pas ouvert
+      */
+      void chargerDicoSynonyme(std::ifstream& fichier);
+
+      /**
+      * \brief Voir DicoSynonymes::ajouterRadical
+      */
+      void ajouterRadical(const std::string& motRadical);
+
+      /**
+      * \brief Voir DicoSynonymes::ajouterFlexion
+      */
+      void ajouterFlexion(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Voir DicoSynonymes::supprimerFlexion
+      */
+      void supprimerFlexion(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Voir DicoSynonymes::supprimerRadical. Le radical est aussi retiré de tous ses groupes.
+      */
+      void supprimerRadical(const std::string& motRadical);
+
+      /**
+      * \brief Voir DicoSynonymes::ajouterSynonyme
+      */
+      void ajouterSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe);
+
+      /**
+      * \brief Voir DicoSynonymes::supprimerSynonyme
+      */
+      void supprimerSynonyme(const std::string& motRadical, const std::string& motSynonyme, int numGroupe);
+
+      /**
+      * \brief Voir DicoSynonymes::trouverRadical. Tous les fragments sont consultés ; si plusieurs
+      *        radicaux ont mot comme flexion, le plus semblable est retourné.
+      */
+      std::optional<std::string> trouverRadical(const std::string& mot) const;
+
+      /**
+      * \brief Voir DicoSynonymes::trouverFlexions
+      */
+      std::optional< std::vector<std::string> > trouverFlexions(const std::string& motRadical) const;
+
+      /**
+      * \brief Voir DicoSynonymes::trouverNombreSens
+      */
+      std::optional<int> trouverNombreSens(const std::string& motRadical) const;
+
+      /**
+      * \brief Voir DicoSynonymes::trouverSynonymes
+      */
+      std::optional< std::vector<std::string> > trouverSynonymes(const std::string& motRadical, int position) const;
+
+      /**
+      * \brief Vérifie si motRadical est dans le dictionnaire
+      */
+      bool contientRadical(const std::string& motRadical) const;
+
+      /**
+      * \brief Nombre total de radicaux, tous fragments confondus
+      */
+      int nombreRadicaux() const;
+
+      std::size_t nombreFragments() const { return fragments.size(); }
+
+   private:
+
+      struct Fragment
+      {
+         mutable std::shared_mutex verrou;
+         DicoSynonymes dico;
+      };
+
+      Fragment& fragmentDe(const std::string& motRadical) const;
+
+      std::vector< std::unique_ptr<Fragment> > fragments;
+
+      mutable std::shared_mutex verrouGroupes;                            // Protège les deux tables suivantes.
+      std::vector< std::vector<std::string> > groupesSynonymes;           // Groupe -> radicaux membres.
+      std::unordered_map< std::string, std::vector<int> > appSynonymes;  // Radical -> groupes auxquels il appartient.
+   };
+
+}//Fin du namespace
+
+#endif
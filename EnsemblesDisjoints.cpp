@@ -0,0 +1,61 @@
+/**
+* \file EnsemblesDisjoints.cpp
+* \brief Le code des opérateurs de EnsemblesDisjoints.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "EnsemblesDisjoints.h"
+
+#include <numeric>
+#include <utility>
+
+namespace TP3
+{
+
+    /**
+    * \brief Construit n ensembles d'un seul élément
+    */
+    EnsemblesDisjoints::EnsemblesDisjoints(std::size_t n) : parents(n), tailles(n, 1), nbEnsembles(n)
+    {
+        std::iota(parents.begin(), parents.end(), 0);
+    }
+
+    /**
+    * \brief Retourne le représentant de l'ensemble de x
+    *
+    * \post Chaque élément visité pointe vers son grand-parent (division des chemins).
+    */
+    std::size_t EnsemblesDisjoints::trouver(std::size_t x)
+    {
+        while (parents[x] != x)
+        {
+            parents[x] = parents[parents[x]];
+            x = parents[x];
+        }
+        return x;
+    }
+
+    /**
+    * \brief Réunit les ensembles de a et de b ; le plus petit est rattaché au plus grand
+    *
+    * \return vrai si a et b étaient dans deux ensembles différents.
+    */
+    bool EnsemblesDisjoints::unir(std::size_t a, std::size_t b)
+    {
+        a = trouver(a);
+        b = trouver(b);
+        if (a == b) return false;
+
+        if (tailles[a] < tailles[b]) std::swap(a, b);
+        parents[b] = a;
+        tailles[a] += tailles[b];
+        --nbEnsembles;
+        return true;
+    }
+
+}//Fin du namespace
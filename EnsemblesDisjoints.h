@@ -0,0 +1,66 @@
+/**
+* \file EnsemblesDisjoints.h
+* \brief Interface du type EnsemblesDisjoints
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <vector>
+#include <cstddef>
+
+#ifndef _ENSEMBLESDISJOINTS__H
+#define _ENSEMBLESDISJOINTS__H
+
+namespace TP3
+{
+
+   /**
+   * \class EnsemblesDisjoints
+   *
+   * \brief Partition des entiers [0, n[ en ensembles disjoints (union-find).
+   *
+   * Chaque ensemble est un arbre dont la racine est le représentant. L'union par taille et la
+   * compression des chemins (par division) rendent chaque opération presque constante en
+   * temps amorti.
+   *
+   */
+   class EnsemblesDisjoints
+   {
+   public:
+
+      /**
+      * \brief Construit n ensembles d'un seul élément
+      */
+      explicit EnsemblesDisjoints(std::size_t n = 0);
+
+      /**
+      * \brief Retourne le représentant de l'ensemble de x
+      *
+      * \pre x < n
+      */
+      std::size_t trouver(std::size_t x);
+
+      /**
+      * \brief Réunit les ensembles de a et de b
+      *
+      * \pre a < n et b < n
+      * \return vrai si a et b étaient dans deux ensembles différents.
+      */
+      bool unir(std::size_t a, std::size_t b);
+
+      std::size_t nombreEnsembles() const { return nbEnsembles; }
+
+   private:
+
+      std::vector<std::size_t> parents;      // Parent de chaque élément ; une racine est son propre parent.
+      std::vector<std::size_t> tailles;      // Nombre d'éléments de l'ensemble, valide pour les racines.
+      std::size_t nbEnsembles;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,155 @@
+/**
+* \file FileBornee.h
+* \brief Interface et code du type FileBornee
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <utility>
+
+#ifndef _FILEBORNEE__H
+#define _FILEBORNEE__H
+
+namespace TP3
+{
+
+   /**
+   * \class FileBornee
+   *
+   * \brief File circulaire bornée sans verrou, pour un seul producteur et un seul consommateur.
+   *
+   * Le producteur n'écrit que fin et le consommateur que debut : deux compteurs atomiques
+   * suffisent. Quand la file est pleine, le producteur attend (contre-pression) ;
+   * quand elle est vide, c'est le consommateur qui attend. L'attente commence par quelques
+   * essais, puis le fil s'endort sur une variable de condition ; l'autre côté ne prend le
+   * verrou pour le réveiller que si un fil dort.
+   *
+   */
+   template <typename T>
+   class FileBornee
+   {
+   public:
+
+      /**
+      * \brief Constructeur
+      *
+      * \post Une file vide pouvant contenir capacite éléments est créée.
+      */
+      explicit FileBornee(std::size_t capacite)
+         : elements(capacite + 1), debut(0), fin(0), producteurEnAttente(false), consommateurEnAttente(false) { }
+
+      /**
+      * \brief Ajoute element à la fin de la file si elle n'est pas pleine
+      *
+      * \return vrai si element a été ajouté
+      */
+      bool essayerEmpiler(T& element)
+      {
+         std::size_t courant = fin.load(std::memory_order_relaxed);
+         std::size_t suivant = (courant + 1) % elements.size();
+         if (suivant == debut.load(std::memory_order_acquire)) return false;
+
+         elements[courant] = std::move(element);
+         fin.store(suivant, std::memory_order_release);
+         return true;
+      }
+
+      /**
+      * \brief Retire le premier élément de la file si elle n'est pas vide
+      *
+      * \return vrai si un élément a été retiré dans element
+      */
+      bool essayerDepiler(T& element)
+      {
+         std::size_t courant = debut.load(std::memory_order_relaxed);
+         if (courant == fin.load(std::memory_order_acquire)) return false;
+
+         element = std::move(elements[courant]);
+         debut.store((courant + 1) % elements.size(), std::memory_order_release);
+         return true;
+      }
+
+      /**
+      * \brief Ajoute element à la fin de la file, en attendant qu'une place se libère
+      */
+      void empiler(T element)
+      {
+         attendre([&]() { return essayerEmpiler(element); }, producteurEnAttente);
+         reveiller(consommateurEnAttente);
+      }
+
+      /**
+      * \brief Retire le premier élément de la file, en attendant qu'il y en ait un
+      */
+      T depiler()
+      {
+         T element;
+         attendre([&]() { return essayerDepiler(element); }, consommateurEnAttente);
+         reveiller(producteurEnAttente);
+         return element;
+      }
+
+   private:
+
+      static const int ESSAIS_AVANT_ATTENTE = 64;
+
+      /**
+      * \brief Appelle essayer jusqu'à ce qu'il réussisse : d'abord quelques fois en cédant le
+      *        processeur, puis en dormant sur la condition avec enAttente levé
+      */
+      template <typename Essai>
+      void attendre(Essai essayer, std::atomic<bool>& enAttente)
+      {
+         for (int essai = 0; essai < ESSAIS_AVANT_ATTENTE; ++essai)
+         {
+            if (essayer()) return;
+            std::this_thread::yield();
+         }
+
+         std::unique_lock<std::mutex> verrou(verrouAttente);
+         for (;;)
+         {
+            // enAttente est levé avant le dernier essai : l'autre côté, qui modifie la file puis lit
+            // enAttente (voir reveiller), ne peut pas manquer à la fois l'essai et le drapeau
+            enAttente.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (essayer()) break;
+            condition.wait(verrou);
+         }
+         enAttente.store(false, std::memory_order_relaxed);
+      }
+
+      /**
+      * \brief Réveille l'autre côté s'il dort (enAttente levé)
+      */
+      void reveiller(std::atomic<bool>& enAttente)
+      {
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         if (!enAttente.load(std::memory_order_relaxed)) return;
+         // prendre le verrou garantit que le dormeur est déjà dans wait ou n'a pas encore fait son essai
+         { std::lock_guard<std::mutex> verrou(verrouAttente); }
+         condition.notify_one();
+      }
+
+      std::vector<T> elements;                // Une case reste toujours libre pour distinguer pleine de vide.
+      alignas(64) std::atomic<std::size_t> debut;   // Prochaine case à lire (écrit par le consommateur).
+      alignas(64) std::atomic<std::size_t> fin;     // Prochaine case à écrire (écrit par le producteur).
+      alignas(64) std::atomic<bool> producteurEnAttente;   // Le producteur dort : la file était pleine.
+      std::atomic<bool> consommateurEnAttente;             // Le consommateur dort : la file était vide.
+      std::mutex verrouAttente;
+      std::condition_variable condition;
+   };
+
+}//Fin du namespace
+
+#endif
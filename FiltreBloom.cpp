@@ -0,0 +1,141 @@
+/**
+* \file FiltreBloom.cpp
+* \brief Le code des opérateurs de FiltreBloom.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "FiltreBloom.h"
+
+#include <functional>
+
+namespace TP3
+{
+
+    /**
+    * \fn std::uint64_t positionsDansBloc(std::uint64_t hachage)
+    * \brief Mélange hachage (finaliseur de splitmix64) : chaque tranche de 9 bits du résultat
+    *        donne la position d'un bit dans le bloc
+    */
+    static inline std::uint64_t positionsDansBloc(std::uint64_t hachage)
+    {
+        hachage = (hachage ^ (hachage >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        hachage = (hachage ^ (hachage >> 27)) * 0x94D049BB133111EBULL;
+        return hachage ^ (hachage >> 31);
+    }
+
+    /**
+    * \brief Constructeur
+    *
+    * \post Un filtre vide prévu pour capacite mots (au moins un bloc) est créé.
+    */
+    FiltreBloom::FiltreBloom(std::size_t capacite)
+    {
+        dimensionner(capacite);
+    }
+
+    /**
+    * \brief Déplacement, sans allocation : source reste un filtre sans bloc
+    */
+    FiltreBloom::FiltreBloom(FiltreBloom&& source) noexcept
+        : blocs(std::move(source.blocs)), capaciteMots(source.capaciteMots),
+          nbAjouts(source.nbAjouts), nbRetraits(source.nbRetraits)
+    {
+        source.blocs.clear();
+        source.capaciteMots = source.nbAjouts = source.nbRetraits = 0;
+    }
+
+    /**
+    * \brief Affectation par déplacement : source reste un filtre sans bloc
+    */
+    FiltreBloom& FiltreBloom::operator=(FiltreBloom&& source) noexcept
+    {
+        if (this != &source)
+        {
+            blocs = std::move(source.blocs);
+            capaciteMots = source.capaciteMots;
+            nbAjouts = source.nbAjouts;
+            nbRetraits = source.nbRetraits;
+            source.blocs.clear();
+            source.capaciteMots = source.nbAjouts = source.nbRetraits = 0;
+        }
+        return *this;
+    }
+
+    /**
+    * \brief Vide le filtre et le dimensionne pour capacite mots
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    void FiltreBloom::dimensionner(std::size_t capacite)
+    {
+        std::size_t nbBlocs = (capacite * BITS_PAR_CLE + 511) / 512;
+        if (nbBlocs == 0) nbBlocs = 1;
+        if (nbBlocs > 0xFFFFFFFFu) nbBlocs = 0xFFFFFFFFu;   // indiceBloc suppose moins de 2^32 blocs
+
+        std::vector<Bloc>(nbBlocs, Bloc()).swap(blocs);
+        capaciteMots = nbBlocs * 512 / BITS_PAR_CLE;
+        nbAjouts = 0;
+        nbRetraits = 0;
+    }
+
+    /**
+    * \brief Ajoute mot au filtre
+    *
+    * \post peutContenir(mot) est vrai jusqu'au prochain dimensionner.
+    */
+    void FiltreBloom::ajouter(std::string_view mot)
+    {
+        // filtre déplacé : le mot est seulement compté, ce qui force la reconstruction
+        if (blocs.empty()) { ++nbAjouts; return; }
+
+        std::uint64_t hachage = hacher(mot);
+        Bloc& bloc = blocs[indiceBloc(hachage)];
+        std::uint64_t positions = positionsDansBloc(hachage);
+        for (int i = 0; i < BITS_PAR_MOT; ++i, positions >>= 9)
+            bloc.mots[(positions >> 6) & 7] |= std::uint64_t(1) << (positions & 63);
+        ++nbAjouts;
+    }
+
+    /**
+    * \brief Faux si mot n'a certainement pas été ajouté depuis le dernier dimensionner
+    *
+    * \post Le filtre reste inchangé.
+    */
+    bool FiltreBloom::peutContenir(std::string_view mot) const
+    {
+        if (blocs.empty()) return true;
+
+        std::uint64_t hachage = hacher(mot);
+        const Bloc& bloc = blocs[indiceBloc(hachage)];
+        std::uint64_t positions = positionsDansBloc(hachage);
+        // pas de sortie anticipée : les 7 tests sont indépendants et ne coûtent qu'un branchement
+        std::uint64_t manquants = 0;
+        for (int i = 0; i < BITS_PAR_MOT; ++i, positions >>= 9)
+            manquants |= ~bloc.mots[(positions >> 6) & 7] & (std::uint64_t(1) << (positions & 63));
+        return manquants == 0;
+    }
+
+    /**
+    * \brief Vrai lorsque plus de mots ont été ajoutés que prévu, ou que plus de la moitié des
+    *        mots ajoutés ont été retirés.
+    */
+    bool FiltreBloom::doitEtreReconstruit() const
+    {
+        return nbAjouts > capaciteMots || (nbRetraits > 0 && 2 * nbRetraits > nbAjouts);
+    }
+
+    /**
+    * \fn std::uint64_t hacher(std::string_view mot)
+    * \brief Hachage de 64 bits de mot ; les 32 bits de poids fort choisissent le bloc
+    */
+    std::uint64_t FiltreBloom::hacher(std::string_view mot)
+    {
+        return std::hash<std::string_view>()(mot);
+    }
+
+}//Fin du namespace
@@ -0,0 +1,120 @@
+/**
+* \file FiltreBloom.h
+* \brief Interface du type FiltreBloom
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "Memoire.h"
+
+#ifndef _FILTREBLOOM__H
+#define _FILTREBLOOM__H
+
+namespace TP3
+{
+
+   /**
+   * \class FiltreBloom
+   *
+   * \brief Filtre de Bloom par blocs : répond « absent » ou « peut-être présent » pour un mot.
+   *
+   * Le filtre est un tableau de blocs de 512 bits, chacun aligné sur une ligne de cache. Un mot
+   * choisit un bloc, puis BITS_PAR_MOT bits dans ce bloc, d'après un seul hachage de 64 bits :
+   * une consultation ne lit qu'une ligne de cache. Avec BITS_PAR_CLE bits par mot prévu, environ
+   * 1 % des mots absents sont déclarés peut-être présents ; un mot ajouté ne l'est jamais à tort.
+   *
+   * Un mot ne peut pas être retiré : les retraits sont seulement comptés, et doitEtreReconstruit
+   * signale quand le filtre est trop plein ou contient trop de mots retirés.
+   *
+   */
+   class FiltreBloom
+   {
+   public:
+
+      /**
+      * \brief Constructeur
+      *
+      * \post Un filtre vide prévu pour capacite mots (au moins un bloc) est créé.
+      */
+      explicit FiltreBloom(std::size_t capacite = 0);
+
+      /**
+      * \brief Déplacement, sans allocation : source reste un filtre sans bloc, qui déclare tous les
+      *        mots peut-être présents et doit être reconstruit dès qu'un mot y est ajouté
+      */
+      FiltreBloom(FiltreBloom&& source) noexcept;
+      FiltreBloom& operator=(FiltreBloom&& source) noexcept;
+      FiltreBloom(const FiltreBloom&) = default;
+      FiltreBloom& operator=(const FiltreBloom&) = default;
+
+      /**
+      * \brief Vide le filtre et le dimensionne pour capacite mots
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void dimensionner(std::size_t capacite);
+
+      /**
+      * \brief Ajoute mot au filtre
+      *
+      * \post peutContenir(mot) est vrai jusqu'au prochain dimensionner.
+      */
+      void ajouter(std::string_view mot);
+
+      /**
+      * \brief Faux si mot n'a certainement pas été ajouté depuis le dernier dimensionner
+      *
+      * \post Le filtre reste inchangé.
+      */
+      bool peutContenir(std::string_view mot) const;
+
+      /**
+      * \brief Compte nbMots mots qui ne sont plus dans l'ensemble filtré (leurs bits restent)
+      */
+      void signalerRetrait(std::size_t nbMots = 1) { nbRetraits += nbMots; }
+
+      /**
+      * \brief Vrai lorsque plus de mots ont été ajoutés que prévu, ou que plus de la moitié des
+      *        mots ajoutés ont été retirés : le taux de faux positifs dépasse alors celui visé.
+      */
+      bool doitEtreReconstruit() const;
+
+      std::size_t capacite() const { return capaciteMots; }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const { return octetsVecteur(blocs); }
+
+      static const std::size_t BITS_PAR_CLE = 10;   // Bits du filtre par mot prévu.
+      static const int BITS_PAR_MOT = 7;            // Bits mis à 1 par mot, tous dans le même bloc.
+
+   private:
+
+      struct alignas(64) Bloc
+      {
+         std::uint64_t mots[8];
+      };
+
+      std::size_t indiceBloc(std::uint64_t hachage) const { return ((hachage >> 32) * blocs.size()) >> 32; }
+
+      static std::uint64_t hacher(std::string_view mot);
+
+      std::vector<Bloc> blocs;
+      std::size_t capaciteMots;
+      std::size_t nbAjouts;       // Mots ajoutés depuis le dernier dimensionner.
+      std::size_t nbRetraits;     // Mots retirés depuis le dernier dimensionner.
+   };
+
+}//Fin du namespace
+
+#endif
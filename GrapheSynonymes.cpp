@@ -0,0 +1,126 @@
+/**
+* \file GrapheSynonymes.cpp
+* \brief Le code des opérateurs de GrapheSynonymes.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "GrapheSynonymes.h"
+
+namespace TP3
+{
+
+    /**
+    * \brief Construit le graphe
+    *
+    * \pre radicaux est trié et sans doublon.
+    * \pre membres[g] contient les identifiants (indices dans radicaux) des membres du groupe g.
+    *
+    * \post Le graphe est initialisé ; les appartenances des radicaux sont déduites de membres.
+    */
+    void GrapheSynonymes::construire(std::vector<std::string> radicaux, const std::vector< std::vector<std::uint32_t> >& membres)
+    {
+        noms.swap(radicaux);
+
+        debutsMembres.assign(1, 0);
+        membresDe.clear();
+        std::vector<std::uint32_t> nbGroupes(noms.size() + 1, 0);
+        for (auto &groupe : membres)
+        {
+            for (auto membre : groupe)
+            {
+                membresDe.push_back(membre);
+                ++nbGroupes[membre + 1];
+            }
+            debutsMembres.push_back(membresDe.size());
+        }
+
+        // sommes préfixes, puis on place chaque groupe dans la tranche de chacun de ses membres
+        for (std::size_t r = 1; r < nbGroupes.size(); ++r) nbGroupes[r] += nbGroupes[r - 1];
+        debutsGroupes = nbGroupes;
+        groupesDe.assign(membresDe.size(), 0);
+        for (std::uint32_t g = 0; g < membres.size(); ++g)
+            for (auto membre : membres[g])
+                groupesDe[nbGroupes[membre]++] = g;
+    }
+
+    /**
+    * \brief Retourne l'identifiant de motRadical, ou -1 s'il n'est pas dans le graphe
+    */
+    long GrapheSynonymes::identifiant(const std::string& motRadical) const
+    {
+        auto it = std::lower_bound(noms.begin(), noms.end(), motRadical);
+        if (it == noms.end() || *it != motRadical) return -1;
+        return it - noms.begin();
+    }
+
+    /**
+    * \brief Retourne, en ordre croissant, les identifiants des radicaux atteignables depuis
+    *        depart en au plus k sauts, depart exclu.
+    *
+    * \post Le graphe reste inchangé.
+    */
+    std::vector<std::uint32_t> GrapheSynonymes::voisinage(std::uint32_t depart, int k) const
+    {
+        // ensembles de bits des radicaux et des groupes déjà visités
+        std::vector<std::uint64_t> radicauxVus((noms.size() + 63) / 64, 0);
+        std::vector<std::uint64_t> groupesVus((debutsMembres.size() + 62) / 64, 0);
+
+        std::vector<std::uint32_t> frontiere {depart};
+        std::vector<std::uint32_t> suivante;
+        radicauxVus[depart / 64] |= std::uint64_t(1) << (depart % 64);
+
+        for (int saut = 0; saut < k && !frontiere.empty(); ++saut)
+        {
+            suivante.clear();
+            for (auto r : frontiere)
+            {
+                for (std::uint32_t i = debutsGroupes[r]; i < debutsGroupes[r + 1]; ++i)
+                {
+                    std::uint32_t g = groupesDe[i];
+                    std::uint64_t bitGroupe = std::uint64_t(1) << (g % 64);
+                    if (groupesVus[g / 64] & bitGroupe) continue;
+                    groupesVus[g / 64] |= bitGroupe;
+
+                    for (std::uint32_t j = debutsMembres[g]; j < debutsMembres[g + 1]; ++j)
+                    {
+                        std::uint32_t voisin = membresDe[j];
+                        std::uint64_t bitRadical = std::uint64_t(1) << (voisin % 64);
+                        if (radicauxVus[voisin / 64] & bitRadical) continue;
+                        radicauxVus[voisin / 64] |= bitRadical;
+                        suivante.push_back(voisin);
+                    }
+                }
+            }
+            frontiere.swap(suivante);
+        }
+
+        radicauxVus[depart / 64] &= ~(std::uint64_t(1) << (depart % 64));
+        std::vector<std::uint32_t> resultat;
+        for (std::size_t mot = 0; mot < radicauxVus.size(); ++mot)
+        {
+            std::uint64_t bits = radicauxVus[mot];
+            for (int position = 0; bits != 0; ++position, bits >>= 1)
+            {
+                if (bits & 1) resultat.push_back(mot * 64 + position);
+            }
+        }
+        return resultat;
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t GrapheSynonymes::memoire() const
+    {
+        std::size_t octets = octetsVecteur(noms) + octetsVecteur(debutsGroupes) + octetsVecteur(groupesDe)
+                             + octetsVecteur(debutsMembres) + octetsVecteur(membresDe);
+        for (auto &nom : noms) octets += octetsChaine(nom);
+        return octets;
+    }
+
+}//Fin du namespace
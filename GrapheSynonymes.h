@@ -0,0 +1,86 @@
+/**
+* \file GrapheSynonymes.h
+* \brief Interface du type GrapheSynonymes
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "Memoire.h"
+
+#ifndef _GRAPHESYNONYMES__H
+#define _GRAPHESYNONYMES__H
+
+namespace TP3
+{
+
+   /**
+   * \class GrapheSynonymes
+   *
+   * \brief Vue compacte (format CSR) du graphe biparti radicaux <-> groupes de synonymes.
+   *
+   * Les radicaux sont numérotés dans l'ordre croissant, ce qui permet de retrouver
+   * l'identifiant d'un radical par recherche dichotomique. Pour chaque radical, on conserve
+   * la tranche de ses groupes ; pour chaque groupe, la tranche de ses membres. Un saut
+   * correspond au passage radical -> groupe -> radical.
+   *
+   */
+   class GrapheSynonymes
+   {
+   public:
+
+      /**
+      * \brief Construit le graphe
+      *
+      * \pre radicaux est trié et sans doublon.
+      * \pre membres[g] contient les identifiants (indices dans radicaux) des membres du groupe g.
+      *
+      * \post Le graphe est initialisé ; les appartenances des radicaux sont déduites de membres.
+      */
+      void construire(std::vector<std::string> radicaux, const std::vector< std::vector<std::uint32_t> >& membres);
+
+      /**
+      * \brief Retourne l'identifiant de motRadical, ou -1 s'il n'est pas dans le graphe
+      */
+      long identifiant(const std::string& motRadical) const;
+
+      /**
+      * \brief Retourne le radical correspondant à l'identifiant
+      */
+      const std::string& radical(std::uint32_t identifiant) const { return noms[identifiant]; }
+
+      /**
+      * \brief Retourne, en ordre croissant, les identifiants des radicaux atteignables depuis
+      *        depart en au plus k sauts, depart exclu.
+      *
+      * \post Le graphe reste inchangé.
+      */
+      std::vector<std::uint32_t> voisinage(std::uint32_t depart, int k) const;
+
+      std::size_t nombreRadicaux() const { return noms.size(); }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+   private:
+
+      std::vector<std::string> noms;                 // Identifiant -> radical, en ordre croissant.
+      std::vector<std::uint32_t> debutsGroupes;      // Tranche [debutsGroupes[r], debutsGroupes[r+1][ de groupesDe.
+      std::vector<std::uint32_t> groupesDe;          // Groupes de chaque radical, bout à bout.
+      std::vector<std::uint32_t> debutsMembres;      // Tranche [debutsMembres[g], debutsMembres[g+1][ de membresDe.
+      std::vector<std::uint32_t> membresDe;          // Membres de chaque groupe, bout à bout.
+   };
+
+}//Fin du namespace
+
+#endif
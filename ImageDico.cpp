@@ -0,0 +1,618 @@
+/**
+* \file ImageDico.cpp
+* \brief Le code des opérateurs de ImageDico.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "ImageDico.h"
+
+#include <cstring>
+#include <cerrno>
+#include <atomic>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace TP3
+{
+
+    static const char MAGIE_IMAGE[8] = { 'D', 'I', 'C', 'O', 'I', 'M', 'G', '1' };
+
+    /**
+    * \brief Écrit l'image de dico dans le fichier chemin
+    *
+    * \exception runtime_error si le fichier ne peut pas être écrit
+    */
+    void ImageDico::ecrire(const DicoSynonymes& dico, const std::string& chemin)
+    {
+        ecrire(construire(dico), chemin);
+    }
+
+    /**
+    * \brief Écrit une image déjà construite dans le fichier chemin. Si synchroniser est vrai,
+    *        le fichier et son répertoire sont synchronisés sur disque (fsync) avant le retour.
+    *
+    * \exception runtime_error si le fichier ne peut pas être écrit
+    */
+    void ImageDico::ecrire(const std::vector<char>& image, const std::string& chemin, bool synchroniser)
+    {
+        // écriture dans un fichier temporaire puis renommage : un lecteur ne voit jamais d'image partielle
+        std::string temporaire = chemin + ".tmp";
+        int descripteur = open(temporaire.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (descripteur < 0)
+            throw std::runtime_error("ImageDico::ecrire : Impossible d'écrire " + temporaire);
+        for (std::size_t ecrits = 0; ecrits < image.size(); )
+        {
+            ssize_t n = write(descripteur, image.data() + ecrits, image.size() - ecrits);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0)
+            {
+                close(descripteur);
+                throw std::runtime_error("ImageDico::ecrire : Impossible d'écrire " + temporaire);
+            }
+            ecrits += n;
+        }
+        bool synchronise = !synchroniser || fsync(descripteur) == 0;
+        if (close(descripteur) != 0 || !synchronise)
+            throw std::runtime_error("ImageDico::ecrire : Impossible d'écrire " + temporaire);
+        if (std::rename(temporaire.c_str(), chemin.c_str()) != 0)
+            throw std::runtime_error("ImageDico::ecrire : Impossible de renommer " + temporaire);
+
+        // le renommage lui-même n'est durable qu'une fois le répertoire synchronisé
+        if (synchroniser)
+        {
+            std::string::size_type barre = chemin.rfind('/');
+            std::string repertoire = barre == std::string::npos ? "." : chemin.substr(0, barre + 1);
+            int descripteurRepertoire = open(repertoire.c_str(), O_RDONLY | O_DIRECTORY);
+            if (descripteurRepertoire < 0)
+                throw std::runtime_error("ImageDico::ecrire : Impossible d'ouvrir " + repertoire);
+            synchronise = fsync(descripteurRepertoire) == 0;
+            close(descripteurRepertoire);
+            if (!synchronise)
+                throw std::runtime_error("ImageDico::ecrire : Impossible de synchroniser " + repertoire);
+        }
+    }
+
+    /**
+    * \fn std::atomic<std::uint64_t>* projeterPointeur(const std::string& nom, bool creer)
+    * \brief Projette l'objet pointeur nom, qui contient le numéro de la version publiée (0 : aucune).
+    *        S'il est créé, ou s'il contient encore une image de l'ancien format, il est remis à 0.
+    *        Sans creer, la projection est en lecture seule.
+    * \return 0 si l'objet n'existe pas ou n'est pas un pointeur (et que creer est faux)
+    */
+    static std::atomic<std::uint64_t>* projeterPointeur(const std::string& nom, bool creer)
+    {
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "le pointeur est partagé entre processus");
+        const off_t taille = sizeof(std::atomic<std::uint64_t>);
+
+        int descripteur = shm_open(nom.c_str(), creer ? O_CREAT | O_RDWR : O_RDONLY, 0644);
+        struct stat infos;
+        if (descripteur >= 0 && creer && fstat(descripteur, &infos) == 0 && infos.st_size != 0 && infos.st_size != taille)
+        {
+            // une image publiée en place par une ancienne version : on ne l'écrase pas, on la détache
+            close(descripteur);
+            shm_unlink(nom.c_str());
+            descripteur = shm_open(nom.c_str(), O_CREAT | O_RDWR, 0644);
+        }
+        if (descripteur < 0) return 0;
+        // un objet neuf a une taille nulle ; ftruncate ne fait que l'agrandir, il est alors rempli de zéros
+        if (fstat(descripteur, &infos) != 0 || (infos.st_size != taille && (!creer || ftruncate(descripteur, taille) != 0)))
+        {
+            close(descripteur);
+            return 0;
+        }
+        void* projection = mmap(0, taille, creer ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descripteur, 0);
+        close(descripteur);
+        return projection == MAP_FAILED ? 0 : static_cast<std::atomic<std::uint64_t>*>(projection);
+    }
+
+    /**
+    * \fn std::string nomVersion(const std::string& nom, std::uint64_t version)
+    * \brief Nom de l'objet de mémoire partagée qui contient la version donnée de l'image nom
+    */
+    static std::string nomVersion(const std::string& nom, std::uint64_t version)
+    {
+        return nom + "." + std::to_string(version);
+    }
+
+    /**
+    * \brief Publie l'image de dico dans l'objet de mémoire partagée POSIX nom (ex. "/dico")
+    *
+    * L'image est écrite dans un objet neuf, nom.<version>, que personne n'a encore ouvert ; le
+    * petit objet nom ne contient que le numéro de la version courante et est mis à jour d'un seul
+    * coup une fois l'image complète. Un objet déjà projeté n'est donc jamais réécrit ni tronqué :
+    * l'ancienne version est seulement détachée (shm_unlink) et reste valide pour ses lecteurs.
+    *
+    * \exception runtime_error si l'objet ne peut pas être créé
+    */
+    void ImageDico::publier(const DicoSynonymes& dico, const std::string& nom)
+    {
+        std::vector<char> image = construire(dico);
+
+        std::atomic<std::uint64_t>* pointeur = projeterPointeur(nom, true);
+        if (pointeur == 0)
+            throw std::runtime_error("ImageDico::publier : Impossible de créer " + nom);
+
+        // O_EXCL : si un autre éditeur a pris ce numéro, on passe au suivant
+        std::uint64_t version = pointeur->load(std::memory_order_acquire);
+        int descripteur;
+        do
+            descripteur = shm_open(nomVersion(nom, ++version).c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        while (descripteur < 0 && errno == EEXIST);
+        std::string nomImage = nomVersion(nom, version);
+        if (descripteur < 0)
+        {
+            munmap(pointeur, sizeof(*pointeur));
+            throw std::runtime_error("ImageDico::publier : Impossible de créer " + nomImage);
+        }
+        if (ftruncate(descripteur, image.size()) != 0)
+        {
+            close(descripteur);
+            shm_unlink(nomImage.c_str());
+            munmap(pointeur, sizeof(*pointeur));
+            throw std::runtime_error("ImageDico::publier : Impossible de dimensionner " + nomImage);
+        }
+        void* projection = mmap(0, image.size(), PROT_READ | PROT_WRITE, MAP_SHARED, descripteur, 0);
+        close(descripteur);
+        if (projection == MAP_FAILED)
+        {
+            shm_unlink(nomImage.c_str());
+            munmap(pointeur, sizeof(*pointeur));
+            throw std::runtime_error("ImageDico::publier : Impossible de projeter " + nomImage);
+        }
+        std::memcpy(projection, image.data(), image.size());
+        munmap(projection, image.size());
+
+        // bascule : les lecteurs qui lisent le nouveau numéro voient l'image complète
+        std::uint64_t ancienne = pointeur->exchange(version, std::memory_order_acq_rel);
+        munmap(pointeur, sizeof(*pointeur));
+        if (ancienne != 0)
+            shm_unlink(nomVersion(nom, ancienne).c_str());
+    }
+
+    /**
+    * \brief Projette en lecture seule l'image contenue dans le fichier chemin
+    *
+    * \exception runtime_error si le fichier ne peut pas être projeté ou n'est pas une image valide
+    */
+    ImageDico ImageDico::ouvrirFichier(const std::string& chemin)
+    {
+        int descripteur = open(chemin.c_str(), O_RDONLY);
+        if (descripteur < 0)
+            throw std::runtime_error("ImageDico::ouvrirFichier : Impossible d'ouvrir " + chemin);
+        return projeter(descripteur);
+    }
+
+    /**
+    * \brief Projette en lecture seule la version courante de l'image publiée sous nom
+    *
+    * \exception runtime_error si l'objet ne peut pas être projeté ou n'est pas une image valide
+    */
+    ImageDico ImageDico::ouvrirMemoirePartagee(const std::string& nom)
+    {
+        std::atomic<std::uint64_t>* pointeur = projeterPointeur(nom, false);
+        if (pointeur == 0)
+            throw std::runtime_error("ImageDico::ouvrirMemoirePartagee : Impossible d'ouvrir " + nom);
+
+        // entre la lecture du numéro et l'ouverture, un éditeur peut avoir détaché cette version :
+        // on relit alors le pointeur, qui désigne forcément une version plus récente
+        int descripteur = -1;
+        std::uint64_t version = 0;
+        for (int essai = 0; descripteur < 0 && essai < 16; ++essai)
+        {
+            version = pointeur->load(std::memory_order_acquire);
+            if (version == 0) break;
+            descripteur = shm_open(nomVersion(nom, version).c_str(), O_RDONLY, 0);
+            if (descripteur < 0 && errno != ENOENT) break;
+        }
+        munmap(pointeur, sizeof(*pointeur));
+        if (descripteur < 0)
+            throw std::runtime_error("ImageDico::ouvrirMemoirePartagee : Impossible d'ouvrir "
+                                     + (version == 0 ? nom : nomVersion(nom, version)));
+        return projeter(descripteur);
+    }
+
+    ImageDico::ImageDico(const char* debut, std::size_t taille) : debut(debut), taille(taille)
+    {
+    }
+
+    ImageDico::ImageDico(ImageDico&& autre) noexcept : debut(autre.debut), taille(autre.taille)
+    {
+        autre.debut = 0;
+        autre.taille = 0;
+    }
+
+    ImageDico& ImageDico::operator=(ImageDico&& autre) noexcept
+    {
+        std::swap(debut, autre.debut);
+        std::swap(taille, autre.taille);
+        return *this;
+    }
+
+    /**
+    * \brief Destructeur. La projection est libérée.
+    */
+    ImageDico::~ImageDico()
+    {
+        if (debut != 0) munmap(const_cast<char*>(debut), taille);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverRadical
+    */
+    std::optional<std::string> ImageDico::trouverRadical(std::string_view mot) const
+    {
+        const Entete& e = entete();
+        const EntreeIndex* index = tableau<EntreeIndex>(e.decIndexFlexions);
+        const Radical* radicaux = tableau<Radical>(e.decRadicaux);
+
+        // première entrée dont la flexion n'est pas inférieure à mot
+        std::uint32_t bas = 0, haut = e.nbFlexions;
+        while (bas < haut)
+        {
+            std::uint32_t milieu = bas + (haut - bas) / 2;
+            if (texte(index[milieu].flexion) < mot) bas = milieu + 1;
+            else haut = milieu;
+        }
+        if (bas == e.nbFlexions || texte(index[bas].flexion) != mot) return std::nullopt;
+
+        // plusieurs radicaux peuvent partager la flexion : on garde le plus semblable
+        const Radical* meilleur = 0;
+        float similitudeMax = -1;
+        for (std::uint32_t i = bas; i < e.nbFlexions && texte(index[i].flexion) == mot; ++i)
+        {
+            const Radical* radical = &radicaux[index[i].radical];
+            float degre = similitude(texte(radical->texte), mot);
+            if (degre > similitudeMax)
+            {
+                similitudeMax = degre;
+                meilleur = radical;
+            }
+        }
+        return std::string(texte(meilleur->texte));
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverFlexions
+    */
+    std::optional< std::vector<std::string> > ImageDico::trouverFlexions(std::string_view motRadical) const
+    {
+        long position = chercherRadical(motRadical);
+        if (position < 0) return std::nullopt;
+
+        const Radical& radical = tableau<Radical>(entete().decRadicaux)[position];
+        const Chaine* flexions = tableau<Chaine>(entete().decFlexions) + radical.premiereFlexion;
+        std::vector<std::string> resultat;
+        for (std::uint32_t i = 0; i < radical.nbFlexions; ++i)
+            resultat.emplace_back(texte(flexions[i]));
+        return resultat;
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverNombreSens
+    */
+    std::optional<int> ImageDico::trouverNombreSens(std::string_view motRadical) const
+    {
+        long position = chercherRadical(motRadical);
+        if (position < 0) return std::nullopt;
+        return static_cast<int>(tableau<Radical>(entete().decRadicaux)[position].nbAppartenances);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::trouverSynonymes
+    */
+    std::optional< std::vector<std::string> > ImageDico::trouverSynonymes(std::string_view motRadical, int position) const
+    {
+        long indice = chercherRadical(motRadical);
+        if (indice < 0) return std::nullopt;
+
+        const Entete& e = entete();
+        const Radical* radicaux = tableau<Radical>(e.decRadicaux);
+        const Radical& radical = radicaux[indice];
+        if (position < 0 || position >= static_cast<int>(radical.nbAppartenances)) return std::nullopt;
+
+        std::uint32_t groupe = tableau<std::uint32_t>(e.decAppartenances)[radical.premiereAppartenance + position];
+        const std::uint32_t* debutsGroupes = tableau<std::uint32_t>(e.decDebutsGroupes);
+        const std::uint32_t* membres = tableau<std::uint32_t>(e.decMembres);
+
+        std::vector<std::string> synonymes;
+        for (std::uint32_t i = debutsGroupes[groupe]; i < debutsGroupes[groupe + 1]; ++i)
+            if (membres[i] != static_cast<std::uint32_t>(indice))
+                synonymes.emplace_back(texte(radicaux[membres[i]].texte));
+        return synonymes;
+    }
+
+    int ImageDico::nombreRadicaux() const
+    {
+        return entete().nbRadicaux;
+    }
+
+    /**
+    * \brief Construit l'image complète de dico en mémoire
+    *
+    * \exception length_error si l'image dépasse 4 Go
+    */
+    std::vector<char> ImageDico::construire(const DicoSynonymes& dico)
+    {
+        std::vector<DicoSynonymes::NoeudDicoSynonymes*> noeuds;
+        dico.auxParcoursEnOrdre(dico.racine, noeuds);
+
+        std::unordered_map<const DicoSynonymes::NoeudDicoSynonymes*, std::uint32_t> identifiants;
+        for (std::uint32_t i = 0; i < noeuds.size(); ++i) identifiants.emplace(noeuds[i], i);
+
+        std::string chaines;
+        auto ajouterChaine = [&chaines](const std::string& s) {
+            Chaine c { static_cast<std::uint32_t>(chaines.size()), static_cast<std::uint32_t>(s.size()) };
+            chaines += s;
+            return c;
+        };
+
+        std::vector<Radical> radicaux;
+        std::vector<Chaine> flexions;
+        std::vector<EntreeIndex> index;
+        std::vector<std::uint32_t> appartenances;
+        for (std::uint32_t i = 0; i < noeuds.size(); ++i)
+        {
+            Radical r;
+            r.texte = ajouterChaine(noeuds[i]->radical);
+            r.premiereFlexion = flexions.size();
+            for (auto &flexion : dico.flexionsDe(noeuds[i]))
+            {
+                flexions.push_back(ajouterChaine(flexion));
+                index.push_back(EntreeIndex { flexions.back(), i });
+            }
+            r.nbFlexions = flexions.size() - r.premiereFlexion;
+            r.premiereAppartenance = appartenances.size();
+            for (auto numGroupe : noeuds[i]->appSynonymes) appartenances.push_back(numGroupe);
+            r.nbAppartenances = appartenances.size() - r.premiereAppartenance;
+            radicaux.push_back(r);
+        }
+
+        std::vector<std::uint32_t> debutsGroupes(1, 0);
+        std::vector<std::uint32_t> membres;
+        for (auto &groupe : dico.groupesSynonymes)
+        {
+            for (auto adresse : groupe) membres.push_back(identifiants[adresse]);
+            debutsGroupes.push_back(membres.size());
+        }
+
+        std::sort(index.begin(), index.end(), [&chaines](const EntreeIndex& a, const EntreeIndex& b) {
+            int comparaison = chaines.compare(a.flexion.decalage, a.flexion.longueur, chaines, b.flexion.decalage, b.flexion.longueur);
+            return comparaison < 0 || (comparaison == 0 && a.radical < b.radical);
+        });
+
+        // disposition des sections, chacune alignée sur 4 octets
+        Entete e;
+        std::memcpy(e.magie, MAGIE_IMAGE, sizeof(e.magie));
+        e.version = 1;
+        e.nbRadicaux = radicaux.size();
+        e.nbFlexions = flexions.size();
+        e.nbAppartenances = appartenances.size();
+        e.nbGroupes = dico.groupesSynonymes.size();
+        e.nbMembres = membres.size();
+
+        std::size_t position = sizeof(Entete);
+        auto placer = [&position](std::size_t octets) {
+            std::size_t debutSection = position;
+            position = (position + octets + 3) & ~std::size_t(3);
+            return static_cast<std::uint32_t>(debutSection);
+        };
+        e.decRadicaux = placer(radicaux.size() * sizeof(Radical));
+        e.decFlexions = placer(flexions.size() * sizeof(Chaine));
+        e.decIndexFlexions = placer(index.size() * sizeof(EntreeIndex));
+        e.decAppartenances = placer(appartenances.size() * sizeof(std::uint32_t));
+        e.decDebutsGroupes = placer(debutsGroupes.size() * sizeof(std::uint32_t));
+        e.decMembres = placer(membres.size() * sizeof(std::uint32_t));
+        e.decChaines = placer(chaines.size());
+        if (position > 0xFFFFFFFFu)
+            throw std::length_error("ImageDico::construire : L'image dépasse 4 Go");
+        e.taille = position;
+
+        // les décalages des chaînes sont relatifs au début de la section des chaînes jusqu'ici
+        for (auto &r : radicaux) r.texte.decalage += e.decChaines;
+        for (auto &f : flexions) f.decalage += e.decChaines;
+        for (auto &entree : index) entree.flexion.decalage += e.decChaines;
+
+        // une section vide n'est pas copiée : data() d'un vecteur vide peut être nul
+        std::vector<char> image(position, 0);
+        auto copier = [&image](std::uint32_t decalage, const void* source, std::size_t octets) {
+            if (octets > 0) std::memcpy(&image[decalage], source, octets);
+        };
+        copier(0, &e, sizeof(e));
+        copier(e.decRadicaux, radicaux.data(), radicaux.size() * sizeof(Radical));
+        copier(e.decFlexions, flexions.data(), flexions.size() * sizeof(Chaine));
+        copier(e.decIndexFlexions, index.data(), index.size() * sizeof(EntreeIndex));
+        copier(e.decAppartenances, appartenances.data(), appartenances.size() * sizeof(std::uint32_t));
+        copier(e.decDebutsGroupes, debutsGroupes.data(), debutsGroupes.size() * sizeof(std::uint32_t));
+        copier(e.decMembres, membres.data(), membres.size() * sizeof(std::uint32_t));
+        copier(e.decChaines, chaines.data(), chaines.size());
+        return image;
+    }
+
+    /**
+    * \brief Remplace le contenu de dico par celui de l'image
+    *
+    * \post Les radicaux, leurs flexions (dans le même ordre), leurs appartenances et les groupes
+    *       (même numérotation, même ordre des membres, groupes vides compris) sont ceux de l'image.
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    void ImageDico::restaurer(DicoSynonymes& dico) const
+    {
+        dico.auxDetruire(dico.racine);
+        dico.racine = 0;
+        dico.nbRadicaux = 0;
+        dico.groupesSynonymes.clear();
+
+        const Entete& e = entete();
+        const Radical* radicaux = tableau<Radical>(e.decRadicaux);
+        const Chaine* flexions = tableau<Chaine>(e.decFlexions);
+        const std::uint32_t* appartenances = tableau<std::uint32_t>(e.decAppartenances);
+
+        // les radicaux de l'image sont triés : l'arbre est construit équilibré d'un coup
+        std::vector<DicoSynonymes::NoeudDicoSynonymes*> noeuds;
+        noeuds.reserve(e.nbRadicaux);
+        for (std::uint32_t i = 0; i < e.nbRadicaux; ++i)
+        {
+            const Radical& radical = radicaux[i];
+            DicoSynonymes::NoeudDicoSynonymes* noeud = dico.creerNoeud(std::string(texte(radical.texte)));
+            for (std::uint32_t j = 0; j < radical.nbFlexions; ++j)
+                dico.insererFlexion(noeud, std::string(texte(flexions[radical.premiereFlexion + j])));
+            noeud->appSynonymes.assign(appartenances + radical.premiereAppartenance,
+                                       appartenances + radical.premiereAppartenance + radical.nbAppartenances);
+            noeuds.push_back(noeud);
+        }
+
+        const std::uint32_t* debutsGroupes = tableau<std::uint32_t>(e.decDebutsGroupes);
+        const std::uint32_t* membres = tableau<std::uint32_t>(e.decMembres);
+        dico.groupesSynonymes.resize(e.nbGroupes);
+        for (std::uint32_t g = 0; g < e.nbGroupes; ++g)
+            for (std::uint32_t i = debutsGroupes[g]; i < debutsGroupes[g + 1]; ++i)
+                dico.groupesSynonymes[g].push_back(noeuds[membres[i]]);
+
+        dico.racine = dico.construireEquilibre(noeuds, 0, noeuds.size());
+        dico.nbRadicaux = noeuds.size();
+        dico.cacheRadicaux.vider();
+        dico.reconstruireIndexTrigrammes();
+        dico.reconstruireFiltre();
+        dico.grapheSynonymesAJour = false;
+        dico.raciniseurAJour = false;
+        dico.motsParLongueurAJour = false;
+    }
+
+    /**
+    * \fn ImageDico projeter(int descripteur)
+    * \brief Projette en lecture seule le contenu du descripteur (qui est fermé) et valide l'entête
+    */
+    ImageDico ImageDico::projeter(int descripteur)
+    {
+        struct stat infos;
+        if (fstat(descripteur, &infos) != 0 || static_cast<std::size_t>(infos.st_size) < sizeof(Entete))
+        {
+            close(descripteur);
+            throw std::runtime_error("ImageDico::projeter : L'image est trop petite");
+        }
+        void* projection = mmap(0, infos.st_size, PROT_READ, MAP_SHARED, descripteur, 0);
+        close(descripteur);
+        if (projection == MAP_FAILED)
+            throw std::runtime_error("ImageDico::projeter : Impossible de projeter l'image");
+
+        ImageDico image(static_cast<const char*>(projection), infos.st_size);
+        if (!image.estValide())
+            throw std::runtime_error("ImageDico::projeter : L'image n'est pas valide");
+        return image;
+    }
+
+    /**
+    * \fn bool estValide() const
+    * \brief Vérifie toute l'image avant qu'on y lise quoi que ce soit : entête, sections (décalage,
+    *        alignement, nombre d'éléments), chaque chaîne, les intervalles de flexions et d'appartenances
+    *        de chaque radical, les numéros de groupes et de radicaux, l'ordre des tableaux triés et
+    *        l'accord entre les appartenances et les membres des groupes.
+    */
+    bool ImageDico::estValide() const
+    {
+        const Entete& e = entete();
+        if (std::memcmp(e.magie, MAGIE_IMAGE, sizeof(e.magie)) != 0 || e.version != 1 || e.taille != taille)
+            return false;
+
+        auto sectionValide = [this](std::uint32_t decalage, std::uint64_t nombre, std::size_t tailleElement) {
+            return decalage >= sizeof(Entete) && decalage % 4 == 0 && decalage + nombre * tailleElement <= taille;
+        };
+        if (!sectionValide(e.decRadicaux, e.nbRadicaux, sizeof(Radical))
+            || !sectionValide(e.decFlexions, e.nbFlexions, sizeof(Chaine))
+            || !sectionValide(e.decIndexFlexions, e.nbFlexions, sizeof(EntreeIndex))
+            || !sectionValide(e.decAppartenances, e.nbAppartenances, sizeof(std::uint32_t))
+            || !sectionValide(e.decDebutsGroupes, std::uint64_t(e.nbGroupes) + 1, sizeof(std::uint32_t))
+            || !sectionValide(e.decMembres, e.nbMembres, sizeof(std::uint32_t))
+            || !sectionValide(e.decChaines, 0, 1))
+            return false;
+        auto chaineValide = [this, &e](const Chaine& chaine) {
+            return chaine.decalage >= e.decChaines && std::uint64_t(chaine.decalage) + chaine.longueur <= taille;
+        };
+
+        const Radical* radicaux = tableau<Radical>(e.decRadicaux);
+        const Chaine* flexions = tableau<Chaine>(e.decFlexions);
+        const std::uint32_t* appartenances = tableau<std::uint32_t>(e.decAppartenances);
+        std::vector< std::pair<std::uint32_t, std::uint32_t> > paires;   // (groupe, radical) selon les appartenances
+        for (std::uint32_t i = 0; i < e.nbRadicaux; ++i)
+        {
+            const Radical& radical = radicaux[i];
+            if (!chaineValide(radical.texte)
+                || std::uint64_t(radical.premiereFlexion) + radical.nbFlexions > e.nbFlexions
+                || std::uint64_t(radical.premiereAppartenance) + radical.nbAppartenances > e.nbAppartenances
+                || (i > 0 && !(texte(radicaux[i - 1].texte) < texte(radical.texte))))
+                return false;
+            for (std::uint32_t j = 0; j < radical.nbAppartenances; ++j)
+                paires.emplace_back(appartenances[radical.premiereAppartenance + j], i);
+        }
+        for (std::uint32_t i = 0; i < e.nbFlexions; ++i)
+            if (!chaineValide(flexions[i])) return false;
+
+        const EntreeIndex* index = tableau<EntreeIndex>(e.decIndexFlexions);
+        for (std::uint32_t i = 0; i < e.nbFlexions; ++i)
+        {
+            if (!chaineValide(index[i].flexion) || index[i].radical >= e.nbRadicaux
+                || (i > 0 && texte(index[i].flexion) < texte(index[i - 1].flexion)))
+                return false;
+        }
+
+        const std::uint32_t* debutsGroupes = tableau<std::uint32_t>(e.decDebutsGroupes);
+        const std::uint32_t* membres = tableau<std::uint32_t>(e.decMembres);
+        if (debutsGroupes[0] != 0 || debutsGroupes[e.nbGroupes] != e.nbMembres) return false;
+        std::vector< std::pair<std::uint32_t, std::uint32_t> > membresGroupes;
+        membresGroupes.reserve(e.nbMembres);
+        for (std::uint32_t g = 0; g < e.nbGroupes; ++g)
+        {
+            if (debutsGroupes[g + 1] < debutsGroupes[g]) return false;
+            for (std::uint32_t i = debutsGroupes[g]; i < debutsGroupes[g + 1]; ++i)
+            {
+                if (membres[i] >= e.nbRadicaux) return false;
+                membresGroupes.emplace_back(g, membres[i]);
+            }
+        }
+
+        // chaque appartenance d'un radical correspond à sa présence parmi les membres du groupe
+        std::sort(paires.begin(), paires.end());
+        std::sort(membresGroupes.begin(), membresGroupes.end());
+        return paires == membresGroupes;
+    }
+
+    /**
+    * \fn long chercherRadical(std::string_view motRadical) const
+    * \brief Recherche dichotomique de motRadical dans les radicaux triés
+    * \return l'indice du radical, -1 s'il est absent
+    */
+    long ImageDico::chercherRadical(std::string_view motRadical) const
+    {
+        const Radical* radicaux = tableau<Radical>(entete().decRadicaux);
+        long bas = 0, haut = static_cast<long>(entete().nbRadicaux) - 1;
+        while (bas <= haut)
+        {
+            long milieu = bas + (haut - bas) / 2;
+            int comparaison = texte(radicaux[milieu].texte).compare(motRadical);
+            if (comparaison == 0) return milieu;
+            if (comparaison < 0) bas = milieu + 1;
+            else haut = milieu - 1;
+        }
+        return -1;
+    }
+
+    /**
+    * \fn float similitude(std::string_view mot1, std::string_view mot2)
+    * \brief Même mesure que DicoSynonymes::similitude (1 - distance de Levenshtein / longueur du plus long mot)
+    */
+    float ImageDico::similitude(std::string_view mot1, std::string_view mot2)
+    {
+        std::size_t longueur = std::max(mot1.size(), mot2.size());
+        return longueur == 0 ? 1 : 1 - DicoSynonymes::distanceLevenstein(mot1, mot2) / longueur;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,181 @@
+/**
+* \file ImageDico.h
+* \brief Interface du type ImageDico
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <stdexcept>
+#include <fstream>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include "DicoSynonymes.h"
+
+#ifndef _IMAGEDICO__H
+#define _IMAGEDICO__H
+
+namespace TP3
+{
+
+   /**
+   * \class ImageDico
+   *
+   * \brief Image en lecture seule d'un DicoSynonymes, indépendante de sa position en mémoire.
+   *
+   * Un processus construit l'image (fichier ou mémoire partagée POSIX) ; les autres la projettent
+   * en lecture seule avec mmap et font leurs recherches directement dans la projection, sans
+   * rien recopier. Toutes les références internes sont des décalages de 32 bits par rapport au
+   * début de l'image :
+   *
+   *   Entete | radicaux (triés) | références de flexions | index flexion -> radical (trié)
+   *          | appartenances (groupes de chaque radical) | débuts des groupes | membres | chaînes
+   *
+   */
+   class ImageDico
+   {
+   public:
+
+      /**
+      * \brief Écrit l'image de dico dans le fichier chemin
+      *
+      * \exception runtime_error si le fichier ne peut pas être écrit
+      */
+      static void ecrire(const DicoSynonymes& dico, const std::string& chemin);
+
+      /**
+      * \brief Construit l'image complète de dico en mémoire
+      *
+      * \exception length_error si l'image dépasse 4 Go
+      */
+      static std::vector<char> construire(const DicoSynonymes& dico);
+
+      /**
+      * \brief Écrit une image déjà construite dans le fichier chemin. Si synchroniser est vrai,
+      *        le fichier et son répertoire sont synchronisés sur disque (fsync) avant le retour.
+      *
+      * \exception runtime_error si le fichier ne peut pas être écrit
+      */
+      static void ecrire(const std::vector<char>& image, const std::string& chemin, bool synchroniser = false);
+
+      /**
+      * \brief Publie l'image de dico dans l'objet de mémoire partagée POSIX nom (ex. "/dico")
+      *
+      * L'image va dans un objet neuf, nom.<version> ; nom ne contient que le numéro de la version
+      * courante. Une image déjà projetée par un lecteur n'est jamais modifiée.
+      *
+      * \exception runtime_error si l'objet ne peut pas être créé
+      */
+      static void publier(const DicoSynonymes& dico, const std::string& nom);
+
+      /**
+      * \brief Projette en lecture seule l'image contenue dans le fichier chemin
+      *
+      * \exception runtime_error si le fichier ne peut pas être projeté ou n'est pas une image valide
+      */
+      static ImageDico ouvrirFichier(const std::string& chemin);
+
+      /**
+      * \brief Projette en lecture seule la version courante de l'image publiée sous nom
+      *
+      * \exception runtime_error si l'objet ne peut pas être projeté ou n'est pas une image valide
+      */
+      static ImageDico ouvrirMemoirePartagee(const std::string& nom);
+
+      ImageDico(ImageDico&& autre) noexcept;
+      ImageDico& operator=(ImageDico&& autre) noexcept;
+      ImageDico(const ImageDico&) = delete;
+      ImageDico& operator=(const ImageDico&) = delete;
+
+      /**
+      * \brief Destructeur. La projection est libérée.
+      */
+      ~ImageDico();
+
+      /**
+      * \brief Voir DicoSynonymes::trouverRadical
+      */
+      std::optional<std::string> trouverRadical(std::string_view mot) const;
+
+      /**
+      * \brief Voir DicoSynonymes::trouverFlexions
+      */
+      std::optional< std::vector<std::string> > trouverFlexions(std::string_view motRadical) const;
+
+      /**
+      * \brief Voir DicoSynonymes::trouverNombreSens
+      */
+      std::optional<int> trouverNombreSens(std::string_view motRadical) const;
+
+      /**
+      * \brief Voir DicoSynonymes::trouverSynonymes
+      */
+      std::optional< std::vector<std::string> > trouverSynonymes(std::string_view motRadical, int position) const;
+
+      bool contientRadical(std::string_view motRadical) const { return chercherRadical(motRadical) >= 0; }
+      int nombreRadicaux() const;
+
+      /**
+      * \brief Remplace le contenu de dico par celui de l'image
+      *
+      * \post Les radicaux, leurs flexions (dans le même ordre), leurs appartenances et les groupes
+      *       (même numérotation, même ordre des membres, groupes vides compris) sont ceux de l'image.
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void restaurer(DicoSynonymes& dico) const;
+
+   private:
+
+      struct Entete
+      {
+         char magie[8];
+         std::uint32_t version;
+         std::uint32_t taille;
+         std::uint32_t nbRadicaux;
+         std::uint32_t nbFlexions;
+         std::uint32_t nbAppartenances;
+         std::uint32_t nbGroupes;
+         std::uint32_t nbMembres;
+         std::uint32_t decRadicaux, decFlexions, decIndexFlexions, decAppartenances, decDebutsGroupes, decMembres, decChaines;
+      };
+
+      struct Chaine { std::uint32_t decalage, longueur; };
+
+      struct Radical
+      {
+         Chaine texte;
+         std::uint32_t premiereFlexion, nbFlexions;
+         std::uint32_t premiereAppartenance, nbAppartenances;
+      };
+
+      struct EntreeIndex { Chaine flexion; std::uint32_t radical; };
+
+      static ImageDico projeter(int descripteur);
+      static float similitude(std::string_view mot1, std::string_view mot2);
+      bool estValide() const;
+
+      ImageDico(const char* debut, std::size_t taille);
+
+      std::string_view texte(const Chaine& chaine) const { return std::string_view(debut + chaine.decalage, chaine.longueur); }
+      template <typename T> const T* tableau(std::uint32_t decalage) const { return reinterpret_cast<const T*>(debut + decalage); }
+      const Entete& entete() const { return *reinterpret_cast<const Entete*>(debut); }
+      long chercherRadical(std::string_view motRadical) const;
+
+      const char* debut;      // Début de la projection.
+      std::size_t taille;     // Taille de la projection.
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,177 @@
+/**
+* \file IndexTrigrammes.cpp
+* \brief Le code des opérateurs de IndexTrigrammes.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "IndexTrigrammes.h"
+
+namespace TP3
+{
+
+    /**
+    * \brief Indexe les trigrammes de motIndexe sous le radical motRadical
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    void IndexTrigrammes::ajouterMot(const std::string& motRadical, const std::string& motIndexe)
+    {
+        std::uint32_t identifiant;
+        auto it = identifiants.find(motRadical);
+        if (it != identifiants.end())
+        {
+            identifiant = it->second;
+        }
+        else
+        {
+            identifiant = static_cast<std::uint32_t>(radicaux.size());
+            radicaux.push_back(motRadical);
+            identifiants.emplace(motRadical, identifiant);
+        }
+
+        for (auto trigramme : trigrammes(motIndexe))
+        {
+            std::vector<std::uint32_t>& liste = listes[trigramme];
+            // les identifiants sont attribués en ordre croissant : l'insertion se fait presque toujours à la fin
+            auto position = std::lower_bound(liste.begin(), liste.end(), identifiant);
+            if (position == liste.end() || *position != identifiant)
+                liste.insert(position, identifiant);
+        }
+    }
+
+    /**
+    * \brief Retire motRadical de l'index. Ses entrées restent dans les listes jusqu'à la
+    *        prochaine reconstruction mais ne sont plus jamais retournées.
+    */
+    void IndexTrigrammes::retirerRadical(const std::string& motRadical)
+    {
+        auto it = identifiants.find(motRadical);
+        if (it == identifiants.end()) return;
+
+        radicaux[it->second].clear();
+        identifiants.erase(it);
+        ++nbRetires;
+    }
+
+    /**
+    * \brief Indique si le filtrage est possible pour mot et distanceMax.
+    *        Quand il ne l'est pas, tous les radicaux sont des candidats.
+    */
+    bool IndexTrigrammes::peutFiltrer(const std::string& mot, int distanceMax) const
+    {
+        return static_cast<long>(trigrammes(mot).size()) - 3L * distanceMax > 0;
+    }
+
+    /**
+    * \brief Retourne les radicaux dont le radical ou une flexion partage suffisament de trigrammes
+    *        avec mot pour être à une distance d'édition d'au plus distanceMax.
+    *
+    * \post L'index reste inchangé.
+    * \return les radicaux candidats, sans ordre particulier.
+    */
+    std::vector<std::string> IndexTrigrammes::candidats(const std::string& mot, int distanceMax) const
+    {
+        std::vector<std::string> resultat;
+        std::vector<std::uint32_t> trigrammesMot = trigrammes(mot);
+        long seuil = static_cast<long>(trigrammesMot.size()) - 3L * distanceMax;
+
+        // Le filtrage est impossible : tous les radicaux vivants sont des candidats
+        if (seuil <= 0)
+        {
+            for (auto &radical : radicaux)
+                if (!radical.empty()) resultat.push_back(radical);
+            return resultat;
+        }
+
+        static const std::vector<std::uint32_t> listeVide;
+        std::vector<const std::vector<std::uint32_t>*> listesMot;
+        for (auto trigramme : trigrammesMot)
+        {
+            auto it = listes.find(trigramme);
+            listesMot.push_back(it != listes.end() ? &it->second : &listeVide);
+        }
+        std::sort(listesMot.begin(), listesMot.end(),
+                  [](const std::vector<std::uint32_t>* a, const std::vector<std::uint32_t>* b) { return a->size() < b->size(); });
+
+        // Filtrage par préfixe : un candidat qui partage au moins seuil trigrammes apparaît
+        // forcément dans une des (|T| - seuil + 1) plus courtes listes.
+        std::size_t nbListesPrefixe = trigrammesMot.size() - seuil + 1;
+        std::vector<std::uint32_t> possibles;
+        for (std::size_t i = 0; i < nbListesPrefixe; ++i)
+            possibles.insert(possibles.end(), listesMot[i]->begin(), listesMot[i]->end());
+        std::sort(possibles.begin(), possibles.end());
+        possibles.erase(std::unique(possibles.begin(), possibles.end()), possibles.end());
+
+        // Filtrage par compte : on vérifie le nombre de trigrammes partagés
+        for (auto identifiant : possibles)
+        {
+            if (radicaux[identifiant].empty()) continue;
+
+            long communs = 0;
+            for (auto liste : listesMot)
+                if (std::binary_search(liste->begin(), liste->end(), identifiant)) ++communs;
+            if (communs >= seuil) resultat.push_back(radicaux[identifiant]);
+        }
+        return resultat;
+    }
+
+    /**
+    * \brief Vrai lorsque les entrées retirées occupent plus de place que les entrées vivantes
+    */
+    bool IndexTrigrammes::doitEtreReconstruit() const
+    {
+        return nbRetires > 16 && nbRetires > identifiants.size();
+    }
+
+    /**
+    * \brief Vide l'index
+    */
+    void IndexTrigrammes::vider()
+    {
+        listes.clear();
+        radicaux.clear();
+        identifiants.clear();
+        nbRetires = 0;
+    }
+
+    /**
+    * \fn std::vector<std::uint32_t> trigrammes(const std::string& mot)
+    * \brief Calcule les trigrammes distincts (triés) de mot entouré de deux caractères de bordure de chaque côté
+    * \param[in] mot le mot à découper
+    * \return std::vector<std::uint32_t> les trigrammes, chacun encodé sur 24 bits
+    */
+    std::vector<std::uint32_t> IndexTrigrammes::trigrammes(const std::string& mot)
+    {
+        std::string borde = "\x02\x02" + mot + "\x03\x03";
+        std::vector<std::uint32_t> resultat;
+        resultat.reserve(borde.size() - 2);
+
+        for (std::size_t i = 0; i + 2 < borde.size(); ++i)
+        {
+            resultat.push_back((static_cast<std::uint32_t>(static_cast<unsigned char>(borde[i])) << 16)
+                               | (static_cast<std::uint32_t>(static_cast<unsigned char>(borde[i + 1])) << 8)
+                               | static_cast<unsigned char>(borde[i + 2]));
+        }
+        std::sort(resultat.begin(), resultat.end());
+        resultat.erase(std::unique(resultat.begin(), resultat.end()), resultat.end());
+        return resultat;
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t IndexTrigrammes::memoire() const
+    {
+        std::size_t octets = octetsTableHachage(listes) + octetsVecteur(radicaux) + octetsTableHachage(identifiants);
+        for (auto &liste : listes) octets += octetsVecteur(liste.second);
+        for (auto &radical : radicaux) octets += octetsChaine(radical);
+        for (auto &entree : identifiants) octets += octetsChaine(entree.first);
+        return octets;
+    }
+
+}//Fin du namespace
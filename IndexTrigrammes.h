@@ -0,0 +1,99 @@
+/**
+* \file IndexTrigrammes.h
+* \brief Interface du type IndexTrigrammes
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+
+#include "Memoire.h"
+
+#ifndef _INDEXTRIGRAMMES__H
+#define _INDEXTRIGRAMMES__H
+
+namespace TP3
+{
+
+   /**
+   * \class IndexTrigrammes
+   *
+   * \brief Index inversé de trigrammes de caractères sur les radicaux et leurs flexions.
+   *
+   * Chaque trigramme (calculé sur le mot entouré de deux caractères de bordure de chaque côté)
+   * pointe vers la liste triée des radicaux dont le radical ou une des flexions le contient.
+   * Un mot à distance d'édition au plus k d'un mot indexé partage au moins |T(mot)| - 3k
+   * trigrammes avec lui : on s'en sert pour filtrer les candidats avant de les vérifier.
+   *
+   */
+   class IndexTrigrammes
+   {
+   public:
+
+      IndexTrigrammes() : nbRetires(0) { }
+
+      /**
+      * \brief Indexe les trigrammes de motIndexe sous le radical motRadical
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void ajouterMot(const std::string& motRadical, const std::string& motIndexe);
+
+      /**
+      * \brief Retire motRadical de l'index. Ses entrées restent dans les listes jusqu'à la
+      *        prochaine reconstruction mais ne sont plus jamais retournées.
+      */
+      void retirerRadical(const std::string& motRadical);
+
+      /**
+      * \brief Retourne les radicaux dont le radical ou une flexion partage suffisament de trigrammes
+      *        avec mot pour être à une distance d'édition d'au plus distanceMax.
+      *
+      * \post L'index reste inchangé.
+      * \return les radicaux candidats, sans ordre particulier. Ce sont des candidats seulement :
+      *         l'appelant doit les vérifier.
+      */
+      std::vector<std::string> candidats(const std::string& mot, int distanceMax) const;
+
+      /**
+      * \brief Indique si le filtrage est possible pour mot et distanceMax.
+      *        Quand il ne l'est pas, tous les radicaux sont des candidats.
+      */
+      bool peutFiltrer(const std::string& mot, int distanceMax) const;
+
+      /**
+      * \brief Vrai lorsque les entrées retirées occupent plus de place que les entrées vivantes
+      */
+      bool doitEtreReconstruit() const;
+
+      /**
+      * \brief Vide l'index
+      */
+      void vider();
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+   private:
+
+      static std::vector<std::uint32_t> trigrammes(const std::string& mot);
+
+      std::unordered_map<std::uint32_t, std::vector<std::uint32_t> > listes;   // Trigramme -> identifiants de radicaux (triés).
+      std::vector<std::string> radicaux;                                     // Identifiant -> radical ("" si retiré).
+      std::unordered_map<std::string, std::uint32_t> identifiants;          // Radical -> identifiant.
+      std::size_t nbRetires;                                                 // Nombre d'identifiants retirés.
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,591 @@
+/**
+* \file JournalDico.cpp
+* \brief Le code des opérateurs de JournalDico.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "JournalDico.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace TP3
+{
+
+    static const char MAGIE_JOURNAL[8] = { 'D', 'I', 'C', 'O', 'J', 'R', 'N', '1' };
+    static const std::size_t TAILLE_ENTETE_ENREGISTREMENT = 8;   // Longueur et CRC-32 de la suite.
+
+    /**
+    * \fn std::uint32_t crc32(const char* donnees, std::size_t taille)
+    * \brief CRC-32 (polynôme 0xEDB88320, celui de zlib) de donnees
+    */
+    static std::uint32_t crc32(const char* donnees, std::size_t taille)
+    {
+        static const std::vector<std::uint32_t> table = [] {
+            std::vector<std::uint32_t> t(256);
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < taille; ++i)
+            crc = table[(crc ^ static_cast<unsigned char>(donnees[i])) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFFu;
+    }
+
+    static void ajouterEntier(std::string& tampon, std::uint32_t valeur)
+    {
+        tampon.append(reinterpret_cast<const char*>(&valeur), sizeof(valeur));
+    }
+
+    static void ajouterChaine(std::string& tampon, const std::string& s)
+    {
+        ajouterEntier(tampon, s.size());
+        tampon += s;
+    }
+
+    static bool lireEntier(const char*& p, const char* fin, std::uint32_t& valeur)
+    {
+        if (static_cast<std::size_t>(fin - p) < sizeof(valeur)) return false;
+        std::memcpy(&valeur, p, sizeof(valeur));
+        p += sizeof(valeur);
+        return true;
+    }
+
+    static bool lireChaine(const char*& p, const char* fin, std::string& s)
+    {
+        std::uint32_t longueur;
+        if (!lireEntier(p, fin, longueur) || static_cast<std::size_t>(fin - p) < longueur) return false;
+        s.assign(p, longueur);
+        p += longueur;
+        return true;
+    }
+
+    /**
+    * \fn bool ecrireTout(int descripteur, const std::string& donnees)
+    * \brief Écrit donnees en entier, en reprenant après les écritures partielles
+    */
+    static bool ecrireTout(int descripteur, const std::string& donnees)
+    {
+        for (std::size_t ecrits = 0; ecrits < donnees.size(); )
+        {
+            ssize_t n = write(descripteur, donnees.data() + ecrits, donnees.size() - ecrits);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            ecrits += n;
+        }
+        return true;
+    }
+
+    /**
+    * \fn void synchroniserRepertoire(const std::string& repertoire)
+    * \brief Rend durables les créations, renommages et suppressions de fichiers dans repertoire
+    * \exception runtime_error si le répertoire ne peut pas être synchronisé
+    */
+    static void synchroniserRepertoire(const std::string& repertoire)
+    {
+        int descripteur = open(repertoire.c_str(), O_RDONLY | O_DIRECTORY);
+        bool synchronise = descripteur >= 0 && fsync(descripteur) == 0;
+        if (descripteur >= 0) close(descripteur);
+        if (!synchronise)
+            throw std::runtime_error("JournalDico : Impossible de synchroniser " + repertoire);
+    }
+
+    /**
+    * \fn bool numeroFichier(const char* nom, const char* prefixe, std::uint64_t& numero)
+    * \brief Vrai si nom est prefixe suivi seulement de chiffres ; numero reçoit ce nombre
+    */
+    static bool numeroFichier(const char* nom, const char* prefixe, std::uint64_t& numero)
+    {
+        std::size_t longueur = std::strlen(prefixe);
+        if (std::strncmp(nom, prefixe, longueur) != 0 || nom[longueur] < '0' || nom[longueur] > '9') return false;
+        char* fin;
+        numero = std::strtoull(nom + longueur, &fin, 10);
+        return *fin == '\0';
+    }
+
+    /**
+    * \fn void lireRepertoire(const std::string& repertoire, std::vector<std::uint64_t>& instantanes,
+    *                         std::vector<std::uint64_t>& segments, std::vector<std::string>& temporaires)
+    * \brief Numéros des points de contrôle et des segments de repertoire, en ordre croissant,
+    *        et noms des points de contrôle temporaires laissés par une écriture interrompue
+    * \exception runtime_error si le répertoire ne peut pas être lu
+    */
+    static void lireRepertoire(const std::string& repertoire, std::vector<std::uint64_t>& instantanes,
+                               std::vector<std::uint64_t>& segments, std::vector<std::string>& temporaires)
+    {
+        DIR* flux = opendir(repertoire.c_str());
+        if (flux == 0)
+            throw std::runtime_error("JournalDico : Impossible de lire " + repertoire);
+        while (dirent* entree = readdir(flux))
+        {
+            std::uint64_t numero;
+            std::string nom = entree->d_name;
+            if (numeroFichier(entree->d_name, "instantane.", numero)) instantanes.push_back(numero);
+            else if (numeroFichier(entree->d_name, "journal.", numero)) segments.push_back(numero);
+            else if (nom.compare(0, 11, "instantane.") == 0 && nom.size() > 15 && nom.compare(nom.size() - 4, 4, ".tmp") == 0)
+                temporaires.push_back(nom);
+        }
+        closedir(flux);
+        std::sort(instantanes.begin(), instantanes.end());
+        std::sort(segments.begin(), segments.end());
+    }
+
+    /**
+    * \brief Constructeur : ouvre (ou crée) le journal du répertoire repertoire
+    *
+    * \post Si le répertoire contient un point de contrôle, le contenu de dico est remplacé par
+    *       celui-ci et les segments suivants sont rejoués. Sinon, le contenu actuel de dico est
+    *       écrit comme premier point de contrôle.
+    *
+    * \exception runtime_error si le répertoire ne peut pas être lu ou écrit, ou si un segment
+    *            autre que le dernier est endommagé.
+    */
+    JournalDico::JournalDico(DicoSynonymes& dico, const std::string& repertoire, std::size_t tailleMaxSegment)
+        : dico(dico), repertoire(repertoire), tailleMaxSegment(tailleMaxSegment), nbRejoues(0), descripteur(-1),
+          numeroSegment(0), octetsSegment(0), dernierNumero(0), numeroDurable(0), vidageEnCours(false),
+          defaillance(false), pointDeControleEnCours(false)
+    {
+        ouvrir();
+    }
+
+    /**
+    * \brief Destructeur. Attend le point de contrôle en cours et ferme le segment courant.
+    */
+    JournalDico::~JournalDico()
+    {
+        std::lock_guard<std::mutex> garde(verrou);
+        if (filPointDeControle.joinable()) filPointDeControle.join();
+        if (descripteur >= 0) close(descripteur);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::ajouterRadical
+    *
+    * \post La modification est sur disque.
+    */
+    void JournalDico::ajouterRadical(const std::string& motRadical)
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+        dico.ajouterRadical(motRadical);
+        journaliser(garde, AjoutRadical, motRadical, std::string(), 0);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::ajouterFlexion et ajouterRadical
+    */
+    void JournalDico::ajouterFlexion(const std::string& motRadical, const std::string& motFlexion)
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+        dico.ajouterFlexion(motRadical, motFlexion);
+        journaliser(garde, AjoutFlexion, motRadical, motFlexion, 0);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::ajouterSynonyme et ajouterRadical
+    */
+    void JournalDico::ajouterSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe)
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+
+        // le numéro demandé (-1 pour un nouveau groupe) est rejoué tel quel : il redonne le même groupe
+        int numGroupeDemande = numGroupe;
+        bool synonymeAbsent = !dico.contientRadical(motSynonyme);
+        try
+        {
+            dico.ajouterSynonyme(motRadical, motSynonyme, numGroupe);
+        }
+        catch (const std::logic_error&)
+        {
+            // ajouterSynonyme peut avoir ajouté le synonyme comme radical avant d'échouer
+            if (synonymeAbsent && dico.contientRadical(motSynonyme))
+                journaliser(garde, AjoutRadical, motSynonyme, std::string(), 0);
+            throw;
+        }
+        journaliser(garde, AjoutSynonyme, motRadical, motSynonyme, numGroupeDemande);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::supprimerRadical et ajouterRadical
+    */
+    void JournalDico::supprimerRadical(const std::string& motRadical)
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+        dico.supprimerRadical(motRadical);
+        journaliser(garde, SuppressionRadical, motRadical, std::string(), 0);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::supprimerFlexion et ajouterRadical
+    */
+    void JournalDico::supprimerFlexion(const std::string& motRadical, const std::string& motFlexion)
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+        dico.supprimerFlexion(motRadical, motFlexion);
+        journaliser(garde, SuppressionFlexion, motRadical, motFlexion, 0);
+    }
+
+    /**
+    * \brief Voir DicoSynonymes::supprimerSynonyme et ajouterRadical
+    */
+    void JournalDico::supprimerSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe)
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+        dico.supprimerSynonyme(motRadical, motSynonyme, numGroupe);
+        journaliser(garde, SuppressionSynonyme, motRadical, motSynonyme, numGroupe);
+    }
+
+    /**
+    * \brief Commence un nouveau segment et écrit un point de contrôle dans un autre fil,
+    *        après avoir attendu la fin du point de contrôle précédent
+    *
+    * \exception runtime_error si le nouveau segment ne peut pas être créé.
+    */
+    void JournalDico::lancerPointDeControle()
+    {
+        std::unique_lock<std::mutex> garde(verrou);
+        verifierEtat();
+        changerDeSegment(garde);
+    }
+
+    /**
+    * \brief Attend la fin du point de contrôle en cours, s'il y en a un
+    *
+    * \exception runtime_error si ce point de contrôle a échoué.
+    */
+    void JournalDico::attendrePointDeControle()
+    {
+        std::lock_guard<std::mutex> garde(verrou);
+        if (filPointDeControle.joinable()) filPointDeControle.join();
+        if (erreurPointDeControle)
+        {
+            std::exception_ptr erreur = erreurPointDeControle;
+            erreurPointDeControle = nullptr;
+            std::rethrow_exception(erreur);
+        }
+    }
+
+    /**
+    * \fn std::string chemin(const char* prefixe, std::uint64_t numero) const
+    * \brief Chemin du fichier prefixe.numero du répertoire du journal
+    */
+    std::string JournalDico::chemin(const char* prefixe, std::uint64_t numero) const
+    {
+        return repertoire + "/" + prefixe + std::to_string(numero);
+    }
+
+    /**
+    * \fn void ouvrir()
+    * \brief Restaure le dernier point de contrôle (ou écrit le premier), rejoue les segments
+    *        suivants et ouvre le dernier en ajout
+    */
+    void JournalDico::ouvrir()
+    {
+        if (mkdir(repertoire.c_str(), 0755) != 0 && errno != EEXIST)
+            throw std::runtime_error("JournalDico : Impossible de créer " + repertoire);
+
+        std::vector<std::uint64_t> instantanes, segments;
+        std::vector<std::string> temporaires;
+        lireRepertoire(repertoire, instantanes, segments, temporaires);
+        for (auto &nom : temporaires) unlink((repertoire + "/" + nom).c_str());
+
+        std::uint64_t premier = 0;
+        if (instantanes.empty())
+        {
+            if (!segments.empty())
+                throw std::runtime_error("JournalDico : Segments sans point de contrôle dans " + repertoire);
+            ImageDico::ecrire(ImageDico::construire(dico), chemin("instantane.", 0), true);
+        }
+        else
+        {
+            premier = instantanes.back();
+            ImageDico::ouvrirFichier(chemin("instantane.", premier)).restaurer(dico);
+        }
+
+        // les fichiers plus anciens que le point de contrôle restent d'un nettoyage interrompu
+        for (auto numero : instantanes)
+            if (numero < premier) unlink(chemin("instantane.", numero).c_str());
+        for (auto numero : segments)
+            if (numero < premier) unlink(chemin("journal.", numero).c_str());
+        segments.erase(segments.begin(), std::lower_bound(segments.begin(), segments.end(), premier));
+
+        for (auto numero : segments) nbRejoues += rejouerSegment(chemin("journal.", numero), numero == segments.back());
+
+        if (segments.empty())
+        {
+            numeroSegment = premier;
+            descripteur = creerSegment(numeroSegment);
+            octetsSegment = sizeof(MAGIE_JOURNAL);
+        }
+        else
+        {
+            numeroSegment = segments.back();
+            descripteur = open(chemin("journal.", numeroSegment).c_str(), O_WRONLY | O_APPEND);
+            struct stat infos;
+            if (descripteur < 0 || fstat(descripteur, &infos) != 0)
+                throw std::runtime_error("JournalDico : Impossible d'ouvrir " + chemin("journal.", numeroSegment));
+            octetsSegment = infos.st_size;
+        }
+    }
+
+    /**
+    * \fn std::size_t rejouerSegment(const std::string& cheminSegment, bool dernier)
+    * \brief Applique à dico les enregistrements du segment. Le dernier segment est tronqué après
+    *        son dernier enregistrement complet : seule son écriture a pu être interrompue.
+    * \return le nombre d'enregistrements rejoués
+    * \exception runtime_error si le segment ne peut pas être lu, si un segment autre que le dernier
+    *            est incomplet, ou si un enregistrement complet ne peut pas être rejoué
+    */
+    std::size_t JournalDico::rejouerSegment(const std::string& cheminSegment, bool dernier)
+    {
+        std::ifstream fichier(cheminSegment, std::ios::binary);
+        if (!fichier)
+            throw std::runtime_error("JournalDico : Impossible de lire " + cheminSegment);
+        std::string contenu((std::istreambuf_iterator<char>(fichier)), std::istreambuf_iterator<char>());
+
+        // un segment sans entête complète a été interrompu à sa création : il est refait vide
+        if (contenu.size() < sizeof(MAGIE_JOURNAL) || std::memcmp(contenu.data(), MAGIE_JOURNAL, sizeof(MAGIE_JOURNAL)) != 0)
+        {
+            if (!dernier)
+                throw std::runtime_error("JournalDico : Segment endommagé " + cheminSegment);
+            std::ofstream vide(cheminSegment, std::ios::binary | std::ios::trunc);
+            if (!vide.write(MAGIE_JOURNAL, sizeof(MAGIE_JOURNAL)) || !(vide.close(), vide))
+                throw std::runtime_error("JournalDico : Impossible de réparer " + cheminSegment);
+            return 0;
+        }
+
+        std::size_t nbEnregistrements = 0;
+        const char* p = contenu.data() + sizeof(MAGIE_JOURNAL);
+        const char* fin = contenu.data() + contenu.size();
+        while (true)
+        {
+            const char* debut = p;
+            std::uint32_t longueur, crc;
+            if (!lireEntier(p, fin, longueur) || !lireEntier(p, fin, crc)
+                || static_cast<std::size_t>(fin - p) < longueur || longueur == 0 || crc32(p, longueur) != crc)
+            {
+                p = debut;
+                break;
+            }
+
+            const char* finEnregistrement = p + longueur;
+            TypeEnregistrement type = static_cast<TypeEnregistrement>(*p++);
+            std::string motRadical, mot;
+            std::uint32_t numGroupe = 0;
+            bool complet = lireChaine(p, finEnregistrement, motRadical);
+            if (type == AjoutFlexion || type == SuppressionFlexion || type == AjoutSynonyme || type == SuppressionSynonyme)
+                complet = complet && lireChaine(p, finEnregistrement, mot);
+            if (type == AjoutSynonyme || type == SuppressionSynonyme)
+                complet = complet && lireEntier(p, finEnregistrement, numGroupe);
+            if (!complet || p != finEnregistrement || type < AjoutRadical || type > SuppressionSynonyme)
+                throw std::runtime_error("JournalDico : Enregistrement invalide dans " + cheminSegment);
+
+            try
+            {
+                appliquer(type, motRadical, mot, static_cast<int>(numGroupe));
+            }
+            catch (const std::logic_error& e)
+            {
+                throw std::runtime_error("JournalDico : Enregistrement impossible à rejouer dans " + cheminSegment
+                                         + " (" + e.what() + ")");
+            }
+            ++nbEnregistrements;
+        }
+
+        // la fin d'un enregistrement interrompu est retirée : les prochains ajouts la remplacent
+        std::size_t longueurValide = p - contenu.data();
+        if (longueurValide < contenu.size() && !dernier)
+            throw std::runtime_error("JournalDico : Segment endommagé " + cheminSegment);
+        if (longueurValide < contenu.size() && truncate(cheminSegment.c_str(), longueurValide) != 0)
+            throw std::runtime_error("JournalDico : Impossible de tronquer " + cheminSegment);
+        return nbEnregistrements;
+    }
+
+    /**
+    * \fn void appliquer(TypeEnregistrement type, const std::string& motRadical, const std::string& mot, int numGroupe)
+    * \brief Applique à dico la modification décrite par un enregistrement
+    */
+    void JournalDico::appliquer(TypeEnregistrement type, const std::string& motRadical, const std::string& mot, int numGroupe)
+    {
+        switch (type)
+        {
+        case AjoutRadical: dico.ajouterRadical(motRadical); break;
+        case AjoutFlexion: dico.ajouterFlexion(motRadical, mot); break;
+        case AjoutSynonyme: dico.ajouterSynonyme(motRadical, mot, numGroupe); break;
+        case SuppressionRadical: dico.supprimerRadical(motRadical); break;
+        case SuppressionFlexion: dico.supprimerFlexion(motRadical, mot); break;
+        case SuppressionSynonyme: dico.supprimerSynonyme(motRadical, mot, numGroupe); break;
+        }
+    }
+
+    /**
+    * \fn int creerSegment(std::uint64_t numero)
+    * \brief Crée le segment numero (vide, avec son entête) sur disque et l'ouvre en ajout
+    * \return le descripteur du segment
+    * \exception runtime_error si le segment ne peut pas être créé
+    */
+    int JournalDico::creerSegment(std::uint64_t numero)
+    {
+        std::string cheminSegment = chemin("journal.", numero);
+        int nouveau = open(cheminSegment.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        if (nouveau < 0)
+            throw std::runtime_error("JournalDico : Impossible de créer " + cheminSegment);
+        if (!ecrireTout(nouveau, std::string(MAGIE_JOURNAL, sizeof(MAGIE_JOURNAL))) || fdatasync(nouveau) != 0)
+        {
+            close(nouveau);
+            throw std::runtime_error("JournalDico : Impossible d'écrire " + cheminSegment);
+        }
+        synchroniserRepertoire(repertoire);
+        return nouveau;
+    }
+
+    /**
+    * \fn void journaliser(std::unique_lock<std::mutex>& garde, TypeEnregistrement type,
+    *                      const std::string& motRadical, const std::string& mot, int numGroupe)
+    * \brief Ajoute l'enregistrement d'une modification déjà appliquée et attend qu'il soit sur disque ;
+    *        commence un point de contrôle si le segment courant est plein
+    */
+    void JournalDico::journaliser(std::unique_lock<std::mutex>& garde, TypeEnregistrement type,
+                                  const std::string& motRadical, const std::string& mot, int numGroupe)
+    {
+        std::string enregistrement(TAILLE_ENTETE_ENREGISTREMENT, '\0');
+        enregistrement += static_cast<char>(type);
+        ajouterChaine(enregistrement, motRadical);
+        if (type == AjoutFlexion || type == SuppressionFlexion || type == AjoutSynonyme || type == SuppressionSynonyme)
+            ajouterChaine(enregistrement, mot);
+        if (type == AjoutSynonyme || type == SuppressionSynonyme)
+            ajouterEntier(enregistrement, static_cast<std::uint32_t>(numGroupe));
+
+        std::uint32_t longueur = enregistrement.size() - TAILLE_ENTETE_ENREGISTREMENT;
+        std::uint32_t crc = crc32(enregistrement.data() + TAILLE_ENTETE_ENREGISTREMENT, longueur);
+        std::memcpy(&enregistrement[0], &longueur, sizeof(longueur));
+        std::memcpy(&enregistrement[sizeof(longueur)], &crc, sizeof(crc));
+
+        tampon += enregistrement;
+        octetsSegment += enregistrement.size();
+        attendreDurabilite(garde, ++dernierNumero);
+
+        if (octetsSegment >= tailleMaxSegment && !pointDeControleEnCours) changerDeSegment(garde);
+    }
+
+    /**
+    * \fn void attendreDurabilite(std::unique_lock<std::mutex>& garde, std::uint64_t numero)
+    * \brief Attend que l'enregistrement numero soit sur disque. Si aucun fil n'écrit le tampon,
+    *        ce fil l'écrit en entier, verrou relâché : les enregistrements ajoutés pendant ce temps
+    *        par les autres fils partiront ensemble à l'écriture suivante.
+    * \exception runtime_error si l'écriture échoue
+    */
+    void JournalDico::attendreDurabilite(std::unique_lock<std::mutex>& garde, std::uint64_t numero)
+    {
+        while (numeroDurable < numero)
+        {
+            verifierEtat();
+            if (vidageEnCours)
+            {
+                vidage.wait(garde);
+                continue;
+            }
+
+            vidageEnCours = true;
+            std::string lot;
+            lot.swap(tampon);
+            std::uint64_t jusqua = dernierNumero;
+            int segment = descripteur;
+
+            garde.unlock();
+            bool reussi = ecrireTout(segment, lot) && fdatasync(segment) == 0;
+            garde.lock();
+
+            vidageEnCours = false;
+            if (reussi) numeroDurable = jusqua;
+            else defaillance = true;
+            // la capacité du lot sert au tampon suivant s'il est encore vide
+            lot.clear();
+            if (tampon.empty()) tampon.swap(lot);
+            vidage.notify_all();
+        }
+    }
+
+    /**
+    * \fn void verifierEtat() const
+    * \brief Lance runtime_error si une écriture du journal a déjà échoué
+    */
+    void JournalDico::verifierEtat() const
+    {
+        if (defaillance)
+            throw std::runtime_error("JournalDico : Une écriture a échoué, le journal n'accepte plus de modification");
+    }
+
+    /**
+    * \fn void changerDeSegment(std::unique_lock<std::mutex>& garde)
+    * \brief Écrit le tampon, construit l'image de dico, commence le segment suivant, puis lance
+    *        l'écriture du point de contrôle correspondant dans un autre fil
+    */
+    void JournalDico::changerDeSegment(std::unique_lock<std::mutex>& garde)
+    {
+        attendreDurabilite(garde, dernierNumero);
+        if (filPointDeControle.joinable()) filPointDeControle.join();
+
+        // verrou tenu : l'image contient exactement les segments précédents
+        std::vector<char> image = ImageDico::construire(dico);
+        std::uint64_t numero = numeroSegment + 1;
+        int nouveau = creerSegment(numero);
+        close(descripteur);
+        descripteur = nouveau;
+        numeroSegment = numero;
+        octetsSegment = sizeof(MAGIE_JOURNAL);
+
+        erreurPointDeControle = nullptr;
+        pointDeControleEnCours = true;
+        filPointDeControle = std::thread(&JournalDico::ecrirePointDeControle, this, std::move(image), numero);
+    }
+
+    /**
+    * \fn void ecrirePointDeControle(const std::vector<char>& image, std::uint64_t numero)
+    * \brief Écrit le point de contrôle numero, puis efface les points de contrôle et segments
+    *        précédents. Exécutée dans filPointDeControle, sans prendre verrou.
+    */
+    void JournalDico::ecrirePointDeControle(const std::vector<char>& image, std::uint64_t numero)
+    {
+        try
+        {
+            ImageDico::ecrire(image, chemin("instantane.", numero), true);
+
+            std::vector<std::uint64_t> instantanes, segments;
+            std::vector<std::string> temporaires;
+            lireRepertoire(repertoire, instantanes, segments, temporaires);
+            for (auto ancien : instantanes)
+                if (ancien < numero) unlink(chemin("instantane.", ancien).c_str());
+            for (auto ancien : segments)
+                if (ancien < numero) unlink(chemin("journal.", ancien).c_str());
+        }
+        catch (...)
+        {
+            erreurPointDeControle = std::current_exception();
+        }
+        pointDeControleEnCours = false;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,174 @@
+/**
+* \file JournalDico.h
+* \brief Interface du type JournalDico
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+
+#include "DicoSynonymes.h"
+#include "ImageDico.h"
+
+#ifndef _JOURNALDICO__H
+#define _JOURNALDICO__H
+
+namespace TP3
+{
+
+   /**
+   * \class JournalDico
+   *
+   * \brief Rend durables les modifications d'un DicoSynonymes par un journal en ajout seulement.
+   *
+   * Le répertoire du journal contient un point de contrôle instantane.N (une ImageDico du
+   * dictionnaire) et les segments journal.N, journal.N+1, ... des modifications faites depuis.
+   * Chaque modification est appliquée au dictionnaire, puis ajoutée au segment courant sous la
+   * forme d'un enregistrement binaire (longueur, CRC-32, type, arguments) ; l'appel ne retourne
+   * qu'une fois l'enregistrement sur disque. Les enregistrements des appels simultanés sont écrits
+   * ensemble et synchronisés par un seul fdatasync (validation groupée).
+   *
+   * À l'ouverture, le dernier point de contrôle est restauré puis les segments sont rejoués ; un
+   * enregistrement incomplet à la fin du dernier segment (écriture interrompue) est tronqué.
+   * Quand le segment courant dépasse tailleMaxSegment, un nouveau segment est commencé et un
+   * point de contrôle est écrit dans un autre fil ; les fichiers plus anciens sont ensuite effacés.
+   *
+   * Les lectures du dictionnaire ne doivent pas être simultanées aux modifications.
+   *
+   */
+   class JournalDico
+   {
+   public:
+
+      /**
+      * \brief Constructeur : ouvre (ou crée) le journal du répertoire repertoire
+      *
+      * \post Si le répertoire contient un point de contrôle, le contenu de dico est remplacé par
+      *       celui-ci et les segments suivants sont rejoués. Sinon, le contenu actuel de dico est
+      *       écrit comme premier point de contrôle.
+      *
+      * \exception runtime_error si le répertoire ne peut pas être lu ou écrit, ou si un segment
+      *            autre que le dernier est endommagé.
+      */
+      JournalDico(DicoSynonymes& dico, const std::string& repertoire, std::size_t tailleMaxSegment = 64 << 20);
+
+      /**
+      * \brief Destructeur. Attend le point de contrôle en cours et ferme le segment courant.
+      */
+      ~JournalDico();
+
+      JournalDico(const JournalDico&) = delete;
+      JournalDico& operator=(const JournalDico&) = delete;
+
+      /**
+      * \brief Voir DicoSynonymes::ajouterRadical
+      *
+      * \post La modification est sur disque.
+      *
+      * \exception logic_error dans les mêmes cas que DicoSynonymes::ajouterRadical ; rien n'est journalisé.
+      * \exception runtime_error si le journal ne peut pas être écrit. La modification reste appliquée
+      *            en mémoire mais n'est pas durable, et toute modification suivante est refusée.
+      */
+      void ajouterRadical(const std::string& motRadical);
+
+      /**
+      * \brief Voir DicoSynonymes::ajouterFlexion et ajouterRadical
+      */
+      void ajouterFlexion(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Voir DicoSynonymes::ajouterSynonyme et ajouterRadical
+      */
+      void ajouterSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe);
+
+      /**
+      * \brief Voir DicoSynonymes::supprimerRadical et ajouterRadical
+      */
+      void supprimerRadical(const std::string& motRadical);
+
+      /**
+      * \brief Voir DicoSynonymes::supprimerFlexion et ajouterRadical
+      */
+      void supprimerFlexion(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Voir DicoSynonymes::supprimerSynonyme et ajouterRadical
+      */
+      void supprimerSynonyme(const std::string& motRadical, const std::string& motSynonyme, int& numGroupe);
+
+      /**
+      * \brief Commence un nouveau segment et écrit un point de contrôle dans un autre fil,
+      *        après avoir attendu la fin du point de contrôle précédent
+      *
+      * \exception runtime_error si le nouveau segment ne peut pas être créé.
+      */
+      void lancerPointDeControle();
+
+      /**
+      * \brief Attend la fin du point de contrôle en cours, s'il y en a un
+      *
+      * \exception runtime_error si ce point de contrôle a échoué. Les fichiers précédents sont
+      *            alors conservés : le journal reste complet.
+      */
+      void attendrePointDeControle();
+
+      /**
+      * \brief Nombre d'enregistrements rejoués à l'ouverture
+      */
+      std::size_t nombreRejoues() const { return nbRejoues; }
+
+   private:
+
+      enum TypeEnregistrement : std::uint8_t
+      {
+         AjoutRadical = 1, AjoutFlexion, AjoutSynonyme, SuppressionRadical, SuppressionFlexion, SuppressionSynonyme
+      };
+
+      std::string chemin(const char* prefixe, std::uint64_t numero) const;
+      void ouvrir();
+      std::size_t rejouerSegment(const std::string& cheminSegment, bool dernier);
+      void appliquer(TypeEnregistrement type, const std::string& motRadical, const std::string& mot, int numGroupe);
+      int creerSegment(std::uint64_t numero);
+      void journaliser(std::unique_lock<std::mutex>& garde, TypeEnregistrement type, const std::string& motRadical,
+                       const std::string& mot, int numGroupe);
+      void attendreDurabilite(std::unique_lock<std::mutex>& garde, std::uint64_t numero);
+      void verifierEtat() const;
+      void changerDeSegment(std::unique_lock<std::mutex>& garde);
+      void ecrirePointDeControle(const std::vector<char>& image, std::uint64_t numero);
+
+      DicoSynonymes& dico;
+      std::string repertoire;
+      std::size_t tailleMaxSegment;
+      std::size_t nbRejoues;
+
+      std::mutex verrou;                      // Protège dico et tout ce qui suit.
+      std::condition_variable vidage;         // Signalé à la fin de chaque écriture du tampon.
+      int descripteur;                        // Segment courant, ouvert en ajout.
+      std::uint64_t numeroSegment;
+      std::size_t octetsSegment;
+      std::string tampon;                     // Enregistrements pas encore écrits.
+      std::uint64_t dernierNumero;            // Numéro du dernier enregistrement ajouté au tampon.
+      std::uint64_t numeroDurable;            // Les enregistrements jusqu'à celui-ci sont sur disque.
+      bool vidageEnCours;                     // Un fil écrit le tampon, verrou relâché.
+      bool defaillance;                       // Une écriture a échoué : le journal refuse les modifications.
+
+      std::thread filPointDeControle;         // Ne prend jamais verrou : on peut l'attendre en le tenant.
+      std::atomic<bool> pointDeControleEnCours;
+      std::exception_ptr erreurPointDeControle;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,231 @@
+/**
+* \file ListeFlexions.cpp
+* \brief Le code des opérateurs de ListeFlexions.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "ListeFlexions.h"
+
+#include <cstring>
+#include <algorithm>
+
+namespace TP3
+{
+
+    /**
+    * \brief Constructeur de copie : le tampon n'est alloué que s'il ne tient pas dans l'objet
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    ListeFlexions::ListeFlexions(const ListeFlexions& source)
+        : longueur(source.longueur), capacite(0), nbFlexions(source.nbFlexions)
+    {
+        if (longueur > CAPACITE_INTERNE)
+        {
+            externe = new char[longueur];
+            capacite = longueur;
+        }
+        std::memcpy(donnees(), source.donnees(), longueur);
+    }
+
+    /**
+    * \brief Constructeur de déplacement : source reste vide
+    */
+    ListeFlexions::ListeFlexions(ListeFlexions&& source) noexcept
+        : longueur(source.longueur), capacite(source.capacite), nbFlexions(source.nbFlexions)
+    {
+        if (capacite) externe = source.externe;
+        else std::memcpy(interne, source.interne, longueur);
+        source.longueur = source.capacite = source.nbFlexions = 0;
+    }
+
+    /**
+    * \brief Destructeur
+    */
+    ListeFlexions::~ListeFlexions()
+    {
+        if (capacite) delete[] externe;
+    }
+
+    /**
+    * \brief Affectation par copie
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    ListeFlexions& ListeFlexions::operator=(const ListeFlexions& source)
+    {
+        if (this != &source)
+        {
+            ListeFlexions copie(source);
+            *this = std::move(copie);
+        }
+        return *this;
+    }
+
+    /**
+    * \brief Affectation par déplacement : source reste vide
+    */
+    ListeFlexions& ListeFlexions::operator=(ListeFlexions&& source) noexcept
+    {
+        if (this != &source)
+        {
+            if (capacite) delete[] externe;
+            longueur = source.longueur;
+            capacite = source.capacite;
+            nbFlexions = source.nbFlexions;
+            if (capacite) externe = source.externe;
+            else std::memcpy(interne, source.interne, longueur);
+            source.longueur = source.capacite = source.nbFlexions = 0;
+        }
+        return *this;
+    }
+
+    /**
+    * \brief Vérifie si motFlexion fait partie de la liste
+    *
+    * \post La liste reste inchangée.
+    */
+    bool ListeFlexions::contient(std::string_view motFlexion) const
+    {
+        return trouver(motFlexion) != std::string::npos;
+    }
+
+    /**
+    * \brief Ajoute motFlexion à la fin de la liste
+    *
+    * \post La flexion est ajoutée si elle n'était pas déjà présente.
+    * \return vrai si la flexion a été ajoutée, faux si elle était déjà présente.
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    bool ListeFlexions::ajouter(std::string_view motFlexion)
+    {
+        if (contient(motFlexion)) return false;
+
+        char prefixe[10];
+        std::size_t taillePrefixe = 0;
+        for (std::size_t valeur = motFlexion.size(); ; valeur >>= 7)
+        {
+            prefixe[taillePrefixe++] = static_cast<char>((valeur & 0x7F) | (valeur >= 0x80 ? 0x80 : 0));
+            if (valeur < 0x80) break;
+        }
+
+        reserver(longueur + taillePrefixe + motFlexion.size());
+        char* fin = donnees() + longueur;
+        std::memcpy(fin, prefixe, taillePrefixe);
+        std::memcpy(fin + taillePrefixe, motFlexion.data(), motFlexion.size());
+        longueur += taillePrefixe + motFlexion.size();
+        ++nbFlexions;
+        return true;
+    }
+
+    /**
+    * \brief Retire motFlexion de la liste
+    *
+    * \return vrai si la flexion a été retirée, faux si elle n'était pas présente.
+    */
+    bool ListeFlexions::retirer(std::string_view motFlexion)
+    {
+        std::size_t position = trouver(motFlexion);
+        if (position == std::string::npos) return false;
+
+        char* debut = donnees() + position;
+        const char* suivante = debut;
+        suivante += lireLongueur(suivante);
+        std::memmove(debut, suivante, donnees() + longueur - suivante);
+        longueur -= suivante - debut;
+        --nbFlexions;
+        return true;
+    }
+
+    /**
+    * \brief Retire toutes les flexions de la liste
+    */
+    void ListeFlexions::vider()
+    {
+        longueur = 0;
+        nbFlexions = 0;
+    }
+
+    /**
+    * \brief Libère la capacité inutilisée du tampon, qui redevient interne s'il y tient
+    */
+    void ListeFlexions::compacter()
+    {
+        if (capacite == 0 || capacite == longueur) return;
+
+        char* ancien = externe;
+        if (longueur <= CAPACITE_INTERNE)
+        {
+            std::memcpy(interne, ancien, longueur);
+            capacite = 0;
+        }
+        else
+        {
+            externe = new char[longueur];
+            std::memcpy(externe, ancien, longueur);
+            capacite = longueur;
+        }
+        delete[] ancien;
+    }
+
+    /**
+    * \brief Retourne une copie des flexions dans l'ordre d'insertion
+    */
+    std::vector<std::string> ListeFlexions::versVecteur() const
+    {
+        std::vector<std::string> flexions;
+        flexions.reserve(nbFlexions);
+        for (auto flexion : *this)
+            flexions.emplace_back(flexion);
+        return flexions;
+    }
+
+    /**
+    * \fn void reserver(std::size_t minimum)
+    * \brief Agrandit le tampon pour qu'il contienne au moins minimum octets (la capacité double)
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    void ListeFlexions::reserver(std::size_t minimum)
+    {
+        std::size_t disponible = capacite ? capacite : CAPACITE_INTERNE;
+        if (minimum <= disponible) return;
+        if (minimum > UINT32_MAX)
+            throw std::length_error("ListeFlexions::ajouter : Les flexions dépassent 4 Go");
+
+        std::size_t nouvelle = std::min<std::size_t>(std::max(minimum, 2 * disponible), UINT32_MAX);
+        char* tampon = new char[nouvelle];
+        std::memcpy(tampon, donnees(), longueur);
+        if (capacite) delete[] externe;
+        externe = tampon;
+        capacite = static_cast<std::uint32_t>(nouvelle);
+    }
+
+    /**
+    * \fn std::size_t trouver(std::string_view motFlexion) const
+    * \brief Cherche motFlexion dans le tampon. Seules les entrées de même longueur sont comparées.
+    * \param[in] motFlexion la flexion à chercher
+    * \return la position de la longueur de la flexion, ou std::string::npos si elle est absente
+    */
+    std::size_t ListeFlexions::trouver(std::string_view motFlexion) const
+    {
+        const char* debut = donnees();
+        const char* fin = debut + longueur;
+
+        for (const char* p = debut; p < fin; )
+        {
+            const char* entree = p;
+            std::size_t taille = lireLongueur(p);
+            if (taille == motFlexion.size() && std::memcmp(p, motFlexion.data(), taille) == 0)
+                return entree - debut;
+            p += taille;
+        }
+        return std::string::npos;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,175 @@
+/**
+* \file ListeFlexions.h
+* \brief Interface du type ListeFlexions
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+#include "Memoire.h"
+
+#ifndef _LISTEFLEXIONS__H
+#define _LISTEFLEXIONS__H
+
+namespace TP3
+{
+
+   /**
+   * \class ListeFlexions
+   *
+   * \brief Conteneur compact des flexions d'un radical.
+   *
+   * Les flexions sont emmagasinées bout à bout dans un seul tampon contigu, chacune précédée
+   * de sa longueur en entier variable (7 bits par octet : un octet jusqu'à 127 caractères).
+   * Tant que le tampon tient dans CAPACITE_INTERNE octets, il loge dans l'objet lui-même et
+   * aucune allocation n'est faite (4 ou 5 flexions ordinaires) ; sinon il n'y a qu'une seule
+   * allocation par noeud au lieu d'une par flexion.
+   *
+   */
+   class ListeFlexions
+   {
+   public:
+
+      static constexpr std::size_t CAPACITE_INTERNE = 48;
+
+      /**
+      * \class const_iterator
+      *
+      * \brief Itérateur en lecture sur les flexions, retourne des std::string_view dans le tampon.
+      *
+      */
+      class const_iterator
+      {
+      public:
+         using iterator_category = std::forward_iterator_tag;
+         using value_type = std::string_view;
+         using difference_type = std::ptrdiff_t;
+         using pointer = const std::string_view*;
+         using reference = std::string_view;
+
+         const_iterator() : position(0) { }
+         explicit const_iterator(const char* p) : position(p) { }
+
+         std::string_view operator*() const
+         {
+            const char* p = position;
+            std::size_t longueur = lireLongueur(p);
+            return std::string_view(p, longueur);
+         }
+         const_iterator& operator++()
+         {
+            std::size_t longueur = lireLongueur(position);
+            position += longueur;
+            return *this;
+         }
+         const_iterator operator++(int) { const_iterator copie = *this; ++(*this); return copie; }
+         bool operator==(const const_iterator& autre) const { return position == autre.position; }
+         bool operator!=(const const_iterator& autre) const { return position != autre.position; }
+
+      private:
+         const char* position;   // Pointe sur la longueur de la flexion courante.
+      };
+
+      ListeFlexions() : longueur(0), capacite(0), nbFlexions(0) { }
+      ListeFlexions(const ListeFlexions& source);
+      ListeFlexions(ListeFlexions&& source) noexcept;
+      ~ListeFlexions();
+
+      ListeFlexions& operator=(const ListeFlexions& source);
+      ListeFlexions& operator=(ListeFlexions&& source) noexcept;
+
+      /**
+      * \brief Vérifie si motFlexion fait partie de la liste
+      *
+      * \post La liste reste inchangée.
+      */
+      bool contient(std::string_view motFlexion) const;
+
+      /**
+      * \brief Ajoute motFlexion à la fin de la liste
+      *
+      * \post La flexion est ajoutée si elle n'était pas déjà présente.
+      * \return vrai si la flexion a été ajoutée, faux si elle était déjà présente.
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      bool ajouter(std::string_view motFlexion);
+
+      /**
+      * \brief Retire motFlexion de la liste
+      *
+      * \return vrai si la flexion a été retirée, faux si elle n'était pas présente.
+      */
+      bool retirer(std::string_view motFlexion);
+
+      /**
+      * \brief Retire toutes les flexions de la liste
+      */
+      void vider();
+
+      std::size_t taille() const { return nbFlexions; }
+      bool estVide() const { return nbFlexions == 0; }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h) : rien tant que le tampon est interne
+      */
+      std::size_t memoire() const { return capacite; }
+
+      /**
+      * \brief Libère la capacité inutilisée du tampon, qui redevient interne s'il y tient
+      */
+      void compacter();
+
+      /**
+      * \brief Retourne une copie des flexions dans l'ordre d'insertion
+      */
+      std::vector<std::string> versVecteur() const;
+
+      const_iterator begin() const { return const_iterator(donnees()); }
+      const_iterator end() const { return const_iterator(donnees() + longueur); }
+
+   private:
+
+      /**
+      * \brief Lit la longueur en entier variable qui commence à p et avance p sur la flexion
+      */
+      static std::size_t lireLongueur(const char*& p)
+      {
+         std::size_t valeur = 0;
+         for (int decalage = 0; ; decalage += 7)
+         {
+            unsigned char octet = *p++;
+            valeur |= static_cast<std::size_t>(octet & 0x7F) << decalage;
+            if (!(octet & 0x80)) return valeur;
+         }
+      }
+
+      const char* donnees() const { return capacite ? externe : interne; }
+      char* donnees() { return capacite ? externe : interne; }
+      void reserver(std::size_t minimum);
+      std::size_t trouver(std::string_view motFlexion) const;
+
+      union
+      {
+         char interne[CAPACITE_INTERNE];   // Le tampon, quand capacite vaut 0.
+         char* externe;                    // Le tampon alloué, de capacite octets, sinon.
+      };
+      std::uint32_t longueur;      // Octets utilisés dans le tampon.
+      std::uint32_t capacite;      // Taille du tampon alloué, 0 si le tampon est interne.
+      std::uint32_t nbFlexions;    // Nombre de flexions dans le tampon.
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,69 @@
+/**
+* \file Memoire.h
+* \brief Estimation de la mémoire occupée par les conteneurs de la bibliothèque standard
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+* Les fonctions ne comptent que la mémoire allouée sur le tas par le conteneur, pas l'objet
+* conteneur lui-même (qui est compté dans l'objet qui le contient). Les tailles des noeuds
+* de list et de unordered_map sont celles des implantations usuelles (deux pointeurs par
+* noeud de list ; un pointeur et le hachage par noeud de unordered_map).
+*
+*/
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+#ifndef _MEMOIRE__H
+#define _MEMOIRE__H
+
+namespace TP3
+{
+
+   /**
+   * \brief Octets alloués sur le tas par s : rien si la chaîne est assez courte pour tenir dans l'objet
+   */
+   inline std::size_t octetsChaine(const std::string& s)
+   {
+      const char* debutObjet = reinterpret_cast<const char*>(&s);
+      if (s.data() >= debutObjet && s.data() < debutObjet + sizeof(s)) return 0;
+      return s.capacity() + 1;
+   }
+
+   /**
+   * \brief Octets réservés par le tableau de v (sans le contenu alloué par ses éléments)
+   */
+   template <typename T>
+   std::size_t octetsVecteur(const std::vector<T>& v)
+   {
+      return v.capacity() * sizeof(T);
+   }
+
+   /**
+   * \brief Octets des noeuds de l (sans le contenu alloué par ses éléments)
+   */
+   template <typename T>
+   std::size_t octetsListe(const std::list<T>& l)
+   {
+      return l.size() * (sizeof(T) + 2 * sizeof(void*));
+   }
+
+   /**
+   * \brief Octets des alvéoles et des noeuds de t (sans le contenu alloué par ses éléments)
+   */
+   template <typename C, typename V, typename H>
+   std::size_t octetsTableHachage(const std::unordered_map<C, V, H>& t)
+   {
+      return t.bucket_count() * sizeof(void*)
+             + t.size() * (sizeof(typename std::unordered_map<C, V, H>::value_type) + sizeof(void*) + sizeof(std::size_t));
+   }
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,324 @@
+/**
+* \file PipelineReecriture.cpp
+* \brief Le code des opérateurs de PipelineReecriture.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "PipelineReecriture.h"
+
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace TP3
+{
+
+    /**
+    * \brief Constructeur
+    *
+    * \pre dico n'est pas modifié pendant une réécriture.
+    *
+    * \post Le pipeline utilise le premier synonyme du premier sens de chaque radical.
+    */
+    PipelineReecriture::PipelineReecriture(const DicoSynonymes& dico, std::size_t capaciteFiles)
+        : dico(dico), capaciteFiles(capaciteFiles == 0 ? 1 : capaciteFiles)
+    {
+        selecteur = [](const DicoSynonymes& d, const std::string& radical) -> std::optional<std::string> {
+            return d.trouverSens(radical, 0);
+        };
+    }
+
+    /**
+    * \brief Remplace la façon de choisir les synonymes
+    */
+    void PipelineReecriture::setSelecteur(Selecteur selecteur)
+    {
+        this->selecteur = selecteur;
+    }
+
+    /**
+    * \brief Réécrit le texte lu dans entree et l'écrit dans sortie, un espace entre chaque mot
+    *
+    * \post Les mots dont le radical a un synonyme sont remplacés par la flexion correspondante
+    *       du synonyme ; les autres sont recopiés tels quels.
+    */
+    void PipelineReecriture::reecrire(std::istream& entree, std::ostream& sortie, bool multiFils) const
+    {
+        if (multiFils) reecrireMultiFils(entree, sortie);
+        else reecrireSequentiel(entree, sortie);
+    }
+
+    /**
+    * \brief Réécrit texte[0..taille[ dans sortie en recopiant tels quels les espaces et la ponctuation
+    *
+    * \post Les mots dont le radical a un synonyme sont remplacés comme par reecrire.
+    * \post Les mots de texte sont en minuscules.
+    */
+    void PipelineReecriture::reecrireTampon(char* texte, std::size_t taille, std::ostream& sortie) const
+    {
+        Segmenteur segmenteur(texte, taille);
+        std::vector<Segmenteur::Segment> lot;
+        std::string mot;   // réutilisée d'un mot à l'autre : la recherche n'alloue plus une fois assez grande
+        while (segmenteur.lireLot(lot) != 0)
+        {
+            for (auto &segment : lot)
+            {
+                sortie.write(segment.separateur.data(), segment.separateur.size());
+
+                mot.assign(segment.mot.data(), segment.mot.size());
+                std::optional<std::string> radical = dico.trouverRadical(mot);
+                std::optional<std::string> synonyme;
+                if (radical) synonyme = selecteur(dico, *radical);
+
+                if (synonyme)
+                    sortie << Segmenteur::recaser(flexionCorrespondante(mot, *radical, *synonyme), segment.casse);
+                else if (segment.casse == Segmenteur::Minuscules)
+                    sortie.write(segment.mot.data(), segment.mot.size());
+                else
+                    sortie << Segmenteur::recaser(segment.mot, segment.casse);
+            }
+        }
+        sortie << segmenteur.separateurFinal();
+    }
+
+    /**
+    * \brief Réécrit le fichier chemin avec reecrireTampon. Le fichier est projeté en mémoire
+    *        en copie privée : il n'est pas modifié.
+    *
+    * \exception runtime_error si le fichier ne peut être ouvert ou projeté.
+    */
+    void PipelineReecriture::reecrireFichier(const std::string& chemin, std::ostream& sortie) const
+    {
+        int descripteur = open(chemin.c_str(), O_RDONLY);
+        if (descripteur < 0)
+            throw std::runtime_error("PipelineReecriture::reecrireFichier : Impossible d'ouvrir " + chemin);
+        struct stat infos;
+        if (fstat(descripteur, &infos) != 0)
+        {
+            close(descripteur);
+            throw std::runtime_error("PipelineReecriture::reecrireFichier : Impossible de lire la taille de " + chemin);
+        }
+        std::size_t taille = infos.st_size;
+        if (taille == 0)
+        {
+            close(descripteur);
+            return;
+        }
+
+        // MAP_PRIVATE : la mise en minuscules ne touche que les pages copiées de ce processus
+        void* projection = mmap(0, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE, descripteur, 0);
+        close(descripteur);
+        if (projection == MAP_FAILED)
+            throw std::runtime_error("PipelineReecriture::reecrireFichier : Impossible de projeter " + chemin);
+        madvise(projection, taille, MADV_SEQUENTIAL);
+
+        try
+        {
+            reecrireTampon(static_cast<char*>(projection), taille, sortie);
+        }
+        catch (...)
+        {
+            munmap(projection, taille);
+            throw;
+        }
+        munmap(projection, taille);
+    }
+
+    /**
+    * \fn void normaliser(Jeton& jeton) const
+    * \brief Étape de normalisation : met le mot en minuscules et sépare la ponctuation qui le suit
+    */
+    void PipelineReecriture::normaliser(Jeton& jeton) const
+    {
+        std::size_t finMot = jeton.original.size();
+        while (finMot > 0 && std::ispunct(static_cast<unsigned char>(jeton.original[finMot - 1]))) --finMot;
+
+        jeton.mot = jeton.original.substr(0, finMot);
+        jeton.ponctuation = jeton.original.substr(finMot);
+        for (auto &c : jeton.mot)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    /**
+    * \fn void rechercher(Jeton& jeton) const
+    * \brief Étape de recherche du radical du mot normalisé
+    */
+    void PipelineReecriture::rechercher(Jeton& jeton) const
+    {
+        if (!jeton.mot.empty()) jeton.radical = dico.trouverRadical(jeton.mot);
+    }
+
+    /**
+    * \fn void choisir(Jeton& jeton) const
+    * \brief Étape de choix du synonyme qui remplacera le radical
+    */
+    void PipelineReecriture::choisir(Jeton& jeton) const
+    {
+        if (jeton.radical) jeton.synonyme = selecteur(dico, *jeton.radical);
+    }
+
+    /**
+    * \fn void flechir(Jeton& jeton) const
+    * \brief Étape de flexion : on prend la flexion du synonyme à la même position que celle
+    *        du mot dans les flexions de son radical, sinon le synonyme lui-même
+    */
+    void PipelineReecriture::flechir(Jeton& jeton) const
+    {
+        if (!jeton.synonyme)
+        {
+            jeton.sortie = jeton.original;
+            return;
+        }
+
+        jeton.sortie = flexionCorrespondante(jeton.mot, *jeton.radical, *jeton.synonyme) + jeton.ponctuation;
+    }
+
+    /**
+    * \fn std::string flexionCorrespondante(const std::string& mot, const std::string& radical,
+    *                                       const std::string& synonyme) const
+    * \brief Retourne la flexion de synonyme à la même position que mot dans les flexions de radical,
+    *        sinon synonyme lui-même
+    */
+    std::string PipelineReecriture::flexionCorrespondante(const std::string& mot, const std::string& radical,
+                                                          const std::string& synonyme) const
+    {
+        std::optional< std::vector<std::string> > flexionsRadical = dico.trouverFlexions(radical);
+        std::optional< std::vector<std::string> > flexionsSynonyme = dico.trouverFlexions(synonyme);
+        if (flexionsRadical && flexionsSynonyme)
+        {
+            auto it = std::find(flexionsRadical->begin(), flexionsRadical->end(), mot);
+            std::size_t position = it - flexionsRadical->begin();
+            if (it != flexionsRadical->end() && position < flexionsSynonyme->size())
+                return (*flexionsSynonyme)[position];
+        }
+        return synonyme;
+    }
+
+    /**
+    * \fn void reecrireSequentiel(std::istream& entree, std::ostream& sortie) const
+    * \brief Passe chaque mot par toutes les étapes dans le fil courant
+    */
+    void PipelineReecriture::reecrireSequentiel(std::istream& entree, std::ostream& sortie) const
+    {
+        Jeton jeton;
+        bool premier = true;
+        while (entree >> jeton.original)
+        {
+            normaliser(jeton);
+            rechercher(jeton);
+            choisir(jeton);
+            flechir(jeton);
+            if (!premier) sortie << ' ';
+            sortie << jeton.sortie;
+            premier = false;
+            jeton = Jeton();
+        }
+    }
+
+    /**
+    * \fn void reecrireMultiFils(std::istream& entree, std::ostream& sortie) const
+    * \brief Un fil par étape, reliés par des files bornées ; la sortie est écrite par le fil courant.
+    *        Une exception levée dans un fil (trouverRadical, le sélecteur, bad_alloc...) arrête la
+    *        lecture, laisse le jeton de fin traverser les étapes suivantes et est relancée ici,
+    *        une fois tous les fils joints.
+    */
+    void PipelineReecriture::reecrireMultiFils(std::istream& entree, std::ostream& sortie) const
+    {
+        typedef void (PipelineReecriture::*Etape)(Jeton&) const;
+        const Etape etapes[] = { &PipelineReecriture::normaliser, &PipelineReecriture::rechercher,
+                                 &PipelineReecriture::choisir, &PipelineReecriture::flechir };
+        const std::size_t nbEtapes = sizeof(etapes) / sizeof(etapes[0]);
+
+        // files[0] relie le découpage à la première étape, files[nbEtapes] la dernière étape à la sortie
+        std::vector< std::unique_ptr< FileBornee<Jeton> > > files;
+        for (std::size_t i = 0; i <= nbEtapes; ++i)
+            files.emplace_back(new FileBornee<Jeton>(capaciteFiles));
+
+        // la première exception est conservée ; abandon arrête la lecture du texte
+        std::exception_ptr erreur;
+        std::mutex verrouErreur;
+        std::atomic<bool> abandon(false);
+        auto noterErreur = [&]() {
+            std::lock_guard<std::mutex> garde(verrouErreur);
+            if (!erreur) erreur = std::current_exception();
+            abandon = true;
+        };
+        auto jetonFin = []() {
+            Jeton jeton;
+            jeton.fin = true;
+            return jeton;
+        };
+
+        std::vector<std::thread> fils;
+        fils.emplace_back([&]() {
+            try
+            {
+                Jeton jeton;
+                while (!abandon && entree >> jeton.original)
+                {
+                    files[0]->empiler(std::move(jeton));
+                    jeton = Jeton();
+                }
+            }
+            catch (...)
+            {
+                noterErreur();
+            }
+            files[0]->empiler(jetonFin());
+        });
+        for (std::size_t i = 0; i < nbEtapes; ++i)
+        {
+            fils.emplace_back([&, i]() {
+                try
+                {
+                    for (;;)
+                    {
+                        Jeton jeton = files[i]->depiler();
+                        if (!jeton.fin) (this->*etapes[i])(jeton);
+                        bool fin = jeton.fin;
+                        files[i + 1]->empiler(std::move(jeton));
+                        if (fin) return;
+                    }
+                }
+                catch (...)
+                {
+                    // la suite du pipeline se termine, et l'amont n'est pas bloqué sur une file pleine
+                    noterErreur();
+                    files[i + 1]->empiler(jetonFin());
+                    while (!files[i]->depiler().fin) { }
+                }
+            });
+        }
+
+        try
+        {
+            bool premier = true;
+            for (;;)
+            {
+                Jeton jeton = files[nbEtapes]->depiler();
+                if (jeton.fin) break;
+                if (!premier) sortie << ' ';
+                sortie << jeton.sortie;
+                premier = false;
+            }
+        }
+        catch (...)
+        {
+            noterErreur();
+            while (!files[nbEtapes]->depiler().fin) { }
+        }
+
+        for (auto &f : fils) f.join();
+        if (erreur) std::rethrow_exception(erreur);
+    }
+
+}//Fin du namespace
@@ -0,0 +1,132 @@
+/**
+* \file PipelineReecriture.h
+* \brief Interface du type PipelineReecriture
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <thread>
+#include <memory>
+#include <cctype>
+#include <algorithm>
+
+#include "DicoSynonymes.h"
+#include "FileBornee.h"
+#include "Segmenteur.h"
+
+#ifndef _PIPELINEREECRITURE__H
+#define _PIPELINEREECRITURE__H
+
+namespace TP3
+{
+
+   /**
+   * \class PipelineReecriture
+   *
+   * \brief Réécriture en continu d'un texte à l'aide d'un dictionnaire de synonymes.
+   *
+   * Chaque mot passe par les étapes découpage -> normalisation -> recherche du radical ->
+   * choix du synonyme -> flexion du synonyme -> sortie. En mode multi-fils, chaque étape
+   * a son propre fil et les étapes sont reliées par des FileBornee : la mémoire utilisée
+   * reste bornée et l'ordre des mots est conservé.
+   *
+   */
+   class PipelineReecriture
+   {
+   public:
+
+      /**
+      * \brief Fonction choisissant le synonyme qui remplacera un radical, ou rien pour garder le mot
+      */
+      typedef std::function<std::optional<std::string>(const DicoSynonymes& dico, const std::string& radical)> Selecteur;
+
+      /**
+      * \brief Constructeur
+      *
+      * \pre dico n'est pas modifié pendant une réécriture.
+      *
+      * \post Le pipeline utilise le premier synonyme du premier sens de chaque radical.
+      */
+      explicit PipelineReecriture(const DicoSynonymes& dico, std::size_t capaciteFiles = 1024);
+
+      /**
+      * \brief Remplace la façon de choisir les synonymes
+      */
+      void setSelecteur(Selecteur selecteur);
+
+      /**
+      * \brief Réécrit le texte lu dans entree et l'écrit dans sortie, un espace entre chaque mot
+      *
+      * \post Les mots dont le radical a un synonyme sont remplacés par la flexion correspondante
+      *       du synonyme ; les autres sont recopiés tels quels.
+      *
+      * \exception toute exception du dictionnaire ou du sélecteur est relancée ; en mode multiFils,
+      *            elle l'est après l'arrêt de tous les fils.
+      */
+      void reecrire(std::istream& entree, std::ostream& sortie, bool multiFils = true) const;
+
+      /**
+      * \brief Réécrit texte[0..taille[ dans sortie en recopiant tels quels les espaces et la ponctuation
+      *
+      * Le texte est découpé par lots avec Segmenteur, sans copier les mots : ils sont mis en
+      * minuscules dans texte même, puis leur casse d'origine est rétablie à l'écriture.
+      *
+      * \post Les mots dont le radical a un synonyme sont remplacés comme par reecrire.
+      * \post Les mots de texte sont en minuscules.
+      */
+      void reecrireTampon(char* texte, std::size_t taille, std::ostream& sortie) const;
+
+      /**
+      * \brief Réécrit le fichier chemin avec reecrireTampon. Le fichier est projeté en mémoire
+      *        en copie privée : il n'est pas modifié.
+      *
+      * \exception runtime_error si le fichier ne peut être ouvert ou projeté.
+      */
+      void reecrireFichier(const std::string& chemin, std::ostream& sortie) const;
+
+   private:
+
+      /**
+      * \struct Jeton
+      *
+      * \brief Un mot et ce que les étapes en ont tiré
+      */
+      struct Jeton
+      {
+         std::string original;      // Le mot tel que lu, ponctuation comprise.
+         std::string mot;           // Le mot normalisé (minuscules, sans ponctuation).
+         std::string ponctuation;   // La ponctuation qui suivait le mot.
+         std::optional<std::string> radical;
+         std::optional<std::string> synonyme;
+         std::string sortie;        // Le texte à écrire pour ce mot.
+         bool fin;                  // Vrai pour le jeton qui marque la fin du texte.
+         Jeton() : fin(false) { }
+      };
+
+      void normaliser(Jeton& jeton) const;
+      void rechercher(Jeton& jeton) const;
+      void choisir(Jeton& jeton) const;
+      void flechir(Jeton& jeton) const;
+      std::string flexionCorrespondante(const std::string& mot, const std::string& radical,
+                                        const std::string& synonyme) const;
+
+      void reecrireSequentiel(std::istream& entree, std::ostream& sortie) const;
+      void reecrireMultiFils(std::istream& entree, std::ostream& sortie) const;
+
+      const DicoSynonymes& dico;
+      std::size_t capaciteFiles;
+      Selecteur selecteur;
+   };
+
+}//Fin du namespace
+
+#endif
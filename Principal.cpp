@@ -9,12 +9,130 @@
 *
 */
 
+#include <iomanip>
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <cctype>
+
 #include "DicoSynonymes.h"
+#include "PipelineReecriture.h"
+#include "ServeurDico.h"
+#include "RejeuTrace.h"
 using namespace std;
 using namespace TP3;
 
-int main()
+/**
+* \brief Mode serveur : Principal --serveur [fichier du dictionnaire] [chemin du socket Unix] [trace]
+*        Sans chemin de socket, les requêtes sont lues sur l'entrée standard. Avec un fichier de
+*        trace, les appels faits au dictionnaire y sont enregistrés (voir TraceDico).
+*/
+int servirDico(int argc, char* argv[])
+{
+	ifstream fichier(argc > 2 ? argv[2] : "PetitDico.txt", ios::in);
+	if (!fichier.is_open())
+	{
+		std::cerr << "ERREUR: Impossible d'ouvrir le dictionnaire" << std::endl;
+		return 1;
+	}
+	try
+	{
+		DicoSynonymes dico;
+		dico.chargerDicoSynonyme(fichier);
+
+		ServeurDico serveur(dico);
+		std::unique_ptr<TraceDico> trace;
+		if (argc > 4)
+		{
+			trace.reset(new TraceDico(argv[4]));
+			dico.enregistrerTrace(trace.get());
+		}
+		if (argc > 3) serveur.ecouter(argv[3]);
+		else serveur.servir(0, 1);
+	}
+	catch(exception & e)
+	{
+		std::cerr << "ERREUR: " << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+/**
+* \brief Lit un nombre de fils d'exécution (entier décimal, 0 : autant que de coeurs)
+*
+* \exception invalid_argument si texte n'est pas un tel entier.
+*/
+unsigned int lireNombreFils(const string& texte)
+{
+	std::size_t lus = 0;
+	unsigned long nombre = 0;
+	try
+	{
+		if (!texte.empty() && std::isdigit(static_cast<unsigned char>(texte[0]))) nombre = std::stoul(texte, &lus);
+	}
+	catch(std::out_of_range &)
+	{
+		lus = 0;
+	}
+	if (lus == 0 || lus != texte.size() || nombre > std::numeric_limits<unsigned int>::max())
+		throw std::invalid_argument("Nombre de fils invalide : " + texte);
+	return nombre;
+}
+
+/**
+* \brief Mode rejeu : Principal --rejouer [fichier du dictionnaire] [trace] [nombre de fils]
+*        Rejoue la trace sur le dictionnaire chargé et affiche le débit et les centiles de latence,
+*        pour tous les appels puis pour chaque opération.
+*/
+int rejouerTrace(int argc, char* argv[])
 {
+	ifstream fichier(argc > 2 ? argv[2] : "PetitDico.txt", ios::in);
+	if (!fichier.is_open() || argc < 4)
+	{
+		std::cerr << "ERREUR: Principal --rejouer [fichier du dictionnaire] [trace] [nombre de fils]" << std::endl;
+		return 1;
+	}
+
+	try
+	{
+		unsigned int nbFils = argc > 4 ? lireNombreFils(argv[4]) : 1;
+		DicoSynonymes dico;
+		dico.chargerDicoSynonyme(fichier);
+		std::vector<TraceDico::Appel> appels = TraceDico::lire(argv[3]);
+		RejeuTrace::Resultat resultat = RejeuTrace::rejouer(dico, appels, nbFils);
+
+		cout << resultat.nombreAppels() << " appels (" << resultat.nbErreurs << " en erreur) en "
+		     << resultat.secondes << " s : " << resultat.debit() << " appels/s" << endl;
+		cout << "latence (ns)                p50        p90        p99      p99.9        max" << endl;
+		for (int operation = 0; operation < 256; ++operation)
+		{
+			std::size_t nombre = operation == 0 ? resultat.nombreAppels()
+			                     : std::count(resultat.operations.begin(), resultat.operations.end(), operation);
+			if (nombre == 0) continue;
+			cout << std::left << std::setw(26)
+			     << (operation == 0 ? "(tous)" : TraceDico::nom(static_cast<TraceDico::Operation>(operation)))
+			     << std::right;
+			for (double centile : {50.0, 90.0, 99.0, 99.9, 100.0})
+				cout << " " << std::setw(10) << resultat.latence(centile, operation);
+			cout << "  (" << nombre << ")" << endl;
+		}
+	}
+	catch(exception & e)
+	{
+		std::cerr << "ERREUR: " << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && string(argv[1]) == "--serveur")
+		return servirDico(argc, argv);
+	if (argc > 1 && string(argv[1]) == "--rejouer")
+		return rejouerTrace(argc, argv);
+
 	int nb = 1;				//Choix de l'utilisateur dans le menu initialisé à 1.
 	string radical;			//Chaîne de caractères représentant un radical.
 	string flexion;			//Chaîne de caractères représentant une flexion d'un radical.
@@ -35,6 +153,7 @@ int main()
 	cout << "6 - Supprimer un radical du dictionnaire." << endl;
 	cout << "7 - Charger un dictionnaire a partir d'un fichier texte." << endl;
 	cout << "8-  Transformer une chaîne en utilisant le dictionnaire." << endl;
+	cout << "9-  Transformer automatiquement une chaîne (pipeline)." << endl;
 	cout << "0 - Quitter." << endl;
 	cout << "--------------------------------------------------------" << endl;
 
@@ -44,13 +163,13 @@ int main()
 		do
 		{
 			cout << endl;
-			cout << "Entrer s.v.p. votre choix (0 a 8):? ";
+			cout << "Entrer s.v.p. votre choix (0 a 9):? ";
 			cin >> nb;
-			if(nb <0 || nb>8)
+			if(nb <0 || nb>9)
 			{
 				cout << "***Option invalide!***\n";
 			}
-		}while(nb <0 || nb>8);
+		}while(nb <0 || nb>9);
 
 		try
 		{
@@ -149,9 +268,16 @@ int main()
 				string mot;
 				while (iss >> mot)
 				{
+					// Les mots inconnus sont la majorité : on les traite sans passer par une exception
+					std::optional<std::string> radicalTrouve = dicoSyn.trouverRadical(mot);
+					if (!radicalTrouve)
+					{
+						resultat += (mot + " ");
+						continue;
+					}
 					try
 					{
-						radical = dicoSyn.rechercherRadical(mot);
+						radical = *radicalTrouve;
 						cout << "Radical trouve: " << radical << endl
 								<< "Pour changer le mot " << mot << ", tappez la lettre o: ";
 						char repch;
@@ -214,6 +340,19 @@ int main()
 				break;
 			}
 
+			case 9: //Transformer automatiquement une chaîne avec le pipeline.
+			{
+				string chaine = "Nous poursuivrons nos etudes plus lentement.";
+				cout << "Phrase a transformer: " << chaine << endl;
+				istringstream iss(chaine);
+				ostringstream resultat;
+				PipelineReecriture pipeline(dicoSyn);
+				pipeline.reecrire(iss, resultat);
+				cout << "Voici le texte transforme: " << endl;
+				cout << resultat.str() << endl;
+				break;
+			}
+
 			}
 		}
 
@@ -0,0 +1,151 @@
+/**
+* \file RaciniseurSuffixes.cpp
+* \brief Le code des opérateurs de RaciniseurSuffixes.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "RaciniseurSuffixes.h"
+
+namespace TP3
+{
+
+    static const std::uint32_t AUCUN_NOEUD = 0xFFFFFFFF;
+
+    /**
+    * \brief Constructeur
+    *
+    * \post Les terminaisons d'au plus profondeurMax caractères sont distinguées.
+    */
+    RaciniseurSuffixes::RaciniseurSuffixes(std::size_t profondeurMax) : profondeurMax(profondeurMax), noeuds(1)
+    {
+    }
+
+    /**
+    * \brief Apprend la règle qui mène de motFlexion à motRadical
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    void RaciniseurSuffixes::apprendre(const std::string& motRadical, const std::string& motFlexion)
+    {
+        std::size_t prefixe = 0;
+        while (prefixe < motRadical.size() && prefixe < motFlexion.size() && motRadical[prefixe] == motFlexion[prefixe])
+            ++prefixe;
+        std::uint32_t regle = identifiantRegle(motFlexion.size() - prefixe, motRadical.substr(prefixe));
+
+        // la règle est comptée dans chaque noeud du chemin : racine, dernier caractère, deux derniers, ...
+        std::uint32_t courant = 0;
+        std::size_t profondeur = std::min(profondeurMax, motFlexion.size());
+        for (std::size_t d = 0; ; ++d)
+        {
+            std::vector< std::pair<std::uint32_t, std::uint32_t> >& compteurs = noeuds[courant].regles;
+            auto it = std::find_if(compteurs.begin(), compteurs.end(),
+                                   [regle](const std::pair<std::uint32_t, std::uint32_t>& p) { return p.first == regle; });
+            if (it == compteurs.end())
+            {
+                compteurs.emplace_back(regle, 0);
+                it = compteurs.end() - 1;
+            }
+            ++it->second;
+            // on garde les règles triées par fréquence décroissante
+            while (it != compteurs.begin() && (it - 1)->second < it->second)
+            {
+                std::iter_swap(it, it - 1);
+                --it;
+            }
+
+            if (d == profondeur) break;
+            char c = motFlexion[motFlexion.size() - 1 - d];
+            std::uint32_t suivant = enfant(courant, c);
+            if (suivant == AUCUN_NOEUD)
+            {
+                suivant = noeuds.size();
+                noeuds[courant].enfants.emplace_back(c, suivant);
+                noeuds.emplace_back();
+            }
+            courant = suivant;
+        }
+    }
+
+    /**
+    * \brief Retourne au plus nbMax radicaux candidats pour mot, du plus probable au moins probable
+    *
+    * \post Le raciniseur reste inchangé.
+    * \return des candidats seulement : l'appelant doit vérifier qu'ils sont des radicaux.
+    */
+    std::vector<std::string> RaciniseurSuffixes::candidats(const std::string& mot, std::size_t nbMax) const
+    {
+        std::vector<std::uint32_t> chemin {0};
+        for (std::size_t d = 0; d < mot.size() && d < profondeurMax; ++d)
+        {
+            std::uint32_t suivant = enfant(chemin.back(), mot[mot.size() - 1 - d]);
+            if (suivant == AUCUN_NOEUD) break;
+            chemin.push_back(suivant);
+        }
+
+        std::vector<std::string> resultat;
+        for (auto it = chemin.rbegin(); it != chemin.rend() && resultat.size() < nbMax; ++it)
+        {
+            for (auto &compteur : noeuds[*it].regles)
+            {
+                const Regle& regle = regles[compteur.first];
+                if (regle.retirer >= mot.size()) continue;
+
+                std::string candidat = mot.substr(0, mot.size() - regle.retirer) + regle.ajouter;
+                if (candidat == mot || std::find(resultat.begin(), resultat.end(), candidat) != resultat.end()) continue;
+                resultat.push_back(candidat);
+                if (resultat.size() == nbMax) break;
+            }
+        }
+        return resultat;
+    }
+
+    /**
+    * \brief Oublie toutes les règles apprises
+    */
+    void RaciniseurSuffixes::vider()
+    {
+        regles.clear();
+        indexRegles.clear();
+        noeuds.assign(1, Noeud());
+    }
+
+    /**
+    * \fn std::uint32_t identifiantRegle(std::size_t retirer, const std::string& ajouter)
+    * \brief Retourne l'identifiant de la règle (retirer, ajouter), créée au besoin
+    */
+    std::uint32_t RaciniseurSuffixes::identifiantRegle(std::size_t retirer, const std::string& ajouter)
+    {
+        auto insertion = indexRegles.emplace(std::to_string(retirer) + ':' + ajouter, regles.size());
+        if (insertion.second) regles.push_back(Regle { retirer, ajouter });
+        return insertion.first->second;
+    }
+
+    /**
+    * \fn std::uint32_t enfant(std::uint32_t noeud, char c) const
+    * \brief Retourne l'enfant de noeud pour le caractère c, ou AUCUN_NOEUD
+    */
+    std::uint32_t RaciniseurSuffixes::enfant(std::uint32_t noeud, char c) const
+    {
+        for (auto &e : noeuds[noeud].enfants)
+            if (e.first == c) return e.second;
+        return AUCUN_NOEUD;
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t RaciniseurSuffixes::memoire() const
+    {
+        std::size_t octets = octetsVecteur(regles) + octetsTableHachage(indexRegles) + octetsVecteur(noeuds);
+        for (auto &regle : regles) octets += octetsChaine(regle.ajouter);
+        for (auto &entree : indexRegles) octets += octetsChaine(entree.first);
+        for (auto &noeud : noeuds) octets += octetsVecteur(noeud.enfants) + octetsVecteur(noeud.regles);
+        return octets;
+    }
+
+}//Fin du namespace
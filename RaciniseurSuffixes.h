@@ -0,0 +1,103 @@
+/**
+* \file RaciniseurSuffixes.h
+* \brief Interface du type RaciniseurSuffixes
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+
+#include "Memoire.h"
+
+#ifndef _RACINISEURSUFFIXES__H
+#define _RACINISEURSUFFIXES__H
+
+namespace TP3
+{
+
+   /**
+   * \class RaciniseurSuffixes
+   *
+   * \brief Prédit le radical d'un mot inconnu à partir de sa terminaison.
+   *
+   * Chaque paire (radical, flexion) apprise donne une règle « retirer n caractères à la fin,
+   * puis ajouter telle chaîne » (ex. poursuivrons -> poursuivre : retirer 3, ajouter « e »).
+   * Les règles sont rangées dans un trie des flexions lues à l'envers : chaque noeud compte
+   * les règles des flexions qui se terminent par le suffixe qu'il représente. Pour un mot,
+   * on descend le trie en lisant le mot à l'envers, puis on applique les règles les plus
+   * fréquentes du noeud le plus profond atteint, puis celles de ses ancêtres.
+   *
+   */
+   class RaciniseurSuffixes
+   {
+   public:
+
+      /**
+      * \brief Constructeur
+      *
+      * \post Les terminaisons d'au plus profondeurMax caractères sont distinguées.
+      */
+      explicit RaciniseurSuffixes(std::size_t profondeurMax = 8);
+
+      /**
+      * \brief Apprend la règle qui mène de motFlexion à motRadical
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void apprendre(const std::string& motRadical, const std::string& motFlexion);
+
+      /**
+      * \brief Retourne au plus nbMax radicaux candidats pour mot, du plus probable au moins probable
+      *
+      * \post Le raciniseur reste inchangé.
+      * \return des candidats seulement : l'appelant doit vérifier qu'ils sont des radicaux.
+      */
+      std::vector<std::string> candidats(const std::string& mot, std::size_t nbMax = 4) const;
+
+      /**
+      * \brief Oublie toutes les règles apprises
+      */
+      void vider();
+
+      std::size_t nombreRegles() const { return regles.size(); }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+   private:
+
+      struct Regle
+      {
+         std::size_t retirer;   // Nombre de caractères à enlever à la fin du mot.
+         std::string ajouter;   // Chaîne à ajouter ensuite.
+      };
+
+      struct Noeud
+      {
+         std::vector< std::pair<char, std::uint32_t> > enfants;        // Caractère précédent -> noeud.
+         std::vector< std::pair<std::uint32_t, std::uint32_t> > regles; // (règle, occurrences), les plus fréquentes en premier.
+      };
+
+      std::uint32_t identifiantRegle(std::size_t retirer, const std::string& ajouter);
+      std::uint32_t enfant(std::uint32_t noeud, char c) const;
+
+      std::size_t profondeurMax;
+      std::vector<Regle> regles;
+      std::unordered_map<std::string, std::uint32_t> indexRegles;   // Clé « retirer:ajouter » -> règle.
+      std::vector<Noeud> noeuds;                                     // noeuds[0] est la racine (suffixe vide).
+   };
+
+}//Fin du namespace
+
+#endif
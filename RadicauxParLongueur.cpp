@@ -0,0 +1,239 @@
+/**
+* \file RadicauxParLongueur.cpp
+* \brief Le code des opérateurs de RadicauxParLongueur.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "RadicauxParLongueur.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace TP3
+{
+
+    // Opérations sur LARGEUR compteurs de 8 bits à la fois. Les additions saturent à 255.
+#if defined(__AVX2__)
+    typedef __m256i Vecteur;
+    static inline Vecteur diffuser(std::uint8_t c) { return _mm256_set1_epi8(static_cast<char>(c)); }
+    static inline Vecteur charger(const std::uint8_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static inline void ranger(std::uint8_t* p, Vecteur v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static inline Vecteur minimum(Vecteur a, Vecteur b) { return _mm256_min_epu8(a, b); }
+    static inline Vecteur additionner(Vecteur a, Vecteur b) { return _mm256_adds_epu8(a, b); }
+    static inline Vecteur different(Vecteur a, Vecteur b) { return _mm256_andnot_si256(_mm256_cmpeq_epi8(a, b), _mm256_set1_epi8(1)); }
+#elif defined(__SSE2__)
+    typedef __m128i Vecteur;
+    static inline Vecteur diffuser(std::uint8_t c) { return _mm_set1_epi8(static_cast<char>(c)); }
+    static inline Vecteur charger(const std::uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static inline void ranger(std::uint8_t* p, Vecteur v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static inline Vecteur minimum(Vecteur a, Vecteur b) { return _mm_min_epu8(a, b); }
+    static inline Vecteur additionner(Vecteur a, Vecteur b) { return _mm_adds_epu8(a, b); }
+    static inline Vecteur different(Vecteur a, Vecteur b) { return _mm_andnot_si128(_mm_cmpeq_epi8(a, b), _mm_set1_epi8(1)); }
+#else
+    struct Vecteur { std::uint8_t v[RadicauxParLongueur::LARGEUR]; };
+    static inline Vecteur diffuser(std::uint8_t c) { Vecteur r; std::fill(r.v, r.v + RadicauxParLongueur::LARGEUR, c); return r; }
+    static inline Vecteur charger(const std::uint8_t* p) { Vecteur r; std::copy(p, p + RadicauxParLongueur::LARGEUR, r.v); return r; }
+    static inline void ranger(std::uint8_t* p, Vecteur v) { std::copy(v.v, v.v + RadicauxParLongueur::LARGEUR, p); }
+    static inline Vecteur minimum(Vecteur a, Vecteur b)
+    {
+        for (std::size_t i = 0; i < RadicauxParLongueur::LARGEUR; ++i) a.v[i] = std::min(a.v[i], b.v[i]);
+        return a;
+    }
+    static inline Vecteur additionner(Vecteur a, Vecteur b)
+    {
+        for (std::size_t i = 0; i < RadicauxParLongueur::LARGEUR; ++i) a.v[i] = std::min(255, a.v[i] + b.v[i]);
+        return a;
+    }
+    static inline Vecteur different(Vecteur a, Vecteur b)
+    {
+        for (std::size_t i = 0; i < RadicauxParLongueur::LARGEUR; ++i) a.v[i] = a.v[i] != b.v[i];
+        return a;
+    }
+#endif
+
+    // Au-delà, une distance ne tient plus dans un compteur de 8 bits.
+    static const std::size_t LONGUEUR_MAX_VOIES = 254;
+
+    /**
+    * \brief Ajoute mot sous l'identifiant proprietaire (par exemple le numéro de son radical)
+    *
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    void RadicauxParLongueur::ajouter(const std::string& mot, std::uint32_t proprietaire)
+    {
+        ++nbMots;
+        if (mot.size() > LONGUEUR_MAX_VOIES)
+        {
+            longs.emplace_back(mot, proprietaire);
+            return;
+        }
+
+        if (paquets.size() <= mot.size()) paquets.resize(mot.size() + 1);
+        std::vector<Paquet>& memeLongueur = paquets[mot.size()];
+        if (memeLongueur.empty() || memeLongueur.back().proprietaires.size() == LARGEUR)
+        {
+            memeLongueur.emplace_back();
+            memeLongueur.back().caracteres.assign(mot.size() * LARGEUR, 0);
+        }
+
+        Paquet& paquet = memeLongueur.back();
+        std::size_t voie = paquet.proprietaires.size();
+        for (std::size_t j = 0; j < mot.size(); ++j)
+            paquet.caracteres[j * LARGEUR + voie] = static_cast<std::uint8_t>(mot[j]);
+        paquet.proprietaires.push_back(proprietaire);
+    }
+
+    /**
+    * \brief Retourne tous les mots ajoutés à une distance de Levenshtein d'au plus distanceMax de mot
+    *
+    * \post La copie reste inchangée.
+    * \return un résultat par mot proche, sans ordre particulier.
+    */
+    std::vector<RadicauxParLongueur::Resultat> RadicauxParLongueur::chercher(const std::string& mot, unsigned int distanceMax) const
+    {
+        std::vector<Resultat> resultat;
+        std::uint8_t sortie[LARGEUR];
+
+        // la distance est au moins la différence des longueurs : seules ces longueurs sont visitées
+        if (mot.size() <= LONGUEUR_MAX_VOIES && distanceMax < 255)
+        {
+            std::size_t premiere = mot.size() > distanceMax ? mot.size() - distanceMax : 0;
+            std::size_t derniere = std::min(paquets.size(), mot.size() + distanceMax + 1);
+            for (std::size_t longueur = premiere; longueur < derniere; ++longueur)
+            {
+                for (auto &paquet : paquets[longueur])
+                {
+                    distances(mot, longueur, paquet, distanceMax, sortie);
+                    for (std::size_t voie = 0; voie < paquet.proprietaires.size(); ++voie)
+                        if (sortie[voie] <= distanceMax)
+                            resultat.push_back(Resultat { paquet.proprietaires[voie], sortie[voie] });
+                }
+            }
+        }
+        else
+        {
+            // repli sans voies : le mot cherché lui-même est trop long pour des compteurs de 8 bits
+            for (std::size_t longueur = 0; longueur < paquets.size(); ++longueur)
+            {
+                for (auto &paquet : paquets[longueur])
+                {
+                    for (std::size_t voie = 0; voie < paquet.proprietaires.size(); ++voie)
+                    {
+                        std::string autre(longueur, '\0');
+                        for (std::size_t j = 0; j < longueur; ++j)
+                            autre[j] = static_cast<char>(paquet.caracteres[j * LARGEUR + voie]);
+                        unsigned int distance = distanceScalaire(mot, autre);
+                        if (distance <= distanceMax) resultat.push_back(Resultat { paquet.proprietaires[voie], distance });
+                    }
+                }
+            }
+        }
+
+        for (auto &entree : longs)
+        {
+            unsigned int distance = distanceScalaire(mot, entree.first);
+            if (distance <= distanceMax) resultat.push_back(Resultat { entree.second, distance });
+        }
+        return resultat;
+    }
+
+    /**
+    * \brief Retire tous les mots
+    */
+    void RadicauxParLongueur::vider()
+    {
+        paquets.clear();
+        longs.clear();
+        nbMots = 0;
+    }
+
+    /**
+    * \fn void distances(const std::string& mot, std::size_t longueur, const Paquet& paquet, unsigned int distanceMax, std::uint8_t* sortie)
+    * \brief Calcule à la fois les distances de mot aux LARGEUR mots de paquet, tous de longueur longueur.
+    *        Une ligne de la matrice de programmation dynamique est un vecteur par colonne.
+    * \param[out] sortie les LARGEUR distances ; une distance supérieure à distanceMax peut valoir 255
+    */
+    void RadicauxParLongueur::distances(const std::string& mot, std::size_t longueur, const Paquet& paquet,
+                                        unsigned int distanceMax, std::uint8_t* sortie)
+    {
+        std::vector<std::uint8_t> precedente((longueur + 1) * LARGEUR);
+        std::vector<std::uint8_t> courante((longueur + 1) * LARGEUR);
+        for (std::size_t j = 0; j <= longueur; ++j)
+            ranger(&precedente[j * LARGEUR], diffuser(static_cast<std::uint8_t>(j)));
+
+        const Vecteur un = diffuser(1);
+        std::uint8_t minimums[LARGEUR];
+        for (std::size_t i = 1; i <= mot.size(); ++i)
+        {
+            const Vecteur lettre = diffuser(static_cast<std::uint8_t>(mot[i - 1]));
+            Vecteur gauche = diffuser(static_cast<std::uint8_t>(i));
+            Vecteur minLigne = gauche;
+            ranger(&courante[0], gauche);
+
+            for (std::size_t j = 1; j <= longueur; ++j)
+            {
+                Vecteur substitution = additionner(charger(&precedente[(j - 1) * LARGEUR]),
+                                           different(lettre, charger(&paquet.caracteres[(j - 1) * LARGEUR])));
+                Vecteur insertion = additionner(charger(&precedente[j * LARGEUR]), un);
+                gauche = minimum(substitution, minimum(insertion, additionner(gauche, un)));
+                ranger(&courante[j * LARGEUR], gauche);
+                minLigne = minimum(minLigne, gauche);
+            }
+            precedente.swap(courante);
+
+            // une ligne ne fait jamais baisser le minimum : si toutes les voies dépassent, c'est fini
+            ranger(minimums, minLigne);
+            if (std::all_of(minimums, minimums + LARGEUR, [distanceMax](std::uint8_t m) { return m > distanceMax; }))
+            {
+                std::fill(sortie, sortie + LARGEUR, 255);
+                return;
+            }
+        }
+        ranger(sortie, charger(&precedente[longueur * LARGEUR]));
+    }
+
+    /**
+    * \fn unsigned int distanceScalaire(const std::string& mot1, const std::string& mot2)
+    * \brief Distance de Levenshtein ordinaire, pour les mots trop longs pour les voies
+    */
+    unsigned int RadicauxParLongueur::distanceScalaire(const std::string& mot1, const std::string& mot2)
+    {
+        std::vector<unsigned int> ligne(mot2.size() + 1);
+        for (unsigned int j = 0; j <= mot2.size(); ++j) ligne[j] = j;
+
+        for (unsigned int i = 1; i <= mot1.size(); ++i)
+        {
+            unsigned int diagonale = ligne[0];
+            ligne[0] = i;
+            for (unsigned int j = 1; j <= mot2.size(); ++j)
+            {
+                unsigned int haut = ligne[j];
+                ligne[j] = std::min({ haut + 1, ligne[j - 1] + 1, diagonale + (mot1[i - 1] == mot2[j - 1] ? 0 : 1) });
+                diagonale = haut;
+            }
+        }
+        return ligne[mot2.size()];
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t RadicauxParLongueur::memoire() const
+    {
+        std::size_t octets = octetsVecteur(paquets) + octetsVecteur(longs);
+        for (auto &memeLongueur : paquets)
+        {
+            octets += octetsVecteur(memeLongueur);
+            for (auto &paquet : memeLongueur) octets += octetsVecteur(paquet.caracteres) + octetsVecteur(paquet.proprietaires);
+        }
+        for (auto &entree : longs) octets += octetsChaine(entree.first);
+        return octets;
+    }
+
+}//Fin du namespace
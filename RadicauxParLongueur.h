@@ -0,0 +1,110 @@
+/**
+* \file RadicauxParLongueur.h
+* \brief Interface du type RadicauxParLongueur
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "Memoire.h"
+
+#ifndef _RADICAUXPARLONGUEUR__H
+#define _RADICAUXPARLONGUEUR__H
+
+namespace TP3
+{
+
+   /**
+   * \class RadicauxParLongueur
+   *
+   * \brief Copie des mots d'un dictionnaire, groupés par longueur, pour calculer la distance
+   *        d'édition d'un mot à tous les autres en un seul balayage.
+   *
+   * Les mots de même longueur sont rangés par paquets de LARGEUR mots, caractère par caractère
+   * (le j-ième caractère des LARGEUR mots est contigu). Une seule passe de programmation
+   * dynamique calcule alors les LARGEUR distances à la fois, une par voie SIMD (AVX2 : 32 voies,
+   * SSE2 : 16 voies, sinon une boucle ordinaire sur 16 voies). Les paquets dont la longueur
+   * diffère trop de celle du mot cherché ne sont même pas visités.
+   *
+   */
+   class RadicauxParLongueur
+   {
+   public:
+
+#if defined(__AVX2__)
+      static constexpr std::size_t LARGEUR = 32;
+#else
+      static constexpr std::size_t LARGEUR = 16;
+#endif
+
+      /**
+      * \struct Resultat
+      *
+      * \brief Un mot proche : le propriétaire donné à ajouter et sa distance au mot cherché
+      */
+      struct Resultat
+      {
+         std::uint32_t proprietaire;
+         unsigned int distance;
+      };
+
+      /**
+      * \brief Ajoute mot sous l'identifiant proprietaire (par exemple le numéro de son radical)
+      *
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      void ajouter(const std::string& mot, std::uint32_t proprietaire);
+
+      /**
+      * \brief Retourne tous les mots ajoutés à une distance de Levenshtein d'au plus distanceMax de mot
+      *
+      * \post La copie reste inchangée.
+      * \return un résultat par mot proche, sans ordre particulier.
+      */
+      std::vector<Resultat> chercher(const std::string& mot, unsigned int distanceMax) const;
+
+      /**
+      * \brief Retire tous les mots
+      */
+      void vider();
+
+      std::size_t taille() const { return nbMots; }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+   private:
+
+      /**
+      * \struct Paquet
+      *
+      * \brief Au plus LARGEUR mots de même longueur, rangés caractère par caractère
+      */
+      struct Paquet
+      {
+         std::vector<std::uint8_t> caracteres;     // caracteres[j * LARGEUR + voie] : j-ième caractère du mot de la voie.
+         std::vector<std::uint32_t> proprietaires;  // Un par voie occupée.
+      };
+
+      static void distances(const std::string& mot, std::size_t longueur, const Paquet& paquet,
+                            unsigned int distanceMax, std::uint8_t* sortie);
+      static unsigned int distanceScalaire(const std::string& mot1, const std::string& mot2);
+
+      std::vector< std::vector<Paquet> > paquets;   // paquets[l] : les paquets des mots de longueur l.
+      std::vector< std::pair<std::string, std::uint32_t> > longs;   // Mots trop longs pour les voies de 8 bits.
+      std::size_t nbMots = 0;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,400 @@
+/**
+* \file RejeuTrace.cpp
+* \brief Le code des opérateurs de RejeuTrace.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "RejeuTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace TP3
+{
+
+    static const std::size_t LECTURES_MIN_PAR_FIL = 64;   // En deçà, une suite de lectures n'est pas partagée.
+
+    /**
+    * \fn void mesurer(F&& appel, std::uint64_t& latence, bool& erreur, std::exception_ptr& echec)
+    * \brief Exécute appel et mesure sa durée ; erreur devient vrai s'il lance une logic_error et
+    *        echec reçoit toute autre exception (bad_alloc, ...), qui n'est pas une erreur de la trace
+    */
+    template <class F>
+    static void mesurer(F&& appel, std::uint64_t& latence, bool& erreur, std::exception_ptr& echec)
+    {
+        auto debut = std::chrono::steady_clock::now();
+        erreur = false;
+        try
+        {
+            appel();
+        }
+        catch (const std::logic_error&)
+        {
+            erreur = true;
+        }
+        catch (...)
+        {
+            echec = std::current_exception();
+        }
+        latence = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - debut).count();
+    }
+
+    /**
+    * \brief Appels par seconde
+    */
+    double RejeuTrace::Resultat::debit() const
+    {
+        return secondes > 0 ? nombreAppels() / secondes : 0;
+    }
+
+    /**
+    * \brief Latence (ns) sous laquelle se trouvent centile % des appels (de operation, si elle
+    *        n'est pas 0)
+    */
+    std::uint64_t RejeuTrace::Resultat::latence(double centile, int operation) const
+    {
+        std::vector<std::uint64_t> choisies;
+        for (std::size_t i = 0; i < latences.size(); ++i)
+            if (operation == 0 || operations[i] == operation) choisies.push_back(latences[i]);
+        if (choisies.empty()) return 0;
+
+        std::size_t rang = static_cast<std::size_t>(std::ceil(centile / 100 * choisies.size()));
+        rang = std::min(choisies.size() - 1, rang > 0 ? rang - 1 : 0);
+        std::nth_element(choisies.begin(), choisies.begin() + rang, choisies.end());
+        return choisies[rang];
+    }
+
+    /**
+    * \brief Rejoue appels sur dico avec nbFils fils (0 : autant que de coeurs)
+    *
+    * \exception runtime_error si les arguments d'un appel sont incomplets.
+    * \exception Une exception d'un appel qui n'est pas une logic_error (bad_alloc, ...) arrête le rejeu
+    *            et est relancée telle quelle ; les logic_error sont comptées dans nbErreurs.
+    */
+    RejeuTrace::Resultat RejeuTrace::rejouer(DicoSynonymes& dico, const std::vector<TraceDico::Appel>& appels,
+                                             unsigned int nbFils)
+    {
+        if (nbFils == 0) nbFils = std::max(1u, std::thread::hardware_concurrency());
+
+        Resultat resultat;
+        resultat.latences.assign(appels.size(), 0);
+        for (auto &appel : appels) resultat.operations.push_back(appel.operation);
+        std::vector<char> erreurs(appels.size(), 0);     // Pas de vector<bool> : chaque fil écrit ses cases.
+
+        // chaque fil exécute une tranche contiguë de lectures. Seule la runtime_error du décodage des
+        // arguments est une erreur de décodage ; une autre exception (bad_alloc, ou lancée par le
+        // dictionnaire sans être une logic_error) arrête aussi le rejeu et est relancée telle quelle.
+        std::exception_ptr erreurDecodage, erreurAppel;
+        std::mutex verrouErreur;
+        auto traiter = [&](std::size_t debut, std::size_t fin) {
+            std::exception_ptr echec;
+            try
+            {
+                for (std::size_t i = debut; i < fin && !echec; ++i)
+                {
+                    bool erreur;
+                    executer(dico, appels[i], resultat.latences[i], erreur, echec);
+                    erreurs[i] = erreur;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                std::lock_guard<std::mutex> garde(verrouErreur);
+                if (!erreurDecodage) erreurDecodage = std::current_exception();
+            }
+            catch (...)
+            {
+                echec = std::current_exception();
+            }
+            if (echec)
+            {
+                std::lock_guard<std::mutex> garde(verrouErreur);
+                if (!erreurAppel) erreurAppel = echec;
+            }
+        };
+
+        auto debut = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < appels.size() && !erreurDecodage && !erreurAppel; )
+        {
+            if (TraceDico::estModification(appels[i].operation))
+            {
+                traiter(i, i + 1);
+                ++i;
+                continue;
+            }
+
+            std::size_t fin = i;
+            while (fin < appels.size() && !TraceDico::estModification(appels[fin].operation)) ++fin;
+
+            std::size_t nbTranches = std::max<std::size_t>(1, std::min<std::size_t>(nbFils, (fin - i) / LECTURES_MIN_PAR_FIL));
+            std::size_t taille = (fin - i + nbTranches - 1) / nbTranches;
+            std::vector<std::thread> fils;
+            for (std::size_t f = 1; f < nbTranches; ++f)
+                fils.emplace_back(traiter, std::min(fin, i + f * taille), std::min(fin, i + (f + 1) * taille));
+            traiter(i, std::min(fin, i + taille));
+            for (auto &f : fils) f.join();
+            i = fin;
+        }
+        resultat.secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+
+        if (erreurAppel) std::rethrow_exception(erreurAppel);
+        if (erreurDecodage) std::rethrow_exception(erreurDecodage);
+        resultat.nbErreurs = std::count(erreurs.begin(), erreurs.end(), 1);
+        return resultat;
+    }
+
+    /**
+    * \brief Décode les arguments de appel, puis exécute et mesure l'appel correspondant de dico.
+    *        Une exception de l'appel qui n'est pas une logic_error est rangée dans echec.
+    *
+    * \exception runtime_error si les arguments sont incomplets.
+    */
+    void RejeuTrace::executer(DicoSynonymes& dico, const TraceDico::Appel& appel, std::uint64_t& latence, bool& erreur,
+                              std::exception_ptr& echec)
+    {
+        TraceDico::LecteurArguments lecteur(appel.arguments);
+        switch (appel.operation)
+        {
+        case TraceDico::AjoutRadical:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.ajouterRadical(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::AjoutFlexion:
+        {
+            std::string radical = lecteur.chaine(), flexion = lecteur.chaine();
+            mesurer([&] { dico.ajouterFlexion(radical, flexion); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::AjoutSynonyme:
+        {
+            std::string radical = lecteur.chaine(), synonyme = lecteur.chaine();
+            int numGroupe = lecteur.entier();
+            mesurer([&] { dico.ajouterSynonyme(radical, synonyme, numGroupe); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::AjoutFlexions:
+        {
+            std::string radical = lecteur.chaine();
+            std::vector<std::string> flexions = lecteur.chaines();
+            mesurer([&] { dico.ajouterFlexions(radical, flexions); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::AjoutGroupeSynonymes:
+        {
+            std::string radical = lecteur.chaine();
+            std::vector<std::string> synonymes = lecteur.chaines();
+            mesurer([&] { dico.ajouterGroupeSynonymes(radical, synonymes); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::ApplicationLot:
+        {
+            std::vector<DicoSynonymes::Mutation> mutations(lecteur.naturel());
+            for (auto &mutation : mutations)
+            {
+                mutation.type = static_cast<DicoSynonymes::Mutation::Type>(lecteur.entier());
+                mutation.radical = lecteur.chaine();
+                mutation.flexion = lecteur.chaine();
+            }
+            mesurer([&] { dico.appliquerLot(std::move(mutations)); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::SuppressionIntervalle:
+        {
+            std::string debut = lecteur.chaine(), fin = lecteur.chaine();
+            mesurer([&] { dico.supprimerIntervalle(debut, fin); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::SuppressionRadical:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.supprimerRadical(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::SuppressionFlexion:
+        {
+            std::string radical = lecteur.chaine(), flexion = lecteur.chaine();
+            mesurer([&] { dico.supprimerFlexion(radical, flexion); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::SuppressionSynonyme:
+        {
+            std::string radical = lecteur.chaine(), synonyme = lecteur.chaine();
+            int numGroupe = lecteur.entier();
+            mesurer([&] { dico.supprimerSynonyme(radical, synonyme, numGroupe); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::ContientRadical:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.contientRadical(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::RadicalAuRang:
+        {
+            int k = lecteur.entier();
+            mesurer([&] { dico.radicalAuRang(k); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Rang:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.rang(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Page:
+        {
+            int debut = lecteur.entier();
+            int taille = lecteur.entier();
+            mesurer([&] { dico.page(debut, taille); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::RechercheRadical:
+        {
+            std::string mot = lecteur.chaine();
+            mesurer([&] { dico.rechercherRadical(mot); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Similitude:
+        {
+            std::string mot1 = lecteur.chaine(), mot2 = lecteur.chaine();
+            mesurer([&] { dico.similitude(mot1, mot2); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::NombreSens:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.getNombreSens(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Sens:
+        {
+            std::string radical = lecteur.chaine();
+            int position = lecteur.entier();
+            mesurer([&] { dico.getSens(radical, position); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Synonymes:
+        {
+            std::string radical = lecteur.chaine();
+            int position = lecteur.entier();
+            mesurer([&] { dico.getSynonymes(radical, position); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Flexions:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.getFlexions(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::TrouverRadical:
+        {
+            std::string mot = lecteur.chaine();
+            mesurer([&] { dico.trouverRadical(mot); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::TrouverNombreSens:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.trouverNombreSens(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::TrouverSens:
+        {
+            std::string radical = lecteur.chaine();
+            int position = lecteur.entier();
+            mesurer([&] { dico.trouverSens(radical, position); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::TrouverSynonymes:
+        {
+            std::string radical = lecteur.chaine();
+            int position = lecteur.entier();
+            mesurer([&] { dico.trouverSynonymes(radical, position); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::TrouverFlexions:
+        {
+            std::string radical = lecteur.chaine();
+            mesurer([&] { dico.trouverFlexions(radical); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::SynonymesTransitifs:
+        {
+            std::string radical = lecteur.chaine();
+            int k = lecteur.entier();
+            mesurer([&] { dico.synonymesTransitifs(radical, k); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::SynonymesTransitifsLot:
+        {
+            std::vector<std::string> radicaux = lecteur.chaines();
+            int k = lecteur.entier();
+            unsigned int nbFilsLot = lecteur.entier();
+            mesurer([&] { dico.synonymesTransitifs(radicaux, k, nbFilsLot); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::DevinerRadical:
+        {
+            std::string mot = lecteur.chaine();
+            mesurer([&] { dico.devinerRadical(mot); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::RadicalLePlusProche:
+        {
+            std::string mot = lecteur.chaine();
+            unsigned int distanceMax = lecteur.entier();
+            mesurer([&] { dico.radicalLePlusProche(mot, distanceMax); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::CompressionFlexions:
+        {
+            bool activer = lecteur.entier();
+            mesurer([&] { dico.compresserFlexions(activer); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::ActivationCache:
+        {
+            std::size_t capacite = lecteur.entier();
+            mesurer([&] { dico.activerCache(capacite); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::ActivationRaciniseur:
+        {
+            bool activer = lecteur.entier();
+            mesurer([&] { dico.activerRaciniseur(activer); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::Compactage:
+            mesurer([&] { dico.compacter(); }, latence, erreur, echec);
+            break;
+        case TraceDico::ConsolidationGroupes:
+        {
+            float seuil = lecteur.reel();
+            mesurer([&] { dico.consoliderGroupes(seuil); }, latence, erreur, echec);
+            break;
+        }
+        case TraceDico::ConsolidationEnLigne:
+        {
+            float seuil = lecteur.reel();
+            mesurer([&] { dico.consoliderEnLigne(seuil); }, latence, erreur, echec);
+            break;
+        }
+        default:
+            latence = 0;
+            erreur = false;
+        }
+    }
+
+}//Fin du namespace
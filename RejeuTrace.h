@@ -0,0 +1,90 @@
+/**
+* \file RejeuTrace.h
+* \brief Interface du type RejeuTrace
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+
+#include "DicoSynonymes.h"
+#include "TraceDico.h"
+
+#ifndef _REJEUTRACE__H
+#define _REJEUTRACE__H
+
+namespace TP3
+{
+
+   /**
+   * \class RejeuTrace
+   *
+   * \brief Réexécute une trace enregistrée par TraceDico sur un dictionnaire et mesure le débit
+   *        et la latence de chaque appel.
+   *
+   * Les appels sont exécutés le plus vite possible, sans respecter les délais enregistrés. Avec
+   * plusieurs fils, chaque suite de lectures entre deux modifications est partagée en tranches
+   * contiguës entre les fils ; une modification est exécutée seule, après toutes les lectures qui
+   * la précèdent. Chaque appel voit donc le même dictionnaire qu'avec un seul fil et le rejeu est
+   * déterministe, sauf pour l'ordre des lectures dans le cache de activerCache.
+   *
+   */
+   class RejeuTrace
+   {
+   public:
+
+      /**
+      * \struct Resultat
+      *
+      * \brief Mesures d'un rejeu
+      */
+      struct Resultat
+      {
+         std::size_t nbErreurs = 0;                     // Appels terminés par une logic_error.
+         double secondes = 0;                           // Durée totale du rejeu.
+         std::vector<std::uint64_t> latences;           // Latence de chaque appel en ns, dans l'ordre de la trace.
+         std::vector<TraceDico::Operation> operations;  // Opération de chaque appel.
+
+         std::size_t nombreAppels() const { return latences.size(); }
+
+         /**
+         * \brief Appels par seconde
+         */
+         double debit() const;
+
+         /**
+         * \brief Latence (ns) sous laquelle se trouvent centile % des appels, ou des appels de
+         *        operation si elle est donnée (0 : tous) ; 0 s'il n'y en a aucun
+         *
+         * \pre 0 <= centile <= 100
+         */
+         std::uint64_t latence(double centile, int operation = 0) const;
+      };
+
+      /**
+      * \brief Rejoue appels sur dico avec nbFils fils (0 : autant que de coeurs)
+      *
+      * \post dico a subi les modifications de la trace.
+      *
+      * \exception runtime_error si les arguments d'un appel sont incomplets.
+      * \exception Une exception d'un appel qui n'est pas une logic_error (bad_alloc, ...) arrête le rejeu
+      *            et est relancée telle quelle ; les logic_error sont comptées dans nbErreurs.
+      */
+      static Resultat rejouer(DicoSynonymes& dico, const std::vector<TraceDico::Appel>& appels, unsigned int nbFils = 1);
+
+   private:
+
+      static void executer(DicoSynonymes& dico, const TraceDico::Appel& appel, std::uint64_t& latence, bool& erreur,
+                           std::exception_ptr& echec);
+   };
+
+}//Fin du namespace
+
+#endif
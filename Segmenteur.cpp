@@ -0,0 +1,347 @@
+/**
+* \file Segmenteur.cpp
+* \brief Le code des opérateurs de Segmenteur.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "Segmenteur.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace TP3
+{
+
+    static inline bool estMajusculeAscii(unsigned char c)
+    {
+        return static_cast<unsigned char>(c - 'A') <= 25;
+    }
+
+    static inline bool estMinusculeAscii(unsigned char c)
+    {
+        return static_cast<unsigned char>(c - 'a') <= 25;
+    }
+
+    static inline bool estAlphanumeriqueAscii(unsigned char c)
+    {
+        return estMinusculeAscii(c | 0x20) || static_cast<unsigned char>(c - '0') <= 9;
+    }
+
+    // Deuxièmes octets des ponctuations U+00A0 (espace insécable), ¡, «, ·, » et ¿, après 0xC2.
+    static inline bool suitPonctuationC2(unsigned char s)
+    {
+        return s == 0xA0 || s == 0xA1 || s == 0xAB || s == 0xB7 || s == 0xBB || s == 0xBF;
+    }
+
+    /**
+    * \fn std::size_t longueurSequence(const unsigned char* p, const unsigned char* fin)
+    * \brief Nombre d'octets du caractère UTF-8 qui commence en p, tronqué à fin
+    */
+    static std::size_t longueurSequence(const unsigned char* p, const unsigned char* fin)
+    {
+        std::size_t longueur = 1;
+        if (*p >= 0xF0) longueur = 4;
+        else if (*p >= 0xE0) longueur = 3;
+        else if (*p >= 0xC0) longueur = 2;
+        return std::min<std::size_t>(longueur, fin - p);
+    }
+
+    /**
+    * \struct MasquesBloc
+    *
+    * \brief Classement des octets d'un bloc : le bit i décrit l'octet i
+    */
+    struct MasquesBloc
+    {
+        std::uint64_t alphanumeriques;   // Lettres et chiffres ASCII.
+        std::uint64_t hauts;             // Octets non ASCII.
+        std::uint64_t ponctuationC2;     // Débuts de ¡ « · » ¿ et de l'espace insécable.
+        std::uint64_t ponctuationE2;     // Débuts de U+2000 à U+203F.
+        std::uint64_t majuscules;        // Débuts des majuscules, ASCII ou UTF-8.
+        std::uint64_t minuscules;        // Débuts des minuscules, ASCII ou UTF-8.
+        std::uint64_t latinMajuscules;   // Débuts des majuscules de Latin-1 (0xC3, 0x80 à 0x9E).
+        std::uint64_t ligatureMajuscules;// Débuts de Œ et Ÿ (0xC5).
+    };
+
+#if defined(__SSE2__)
+    // Comparaison non signée octet par octet : 0xFF là où x <= borne, par min(x, borne) == x.
+    static inline __m128i auPlus(__m128i x, unsigned char borne)
+    {
+        return _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(static_cast<char>(borne))), x);
+    }
+
+    static inline __m128i egal(__m128i x, unsigned char c)
+    {
+        return _mm_cmpeq_epi8(x, _mm_set1_epi8(static_cast<char>(c)));
+    }
+
+    static inline std::uint64_t bits(__m128i x, int decalage)
+    {
+        return static_cast<std::uint64_t>(static_cast<unsigned int>(_mm_movemask_epi8(x))) << decalage;
+    }
+
+    /**
+    * \fn void classerBlocSse2(unsigned char* p, MasquesBloc& masques)
+    * \brief Classe les 64 octets de p, 16 à la fois, et met les majuscules ASCII en minuscules
+    * \pre p[64] est lisible (deuxième octet des caractères qui commencent en p[63]).
+    */
+    static void classerBlocSse2(unsigned char* p, MasquesBloc& masques)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            unsigned char* q = p + 16 * k;
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + 1));   // octets suivants
+
+            __m128i majusculeAscii = auPlus(_mm_sub_epi8(v, _mm_set1_epi8('A')), 25);
+            __m128i minusculeAscii = auPlus(_mm_sub_epi8(v, _mm_set1_epi8('a')), 25);
+            __m128i chiffre = auPlus(_mm_sub_epi8(v, _mm_set1_epi8('0')), 9);
+
+            int decalage = 16 * k;
+            masques.alphanumeriques |= bits(_mm_or_si128(_mm_or_si128(majusculeAscii, minusculeAscii), chiffre), decalage);
+            masques.majuscules |= bits(majusculeAscii, decalage);
+            masques.minuscules |= bits(minusculeAscii, decalage);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q),
+                             _mm_add_epi8(v, _mm_and_si128(majusculeAscii, _mm_set1_epi8(0x20))));
+
+            std::uint64_t hauts = bits(v, decalage);
+            if (hauts == 0) continue;   // que de l'ASCII : rien à voir dans les octets suivants
+
+            __m128i estC3 = egal(v, 0xC3), estC5 = egal(v, 0xC5);
+            __m128i latinMajuscule = _mm_and_si128(estC3, _mm_andnot_si128(egal(s, 0x97),
+                                                                           auPlus(_mm_sub_epi8(s, _mm_set1_epi8(static_cast<char>(0x80))), 0x1E)));
+            __m128i latinMinuscule = _mm_and_si128(estC3, _mm_andnot_si128(egal(s, 0xB7),
+                                                                           auPlus(_mm_sub_epi8(s, _mm_set1_epi8(static_cast<char>(0xA0))), 0x1F)));
+            __m128i ligatureMajuscule = _mm_and_si128(estC5, _mm_or_si128(egal(s, 0x92), egal(s, 0xB8)));
+            __m128i suitC2 = _mm_or_si128(_mm_or_si128(egal(s, 0xA0), egal(s, 0xA1)),
+                                          _mm_or_si128(_mm_or_si128(egal(s, 0xAB), egal(s, 0xB7)),
+                                                       _mm_or_si128(egal(s, 0xBB), egal(s, 0xBF))));
+
+            masques.hauts |= hauts;
+            masques.ponctuationC2 |= bits(_mm_and_si128(egal(v, 0xC2), suitC2), decalage);
+            masques.ponctuationE2 |= bits(_mm_and_si128(egal(v, 0xE2), egal(s, 0x80)), decalage);
+            masques.majuscules |= bits(_mm_or_si128(latinMajuscule, ligatureMajuscule), decalage);
+            masques.minuscules |= bits(_mm_or_si128(latinMinuscule, _mm_and_si128(estC5, egal(s, 0x93))), decalage);
+            masques.latinMajuscules |= bits(latinMajuscule, decalage);
+            masques.ligatureMajuscules |= bits(ligatureMajuscule, decalage);
+        }
+    }
+#endif
+
+    /**
+    * \fn void classerBlocScalaire(unsigned char* p, std::size_t n, const unsigned char* fin, MasquesBloc& masques)
+    * \brief Même classement que classerBlocSse2, octet par octet, pour les n (au plus 64) octets de p
+    */
+    static void classerBlocScalaire(unsigned char* p, std::size_t n, const unsigned char* fin, MasquesBloc& masques)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            unsigned char c = p[i];
+            unsigned char s = (p + i + 1 < fin) ? p[i + 1] : 0;
+            std::uint64_t bit = std::uint64_t(1) << i;
+
+            bool latinMajuscule = c == 0xC3 && s >= 0x80 && s <= 0x9E && s != 0x97;
+            bool ligatureMajuscule = c == 0xC5 && (s == 0x92 || s == 0xB8);
+            if (estAlphanumeriqueAscii(c)) masques.alphanumeriques |= bit;
+            if (c >= 0x80) masques.hauts |= bit;
+            if (c == 0xC2 && suitPonctuationC2(s)) masques.ponctuationC2 |= bit;
+            if (c == 0xE2 && s == 0x80) masques.ponctuationE2 |= bit;
+            if (estMajusculeAscii(c) || latinMajuscule || ligatureMajuscule) masques.majuscules |= bit;
+            if (estMinusculeAscii(c) || (c == 0xC3 && s >= 0xA0 && s != 0xB7) || (c == 0xC5 && s == 0x93))
+                masques.minuscules |= bit;
+            if (latinMajuscule) masques.latinMajuscules |= bit;
+            if (ligatureMajuscule) masques.ligatureMajuscules |= bit;
+
+            if (estMajusculeAscii(c)) p[i] = c + 0x20;
+        }
+    }
+
+    /**
+    * \brief Constructeur
+    *
+    * \pre texte[0..taille[ reste valide et n'est pas modifié ailleurs pendant le découpage.
+    */
+    Segmenteur::Segmenteur(char* texte, std::size_t taille)
+        : fin(texte + taille), bloc(0), prochainBloc(texte), mot(0), majuscules(0), minuscules(0), transitions(0),
+          debordement(0), dernierOctetMot(0), debutSeparateur(texte), debutMot(0), trait(0), debutComptage(0),
+          nbMajuscules(0), nbMinuscules(0), initiale(false)
+    {
+    }
+
+    /**
+    * \brief Remplace lot par les au plus nbMax mots suivants
+    *
+    * \post Les mots retournés sont en minuscules dans le texte.
+    * \return le nombre de mots lus, 0 à la fin du texte.
+    */
+    std::size_t Segmenteur::lireLot(std::vector<Segment>& lot, std::size_t nbMax)
+    {
+        lot.clear();
+        while (lot.size() < nbMax)
+        {
+            if (transitions == 0)
+            {
+                if (chargerBloc()) continue;
+
+                // fin du texte
+                if (trait != 0) terminerMot(trait, lot);
+                else if (debutMot != 0) terminerMot(fin, lot);
+                resteFinal = std::string_view(debutSeparateur, fin - debutSeparateur);
+                break;
+            }
+
+            unsigned int i = __builtin_ctzll(transitions);
+            transitions &= transitions - 1;
+            char* q = bloc + i;
+            if ((mot >> i) & 1)
+            {
+                // un mot commence en q ; juste après un trait d'union, c'est la suite du mot en cours
+                if (trait != 0 && q == trait + 1)
+                {
+                    trait = 0;
+                    continue;
+                }
+                if (trait != 0) terminerMot(trait, lot);
+                commencerMot(q, i);
+            }
+            else if (q < fin && *q == '-')
+            {
+                trait = q;
+            }
+            else
+            {
+                terminerMot(q, lot);
+            }
+        }
+        return lot.size();
+    }
+
+    /**
+    * \brief Retourne mot (en minuscules) écrit avec la casse donnée
+    */
+    std::string Segmenteur::recaser(std::string_view mot, Casse casse)
+    {
+        std::string resultat(mot);
+        if (casse == Minuscules) return resultat;
+
+        unsigned char* p = reinterpret_cast<unsigned char*>(&resultat[0]);
+        unsigned char* f = p + resultat.size();
+        while (p < f)
+        {
+            std::size_t longueur = longueurSequence(p, f);
+            if (longueur == 1 && estMinusculeAscii(*p)) *p -= 0x20;
+            else if (longueur == 2 && p[0] == 0xC3 && p[1] >= 0xA0 && p[1] <= 0xBE && p[1] != 0xB7) p[1] -= 0x20;
+            else if (longueur == 2 && p[0] == 0xC3 && p[1] == 0xBF) { p[0] = 0xC5; p[1] = 0xB8; }
+            else if (longueur == 2 && p[0] == 0xC5 && p[1] == 0x93) p[1] = 0x92;
+            p += longueur;
+            if (casse == Initiale) break;
+        }
+        return resultat;
+    }
+
+    /**
+    * \fn bool chargerBloc()
+    * \brief Passe au bloc suivant : le classe, le met en minuscules et en calcule les transitions
+    * \return faux s'il n'y a plus de bloc
+    */
+    bool Segmenteur::chargerBloc()
+    {
+        if (bloc != 0 && debutMot != 0) compter(prochainBloc);
+        if (prochainBloc >= fin) return false;
+
+        bloc = prochainBloc;
+        std::size_t n = std::min<std::size_t>(64, fin - bloc);
+        prochainBloc = bloc + n;
+
+        unsigned char* p = reinterpret_cast<unsigned char*>(bloc);
+        MasquesBloc masques = MasquesBloc();
+#if defined(__SSE2__)
+        if (n == 64 && prochainBloc < fin) classerBlocSse2(p, masques);
+        else
+#endif
+        classerBlocScalaire(p, n, reinterpret_cast<unsigned char*>(fin), masques);
+
+        // majuscules UTF-8 : le deuxième octet (parfois aussi le premier) change
+        for (std::uint64_t restants = masques.latinMajuscules; restants != 0; restants &= restants - 1)
+            p[__builtin_ctzll(restants) + 1] += 0x20;
+        for (std::uint64_t restants = masques.ligatureMajuscules; restants != 0; restants &= restants - 1)
+        {
+            unsigned int i = __builtin_ctzll(restants);
+            if (p[i + 1] == 0x92) p[i + 1] = 0x93;
+            else { p[i] = 0xC3; p[i + 1] = 0xBF; }
+        }
+
+        // une ponctuation UTF-8 couvre son premier octet et les suivants, parfois jusque dans le bloc suivant
+        std::uint64_t c2 = masques.ponctuationC2, e2 = masques.ponctuationE2;
+        std::uint64_t ponctuation = c2 | (c2 << 1) | e2 | (e2 << 1) | (e2 << 2) | debordement;
+        debordement = (c2 >> 63) | (e2 >> 63) | (e2 >> 62);
+
+        mot = (masques.alphanumeriques | masques.hauts) & ~ponctuation;
+        majuscules = masques.majuscules;
+        minuscules = masques.minuscules;
+        transitions = mot ^ ((mot << 1) | dernierOctetMot);
+        dernierOctetMot = mot >> 63;
+        return true;
+    }
+
+    /**
+    * \fn void commencerMot(char* debut, unsigned int bit)
+    * \brief Note le début d'un mot, à l'octet bit du bloc courant
+    */
+    void Segmenteur::commencerMot(char* debut, unsigned int bit)
+    {
+        debutMot = debut;
+        debutComptage = debut;
+        nbMajuscules = 0;
+        nbMinuscules = 0;
+        initiale = (majuscules >> bit) & 1;
+    }
+
+    /**
+    * \fn void terminerMot(char* finMot, std::vector<Segment>& lot)
+    * \brief Ajoute à lot le mot en cours, qui se termine en finMot
+    */
+    void Segmenteur::terminerMot(char* finMot, std::vector<Segment>& lot)
+    {
+        compter(finMot);
+
+        Segment segment;
+        segment.separateur = std::string_view(debutSeparateur, debutMot - debutSeparateur);
+        segment.mot = std::string_view(debutMot, finMot - debutMot);
+        if (nbMajuscules == 0) segment.casse = Minuscules;
+        else if (nbMinuscules == 0 && nbMajuscules > 1) segment.casse = Majuscules;
+        else if (initiale) segment.casse = Initiale;
+        else segment.casse = Minuscules;
+        lot.push_back(segment);
+
+        debutSeparateur = finMot;
+        debutMot = 0;
+        trait = 0;
+    }
+
+    /**
+    * \fn void compter(char* jusqua)
+    * \brief Compte les majuscules et les minuscules du mot en cours entre debutComptage et jusqua,
+    *        dans le bloc courant
+    */
+    void Segmenteur::compter(char* jusqua)
+    {
+        if (jusqua <= debutComptage) return;
+
+        unsigned int debut = debutComptage - bloc, finPlage = jusqua - bloc;
+        std::uint64_t plage = (finPlage >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << finPlage) - 1)
+                              & ~((std::uint64_t(1) << debut) - 1);
+        nbMajuscules += __builtin_popcountll(majuscules & plage);
+        nbMinuscules += __builtin_popcountll(minuscules & plage);
+        debutComptage = jusqua;
+    }
+
+}//Fin du namespace
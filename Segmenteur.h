@@ -0,0 +1,117 @@
+/**
+* \file Segmenteur.h
+* \brief Interface du type Segmenteur
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef _SEGMENTEUR__H
+#define _SEGMENTEUR__H
+
+namespace TP3
+{
+
+   /**
+   * \class Segmenteur
+   *
+   * \brief Découpe un texte UTF-8 en mots sans copier, en mettant les mots en minuscules sur place.
+   *
+   * Un mot est une suite de lettres et de chiffres ASCII et de caractères UTF-8 non ASCII, avec
+   * des traits d'union intérieurs (« arc-en-ciel »). Tout le reste sépare les mots : espaces,
+   * ponctuation ASCII, apostrophes (' et ’, donc « l'étude » donne « l » et « étude »), et la
+   * ponctuation UTF-8 usuelle en français (« », espaces insécables, tirets, points de suspension,
+   * guillemets courbes, soit U+00A0, U+00A1, U+00AB, U+00B7, U+00BB, U+00BF et U+2000 à U+203F).
+   *
+   * Le texte est classé par blocs de 64 octets (16 à la fois avec SSE2) : chaque bloc donne un
+   * masque de 64 bits des octets qui appartiennent à des mots, et les débuts et fins de mots sont
+   * les bits où ce masque change. Les majuscules ASCII, les majuscules accentuées de Latin-1, Œ
+   * et Ÿ sont mises en minuscules dans le bloc ; la casse d'origine de chaque mot est résumée
+   * dans Segment::casse pour pouvoir la rétablir (recaser).
+   *
+   * Les segments pointent dans le texte : il doit rester valide tant qu'ils sont utilisés.
+   *
+   */
+   class Segmenteur
+   {
+   public:
+
+      /**
+      * \brief Casse d'un mot avant sa mise en minuscules
+      */
+      enum Casse { Minuscules, Initiale, Majuscules };
+
+      /**
+      * \struct Segment
+      *
+      * \brief Un mot et le texte qui le précède
+      */
+      struct Segment
+      {
+         std::string_view separateur;   // Le texte entre le mot précédent (ou le début) et ce mot.
+         std::string_view mot;          // Le mot, en minuscules.
+         Casse casse;
+      };
+
+      /**
+      * \brief Constructeur
+      *
+      * \pre texte[0..taille[ reste valide et n'est pas modifié ailleurs pendant le découpage.
+      */
+      Segmenteur(char* texte, std::size_t taille);
+
+      /**
+      * \brief Remplace lot par les au plus nbMax mots suivants
+      *
+      * \post Les mots retournés sont en minuscules dans le texte.
+      * \return le nombre de mots lus, 0 à la fin du texte.
+      */
+      std::size_t lireLot(std::vector<Segment>& lot, std::size_t nbMax = 1024);
+
+      /**
+      * \brief Le texte qui suit le dernier mot, une fois que lireLot a retourné 0
+      */
+      std::string_view separateurFinal() const { return resteFinal; }
+
+      /**
+      * \brief Retourne mot (en minuscules) écrit avec la casse donnée
+      */
+      static std::string recaser(std::string_view mot, Casse casse);
+
+   private:
+
+      bool chargerBloc();
+      void commencerMot(char* debut, unsigned int bit);
+      void terminerMot(char* finMot, std::vector<Segment>& lot);
+      void compter(char* jusqua);
+
+      char* fin;
+      char* bloc;                  // Début du bloc courant, 0 avant le premier.
+      char* prochainBloc;
+      std::uint64_t mot;           // Masques du bloc courant : octets des mots,
+      std::uint64_t majuscules;    // début des majuscules,
+      std::uint64_t minuscules;    // début des minuscules,
+      std::uint64_t transitions;   // débuts et fins de mots pas encore traités.
+      std::uint64_t debordement;   // Octets du bloc suivant qui terminent une ponctuation UTF-8.
+      std::uint64_t dernierOctetMot;
+      char* debutSeparateur;       // Fin du dernier mot émis.
+      char* debutMot;              // Début du mot en cours, ou 0.
+      char* trait;                 // Trait d'union qui suit le mot en cours, ou 0.
+      char* debutComptage;         // Les lettres du mot en cours sont comptées jusqu'ici.
+      std::size_t nbMajuscules, nbMinuscules;
+      bool initiale;
+      std::string_view resteFinal;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,252 @@
+/**
+* \file ServeurDico.cpp
+* \brief Le code des opérateurs de ServeurDico.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "ServeurDico.h"
+
+#include <cerrno>
+#include <cstring>
+#include <list>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace TP3
+{
+
+    /**
+    * \brief Constructeur
+    *
+    * \pre dico n'est pas modifié tant que le serveur répond à des requêtes.
+    */
+    ServeurDico::ServeurDico(const DicoSynonymes& dico) : dicoFixe(&dico), partage(0), enMarche(false)
+    {
+    }
+
+    /**
+    * \brief Constructeur : chaque bloc de requêtes est traité avec la version de partage courante
+    *        au moment où il est lu.
+    */
+    ServeurDico::ServeurDico(const DicoPartage& partage) : dicoFixe(0), partage(&partage), enMarche(false)
+    {
+    }
+
+    /**
+    * \brief Répond aux requêtes lues sur le descripteur entree, sur le descripteur sortie,
+    *        jusqu'à la fin de l'entrée, la requête Q ou une requête trop longue
+    *
+    * \post Les descripteurs ne sont pas fermés.
+    */
+    void ServeurDico::servir(int entree, int sortie) const
+    {
+        char bloc[65536];
+        std::string enAttente;   // Début d'une requête dont on n'a pas encore reçu la fin.
+        std::string reponses;
+        bool fin = false;
+
+        // sur un socket, send(MSG_NOSIGNAL) : un client parti avant d'avoir lu ses réponses donne
+        // EPIPE au lieu d'un SIGPIPE qui tuerait le processus, sans toucher au traitement des signaux
+        int type;
+        socklen_t tailleType = sizeof(type);
+        bool estSocket = getsockopt(sortie, SOL_SOCKET, SO_TYPE, &type, &tailleType) == 0;
+
+        while (!fin)
+        {
+            ssize_t lus = read(entree, bloc, sizeof(bloc));
+            if (lus < 0 && errno == EINTR) continue;
+            if (lus <= 0) break;
+            enAttente.append(bloc, lus);
+
+            // toutes les requêtes complètes du bloc sont traitées, avec la même version, avant d'écrire quoi que ce soit
+            std::shared_ptr<const DicoSynonymes> dico = version();
+            std::size_t debut = 0;
+            std::size_t finLigne;
+            bool tropLongue = false;
+            while (!fin && !tropLongue && (finLigne = enAttente.find('\n', debut)) != std::string::npos)
+            {
+                std::string requete = enAttente.substr(debut, finLigne - debut);
+                if (!requete.empty() && requete.back() == '\r') requete.pop_back();
+                debut = finLigne + 1;
+
+                if (requete.size() > LONGUEUR_REQUETE_MAX) tropLongue = true;
+                else if (requete == "Q") fin = true;
+                else if (!requete.empty()) (reponses += repondre(*dico, requete)) += '\n';
+            }
+            enAttente.erase(0, debut);
+
+            // une ligne sans fin ne s'accumule pas indéfiniment : au-delà de la limite, on répond et on ferme
+            if (tropLongue || (!fin && enAttente.size() > LONGUEUR_REQUETE_MAX))
+            {
+                reponses += "! requete trop longue\n";
+                fin = true;
+            }
+
+            for (std::size_t ecrits = 0; ecrits < reponses.size();)
+            {
+                ssize_t n = estSocket ? send(sortie, reponses.data() + ecrits, reponses.size() - ecrits, MSG_NOSIGNAL)
+                                      : write(sortie, reponses.data() + ecrits, reponses.size() - ecrits);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return;
+                ecrits += n;
+            }
+            reponses.clear();
+        }
+    }
+
+    /**
+    * \brief Écoute sur le socket Unix chemin et sert chaque client dans son propre fil,
+    *        jusqu'à l'appel de arreter
+    *
+    * \exception runtime_error si le socket ne peut pas être créé
+    */
+    void ServeurDico::ecouter(const std::string& chemin)
+    {
+        sockaddr_un adresse;
+        std::memset(&adresse, 0, sizeof(adresse));
+        adresse.sun_family = AF_UNIX;
+        if (chemin.size() >= sizeof(adresse.sun_path))
+            throw std::runtime_error("ServeurDico::ecouter : Le chemin du socket est trop long");
+        std::strcpy(adresse.sun_path, chemin.c_str());
+
+        int socketEcoute = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socketEcoute < 0)
+            throw std::runtime_error("ServeurDico::ecouter : Impossible de créer le socket");
+        unlink(chemin.c_str());
+        if (bind(socketEcoute, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) != 0
+            || listen(socketEcoute, 64) != 0)
+        {
+            close(socketEcoute);
+            throw std::runtime_error("ServeurDico::ecouter : Impossible d'écouter sur " + chemin);
+        }
+
+        // chaque fil signale sa fin ; les fils terminés sont joints à chaque tour de la boucle,
+        // pour que la liste ne grandisse pas avec le nombre de connexions servies
+        struct Client
+        {
+            std::thread fil;
+            std::atomic<bool> termine { false };
+        };
+        std::list<Client> clients;
+        auto joindreTermines = [&clients]() {
+            for (auto it = clients.begin(); it != clients.end();)
+            {
+                if (!it->termine) { ++it; continue; }
+                it->fil.join();
+                it = clients.erase(it);
+            }
+        };
+
+        enMarche = true;
+        while (enMarche)
+        {
+            joindreTermines();
+
+            // attente bornée pour remarquer l'appel de arreter
+            pollfd attente { socketEcoute, POLLIN, 0 };
+            if (poll(&attente, 1, 200) <= 0) continue;
+
+            int client = accept(socketEcoute, 0, 0);
+            if (client < 0) continue;
+            clients.emplace_back();
+            Client& nouveau = clients.back();
+            nouveau.fil = std::thread([this, client, &nouveau]() {
+                servir(client, client);
+                close(client);
+                nouveau.termine = true;
+            });
+        }
+
+        for (auto &c : clients) c.fil.join();
+        close(socketEcoute);
+        unlink(chemin.c_str());
+    }
+
+    /**
+    * \brief Traite une requête et retourne sa réponse, sans le saut de ligne
+    */
+    std::string ServeurDico::repondre(const std::string& requete) const
+    {
+        return repondre(*version(), requete);
+    }
+
+    /**
+    * \fn std::shared_ptr<const DicoSynonymes> version() const
+    * \brief Retourne le dictionnaire à consulter : la version courante du partage, ou le dictionnaire
+    *        fixe (sans en prendre possession)
+    */
+    std::shared_ptr<const DicoSynonymes> ServeurDico::version() const
+    {
+        if (partage) return partage->acquerir();
+        return std::shared_ptr<const DicoSynonymes>(std::shared_ptr<const DicoSynonymes>(), dicoFixe);
+    }
+
+    /**
+    * \fn std::string repondre(const DicoSynonymes &dico, const std::string &requete) const
+    * \brief Traite une requête sur dico et retourne sa réponse, sans le saut de ligne
+    */
+    std::string ServeurDico::repondre(const DicoSynonymes& dico, const std::string& requete) const
+    {
+        std::istringstream ss(requete);
+        std::string commande;
+        std::string mot;
+        ss >> commande >> mot;
+        if (commande.size() != 1 || mot.empty()) return "! requete mal formee";
+
+        auto liste = [](const std::vector<std::string>& mots) {
+            std::string ligne = "+";
+            for (auto &m : mots) (ligne += ' ') += m;
+            return ligne;
+        };
+
+        try
+        {
+            switch (commande[0])
+            {
+            case 'R':
+            {
+                std::optional<std::string> radical = dico.trouverRadical(mot);
+                return radical ? "+ " + *radical : "-";
+            }
+            case 'F':
+            {
+                std::optional< std::vector<std::string> > flexions = dico.trouverFlexions(mot);
+                return flexions ? liste(*flexions) : "-";
+            }
+            case 'N':
+            {
+                std::optional<int> nbSens = dico.trouverNombreSens(mot);
+                return nbSens ? "+ " + std::to_string(*nbSens) : "-";
+            }
+            case 'S':
+            {
+                int position;
+                if (!(ss >> position)) return "! position attendue";
+                std::optional< std::vector<std::string> > synonymes = dico.trouverSynonymes(mot, position);
+                return synonymes ? liste(*synonymes) : "-";
+            }
+            case 'T':
+            {
+                int k;
+                if (!(ss >> k)) return "! nombre de sauts attendu";
+                if (!dico.contientRadical(mot)) return "-";
+                return liste(dico.synonymesTransitifs(mot, k));
+            }
+            default:
+                return "! commande inconnue";
+            }
+        }
+        catch (std::exception& e)
+        {
+            return std::string("! ") + e.what();
+        }
+    }
+
+}//Fin du namespace
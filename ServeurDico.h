@@ -0,0 +1,105 @@
+/**
+* \file ServeurDico.h
+* \brief Interface du type ServeurDico
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+#include "DicoSynonymes.h"
+#include "DicoPartage.h"
+
+#ifndef _SERVEURDICO__H
+#define _SERVEURDICO__H
+
+namespace TP3
+{
+
+   /**
+   * \class ServeurDico
+   *
+   * \brief Serveur de requêtes sur un dictionnaire chargé une seule fois.
+   *
+   * Le protocole est une ligne par requête et une ligne par réponse, dans le même ordre :
+   *
+   *   R mot                -> + radical
+   *   F radical            -> + flexion1 flexion2 ...
+   *   N radical            -> + nombre de sens
+   *   S radical position   -> + synonyme1 synonyme2 ...
+   *   T radical k          -> + radicaux atteignables en au plus k sauts
+   *   Q                    -> fin de la connexion
+   *
+   * Une requête sans résultat (mot inconnu, position invalide) reçoit « - », une requête mal
+   * formée reçoit « ! message ». Le client peut envoyer plusieurs requêtes sans attendre les
+   * réponses : chaque bloc lu est traité d'un coup et ses réponses sont écrites en une fois.
+   * Une requête de plus de LONGUEUR_REQUETE_MAX octets reçoit « ! requete trop longue » et met
+   * fin à la connexion.
+   *
+   */
+   class ServeurDico
+   {
+   public:
+
+      /**
+      * \brief Constructeur
+      *
+      * \pre dico n'est pas modifié tant que le serveur répond à des requêtes.
+      */
+      explicit ServeurDico(const DicoSynonymes& dico);
+
+      /**
+      * \brief Constructeur : chaque bloc de requêtes est traité avec la version de partage courante
+      *        au moment où il est lu. Une nouvelle version peut être publiée pendant que le serveur répond.
+      */
+      explicit ServeurDico(const DicoPartage& partage);
+
+      /**
+      * \brief Répond aux requêtes lues sur le descripteur entree, sur le descripteur sortie,
+      *        jusqu'à la fin de l'entrée, la requête Q ou une requête trop longue
+      *
+      * \post Les descripteurs ne sont pas fermés.
+      */
+      void servir(int entree, int sortie) const;
+
+      /**
+      * \brief Écoute sur le socket Unix chemin et sert chaque client dans son propre fil,
+      *        jusqu'à l'appel de arreter
+      *
+      * \exception runtime_error si le socket ne peut pas être créé
+      */
+      void ecouter(const std::string& chemin);
+
+      /**
+      * \brief Demande à ecouter de se terminer ; peut être appelée depuis un autre fil
+      */
+      void arreter() { enMarche = false; }
+
+      /**
+      * \brief Traite une requête et retourne sa réponse, sans le saut de ligne
+      */
+      std::string repondre(const std::string& requete) const;
+
+      static const std::size_t LONGUEUR_REQUETE_MAX = 64 << 10;   // Au-delà, la connexion est fermée.
+
+   private:
+
+      std::shared_ptr<const DicoSynonymes> version() const;
+      std::string repondre(const DicoSynonymes& dico, const std::string& requete) const;
+
+      const DicoSynonymes* dicoFixe;          // Le dictionnaire du premier constructeur, sinon 0.
+      const DicoPartage* partage;             // La source des versions du second constructeur, sinon 0.
+      std::atomic<bool> enMarche;
+   };
+
+}//Fin du namespace
+
+#endif
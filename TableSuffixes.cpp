@@ -0,0 +1,189 @@
+/**
+* \file TableSuffixes.cpp
+* \brief Le code des opérateurs de TableSuffixes.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "TableSuffixes.h"
+
+namespace TP3
+{
+
+    /**
+    * \brief Compresse motFlexion par rapport à motRadical, en ajoutant sa terminaison à la table au besoin
+    *
+    * \exception length_error si la table dépasse 4 Go
+    * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+    */
+    TableSuffixes::Code TableSuffixes::compresser(std::string_view motRadical, std::string_view motFlexion)
+    {
+        std::size_t prefixe = longueurPrefixeCommun(motRadical, motFlexion);
+        std::string_view suffixe = motFlexion.substr(prefixe);
+
+        std::size_t position = alveole(suffixe);
+        std::uint32_t identifiant;
+        if (position != alveoles.size() && alveoles[position] != 0)
+        {
+            identifiant = alveoles[position] - 1;
+        }
+        else
+        {
+            if (texte.size() + suffixe.size() > 0xFFFFFFFFu || fins.size() >= 0xFFFFFFFEu)
+                throw std::length_error("TableSuffixes::compresser : La table des suffixes est pleine");
+            identifiant = static_cast<std::uint32_t>(fins.size());
+            texte.append(suffixe.data(), suffixe.size());
+            fins.push_back(static_cast<std::uint32_t>(texte.size()));
+
+            // au plus une alvéole sur deux occupée
+            if (2 * fins.size() > alveoles.size()) agrandirAlveoles();
+            else alveoles[position] = identifiant + 1;
+        }
+
+        Code code;
+        ajouterNaturel(code, prefixe);
+        ajouterNaturel(code, identifiant);
+        return code;
+    }
+
+    /**
+    * \brief Calcule dans code le code de motFlexion sans modifier la table ni allouer
+    *
+    * \return faux si la terminaison n'est pas dans la table (la flexion ne peut donc pas être présente)
+    */
+    bool TableSuffixes::coder(std::string_view motRadical, std::string_view motFlexion, Code& code) const
+    {
+        std::size_t prefixe = longueurPrefixeCommun(motRadical, motFlexion);
+        std::size_t position = alveole(motFlexion.substr(prefixe));
+        if (position == alveoles.size() || alveoles[position] == 0) return false;
+
+        code.taille = 0;
+        ajouterNaturel(code, prefixe);
+        ajouterNaturel(code, alveoles[position] - 1);
+        return true;
+    }
+
+    /**
+    * \brief Reconstruit la flexion correspondant au code
+    *
+    * \pre code a été obtenu de cette table pour motRadical
+    */
+    std::string TableSuffixes::decompresser(std::string_view motRadical, std::string_view code) const
+    {
+        const char* p = code.data();
+        std::size_t prefixe = lireNaturel(p);
+        std::string_view suffixe = terminaison(static_cast<std::uint32_t>(lireNaturel(p)));
+
+        std::string flexion;
+        flexion.reserve(prefixe + suffixe.size());
+        flexion.append(motRadical.data(), prefixe);
+        flexion.append(suffixe.data(), suffixe.size());
+        return flexion;
+    }
+
+    /**
+    * \brief Vide la table
+    */
+    void TableSuffixes::vider()
+    {
+        texte.clear();
+        fins.clear();
+        alveoles.clear();
+    }
+
+    /**
+    * \fn std::size_t longueurPrefixeCommun(std::string_view motRadical, std::string_view motFlexion)
+    * \brief Longueur du plus long préfixe commun aux deux mots, bornée à 255 (2 octets au plus dans le code)
+    */
+    std::size_t TableSuffixes::longueurPrefixeCommun(std::string_view motRadical, std::string_view motFlexion)
+    {
+        std::size_t borne = std::min<std::size_t>({ motRadical.size(), motFlexion.size(), 255 });
+        std::size_t i = 0;
+        while (i < borne && motRadical[i] == motFlexion[i]) ++i;
+        return i;
+    }
+
+    /**
+    * \fn void ajouterNaturel(Code& code, std::uint64_t valeur)
+    * \brief Ajoute valeur à la fin de code en entier variable (LEB128)
+    */
+    void TableSuffixes::ajouterNaturel(Code& code, std::uint64_t valeur)
+    {
+        while (valeur >= 0x80)
+        {
+            code.octets[code.taille++] = static_cast<char>(valeur | 0x80);
+            valeur >>= 7;
+        }
+        code.octets[code.taille++] = static_cast<char>(valeur);
+    }
+
+    /**
+    * \fn std::uint64_t lireNaturel(const char*& p)
+    * \brief Lit un entier variable (LEB128) et avance p
+    */
+    std::uint64_t TableSuffixes::lireNaturel(const char*& p)
+    {
+        std::uint64_t valeur = 0;
+        for (int decalage = 0; ; decalage += 7)
+        {
+            unsigned char octet = *p++;
+            valeur |= static_cast<std::uint64_t>(octet & 0x7F) << decalage;
+            if (!(octet & 0x80)) return valeur;
+        }
+    }
+
+    /**
+    * \fn std::string_view terminaison(std::uint32_t identifiant) const
+    * \brief La terminaison d'identifiant donné, dans le tampon
+    */
+    std::string_view TableSuffixes::terminaison(std::uint32_t identifiant) const
+    {
+        std::uint32_t debut = identifiant == 0 ? 0 : fins[identifiant - 1];
+        return std::string_view(texte).substr(debut, fins[identifiant] - debut);
+    }
+
+    /**
+    * \fn std::size_t alveole(std::string_view suffixe) const
+    * \brief Alvéole de suffixe, ou la première alvéole vide de sa suite de sondage
+    * \return alveoles.size() si la table n'a encore aucune alvéole
+    */
+    std::size_t TableSuffixes::alveole(std::string_view suffixe) const
+    {
+        if (alveoles.empty()) return 0;
+
+        std::size_t masque = alveoles.size() - 1;
+        std::size_t position = std::hash<std::string_view>()(suffixe) & masque;
+        while (alveoles[position] != 0 && terminaison(alveoles[position] - 1) != suffixe)
+            position = (position + 1) & masque;
+        return position;
+    }
+
+    /**
+    * \fn void agrandirAlveoles()
+    * \brief Double le nombre d'alvéoles (16 au départ) et y replace toutes les terminaisons
+    */
+    void TableSuffixes::agrandirAlveoles()
+    {
+        std::vector<std::uint32_t>(std::max<std::size_t>(16, 2 * alveoles.size()), 0).swap(alveoles);
+        std::size_t masque = alveoles.size() - 1;
+        for (std::uint32_t identifiant = 0; identifiant < fins.size(); ++identifiant)
+        {
+            std::size_t position = std::hash<std::string_view>()(terminaison(identifiant)) & masque;
+            while (alveoles[position] != 0) position = (position + 1) & masque;
+            alveoles[position] = identifiant + 1;
+        }
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t TableSuffixes::memoire() const
+    {
+        return octetsChaine(texte) + octetsVecteur(fins) + octetsVecteur(alveoles);
+    }
+
+}//Fin du namespace
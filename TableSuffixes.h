@@ -0,0 +1,113 @@
+/**
+* \file TableSuffixes.h
+* \brief Interface du type TableSuffixes
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "Memoire.h"
+
+#ifndef _TABLESUFFIXES__H
+#define _TABLESUFFIXES__H
+
+namespace TP3
+{
+
+   /**
+   * \class TableSuffixes
+   *
+   * \brief Table globale des terminaisons de flexions.
+   *
+   * Une flexion compressée est représentée par un code de quelques octets : la longueur du préfixe
+   * partagé avec le radical puis l'identifiant de la terminaison dans cette table, chacun en entier
+   * variable (7 bits par octet). Chaque terminaison distincte ("s", "e", "es", "ement", ...) n'est
+   * donc emmagasinée qu'une seule fois pour tout le dictionnaire, et une flexion ordinaire tient
+   * dans 2 octets. Un code est une chaîne d'octets comme une autre : il se range dans le conteneur
+   * de flexions du noeud à la place de la flexion.
+   *
+   * Les terminaisons sont mises bout à bout dans un seul tampon et retrouvées par une table de
+   * hachage ouverte qui compare directement dans ce tampon : chercher un code n'alloue rien.
+   *
+   */
+   class TableSuffixes
+   {
+   public:
+
+      static const std::size_t TAILLE_CODE_MAX = 7;   // Préfixe (2 octets au plus) et identifiant (5 au plus).
+
+      /**
+      * \struct Code
+      *
+      * \brief Le code d'une flexion, sans allocation
+      */
+      struct Code
+      {
+         char octets[TAILLE_CODE_MAX];
+         std::uint8_t taille = 0;
+
+         std::string_view vue() const { return std::string_view(octets, taille); }
+      };
+
+      /**
+      * \brief Compresse motFlexion par rapport à motRadical, en ajoutant sa terminaison à la table au besoin
+      *
+      * \exception length_error si la table dépasse 4 Go
+      * \exception bad_alloc si il n'y a pas suffisament de mémoire.
+      */
+      Code compresser(std::string_view motRadical, std::string_view motFlexion);
+
+      /**
+      * \brief Calcule dans code le code de motFlexion sans modifier la table ni allouer
+      *
+      * \return faux si la terminaison n'est pas dans la table (la flexion ne peut donc pas être présente)
+      */
+      bool coder(std::string_view motRadical, std::string_view motFlexion, Code& code) const;
+
+      /**
+      * \brief Reconstruit la flexion correspondant au code
+      *
+      * \pre code a été obtenu de cette table pour motRadical
+      */
+      std::string decompresser(std::string_view motRadical, std::string_view code) const;
+
+      /**
+      * \brief Vide la table
+      */
+      void vider();
+
+      std::size_t nombreSuffixes() const { return fins.size(); }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+   private:
+
+      static std::size_t longueurPrefixeCommun(std::string_view motRadical, std::string_view motFlexion);
+      static void ajouterNaturel(Code& code, std::uint64_t valeur);
+      static std::uint64_t lireNaturel(const char*& p);
+
+      std::string_view terminaison(std::uint32_t identifiant) const;
+      std::size_t alveole(std::string_view suffixe) const;
+      void agrandirAlveoles();
+
+      std::string texte;                   // Les terminaisons, bout à bout.
+      std::vector<std::uint32_t> fins;     // fins[id] : fin de la terminaison id dans texte (elle commence à fins[id - 1]).
+      std::vector<std::uint32_t> alveoles; // Table de hachage ouverte : identifiant + 1, 0 pour une alvéole vide.
+   };
+
+}//Fin du namespace
+
+#endif
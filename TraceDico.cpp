@@ -0,0 +1,291 @@
+/**
+* \file TraceDico.cpp
+* \brief Le code des opérateurs de TraceDico.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "TraceDico.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace TP3
+{
+
+    static const char MAGIE_TRACE[8] = { 'D', 'I', 'C', 'O', 'T', 'R', 'C', '1' };
+    static const std::size_t TAILLE_BLOC = 64 << 10;      // Le tampon est écrit dès qu'il dépasse cette taille.
+
+    thread_local bool TraceDico::appelEnCours = false;
+
+    /**
+    * \fn bool lireNaturel(const char*& p, const char* fin, std::uint64_t& valeur)
+    * \brief Lit un entier variable (LEB128) ; faux si les octets manquent ou sont invalides
+    */
+    static bool lireNaturel(const char*& p, const char* fin, std::uint64_t& valeur)
+    {
+        valeur = 0;
+        for (int decalage = 0; decalage < 64; decalage += 7)
+        {
+            if (p == fin) return false;
+            unsigned char octet = *p++;
+            valeur |= static_cast<std::uint64_t>(octet & 0x7F) << decalage;
+            if (!(octet & 0x80)) return true;
+        }
+        return false;
+    }
+
+    /**
+    * \brief Vrai si operation modifie le dictionnaire ou sa configuration
+    */
+    bool TraceDico::estModification(Operation operation)
+    {
+        switch (operation)
+        {
+        case AjoutRadical: case AjoutFlexion: case AjoutSynonyme: case AjoutFlexions: case AjoutGroupeSynonymes:
+        case ApplicationLot: case SuppressionIntervalle: case SuppressionRadical: case SuppressionFlexion:
+        case SuppressionSynonyme: case CompressionFlexions: case ActivationCache: case ActivationRaciniseur:
+        case Compactage: case ConsolidationGroupes: case ConsolidationEnLigne:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+    * \brief Nom de l'opération (celui de la méthode de DicoSynonymes)
+    */
+    const char* TraceDico::nom(Operation operation)
+    {
+        static const char* const NOMS[] = {
+            "?", "ajouterRadical", "ajouterFlexion", "ajouterSynonyme", "ajouterFlexions", "ajouterGroupeSynonymes",
+            "appliquerLot", "supprimerIntervalle", "supprimerRadical", "supprimerFlexion", "supprimerSynonyme",
+            "contientRadical", "radicalAuRang", "rang", "page", "rechercherRadical", "similitude",
+            "getNombreSens", "getSens", "getSynonymes", "getFlexions",
+            "trouverRadical", "trouverNombreSens", "trouverSens", "trouverSynonymes", "trouverFlexions",
+            "synonymesTransitifs", "synonymesTransitifs (lot)", "devinerRadical", "radicalLePlusProche",
+            "compresserFlexions", "activerCache", "activerRaciniseur", "compacter",
+            "consoliderGroupes", "consoliderEnLigne"
+        };
+        return operation < std::size(NOMS) ? NOMS[operation] : "?";
+    }
+
+    /**
+    * \brief Décode une chaîne
+    * \exception runtime_error si les arguments sont plus courts qu'attendu.
+    */
+    std::string TraceDico::LecteurArguments::chaine()
+    {
+        std::uint64_t longueur = naturel();
+        if (static_cast<std::uint64_t>(fin - p) < longueur)
+            throw std::runtime_error("TraceDico : Arguments incomplets");
+        std::string s(p, longueur);
+        p += longueur;
+        return s;
+    }
+
+    /**
+    * \brief Décode un tableau de chaînes
+    */
+    std::vector<std::string> TraceDico::LecteurArguments::chaines()
+    {
+        std::uint64_t nombre = naturel();
+        if (static_cast<std::uint64_t>(fin - p) < nombre)
+            throw std::runtime_error("TraceDico : Arguments incomplets");
+        std::vector<std::string> mots;
+        mots.reserve(nombre);
+        for (std::uint64_t i = 0; i < nombre; ++i) mots.push_back(chaine());
+        return mots;
+    }
+
+    /**
+    * \brief Décode un entier (zigzag)
+    */
+    std::int64_t TraceDico::LecteurArguments::entier()
+    {
+        std::uint64_t v = naturel();
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    /**
+    * \brief Décode un float
+    */
+    float TraceDico::LecteurArguments::reel()
+    {
+        float valeur;
+        if (static_cast<std::size_t>(fin - p) < sizeof(valeur))
+            throw std::runtime_error("TraceDico : Arguments incomplets");
+        std::memcpy(&valeur, p, sizeof(valeur));
+        p += sizeof(valeur);
+        return valeur;
+    }
+
+    /**
+    * \brief Décode un nombre d'éléments
+    */
+    std::uint64_t TraceDico::LecteurArguments::naturel()
+    {
+        std::uint64_t valeur;
+        if (!lireNaturel(p, fin, valeur))
+            throw std::runtime_error("TraceDico : Arguments incomplets");
+        return valeur;
+    }
+
+    /**
+    * \brief Crée (ou écrase) la trace chemin
+    *
+    * \exception runtime_error si le fichier ne peut pas être créé.
+    */
+    TraceDico::TraceDico(const std::string& chemin)
+        : fichier(chemin, std::ios::binary | std::ios::trunc), ouverture(std::chrono::steady_clock::now()),
+          dernierInstant(0), nbAppels(0)
+    {
+        if (!fichier.is_open())
+            throw std::runtime_error("TraceDico : Impossible de créer " + chemin);
+        tampon.append(MAGIE_TRACE, sizeof(MAGIE_TRACE));
+    }
+
+    /**
+    * \brief Destructeur. Les appels encore dans le tampon sont écrits.
+    */
+    TraceDico::~TraceDico()
+    {
+        try
+        {
+            vider();
+        }
+        catch (const std::exception&)
+        {
+            // un destructeur ne lance pas : les derniers appels sont perdus
+        }
+    }
+
+    /**
+    * \brief Écrit les appels tamponnés
+    *
+    * \exception runtime_error si le fichier ne peut pas être écrit.
+    */
+    void TraceDico::vider()
+    {
+        std::lock_guard<std::mutex> garde(verrou);
+        fichier.write(tampon.data(), tampon.size());
+        fichier.flush();
+        tampon.clear();
+        if (!fichier)
+            throw std::runtime_error("TraceDico : Impossible d'écrire la trace");
+    }
+
+    /**
+    * \brief Nombre d'appels enregistrés depuis l'ouverture
+    */
+    std::size_t TraceDico::nombreAppels()
+    {
+        std::lock_guard<std::mutex> garde(verrou);
+        return nbAppels;
+    }
+
+    /**
+    * \brief Lit tous les appels de la trace chemin
+    *
+    * \exception runtime_error si le fichier ne peut pas être lu ou n'est pas une trace.
+    */
+    std::vector<TraceDico::Appel> TraceDico::lire(const std::string& chemin)
+    {
+        std::ifstream entree(chemin, std::ios::binary);
+        if (!entree.is_open())
+            throw std::runtime_error("TraceDico : Impossible d'ouvrir " + chemin);
+        std::string contenu((std::istreambuf_iterator<char>(entree)), std::istreambuf_iterator<char>());
+        if (contenu.size() < sizeof(MAGIE_TRACE) || std::memcmp(contenu.data(), MAGIE_TRACE, sizeof(MAGIE_TRACE)) != 0)
+            throw std::runtime_error("TraceDico : " + chemin + " n'est pas une trace");
+
+        std::vector<Appel> appels;
+        std::uint64_t instant = 0;
+        const char* p = contenu.data() + sizeof(MAGIE_TRACE);
+        const char* fin = contenu.data() + contenu.size();
+        while (p < fin)
+        {
+            unsigned char operation = *p++;
+            std::uint64_t delai, taille;
+            if (!lireNaturel(p, fin, delai) || !lireNaturel(p, fin, taille)
+                || static_cast<std::uint64_t>(fin - p) < taille) break;
+
+            instant += delai;
+            if (nom(static_cast<Operation>(operation))[0] != '?')
+                appels.push_back({static_cast<Operation>(operation), instant, std::string(p, taille)});
+            p += taille;
+        }
+        return appels;
+    }
+
+    /**
+    * \brief Tampon des arguments de l'appel en cours d'enregistrement dans ce fil
+    */
+    std::string& TraceDico::tamponArguments()
+    {
+        thread_local std::string arguments;
+        return arguments;
+    }
+
+    void TraceDico::ajouterNaturel(std::string& tampon, std::uint64_t valeur)
+    {
+        while (valeur >= 0x80)
+        {
+            tampon.push_back(static_cast<char>(valeur | 0x80));
+            valeur >>= 7;
+        }
+        tampon.push_back(static_cast<char>(valeur));
+    }
+
+    void TraceDico::ajouter(std::string& tampon, std::string_view s)
+    {
+        ajouterNaturel(tampon, s.size());
+        tampon.append(s.data(), s.size());
+    }
+
+    void TraceDico::ajouter(std::string& tampon, const std::vector<std::string>& mots)
+    {
+        ajouterNaturel(tampon, mots.size());
+        for (auto &mot : mots) ajouter(tampon, mot);
+    }
+
+    void TraceDico::ajouter(std::string& tampon, float valeur)
+    {
+        char octets[sizeof(valeur)];
+        std::memcpy(octets, &valeur, sizeof(valeur));
+        tampon.append(octets, sizeof(octets));
+    }
+
+    /**
+    * \brief Ajoute un enregistrement au tampon, écrit le tampon s'il est plein
+    *
+    * L'instant est pris sous le verrou : les délais des enregistrements successifs ne sont
+    * jamais négatifs, même quand plusieurs fils enregistrent.
+    *
+    * \exception runtime_error si le fichier ne peut pas être écrit.
+    */
+    void TraceDico::ecrire(Operation operation, const std::string& arguments)
+    {
+        std::lock_guard<std::mutex> garde(verrou);
+        std::uint64_t instant = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - ouverture).count();
+        tampon.push_back(static_cast<char>(operation));
+        ajouterNaturel(tampon, instant - dernierInstant);
+        ajouterNaturel(tampon, arguments.size());
+        tampon += arguments;
+        dernierInstant = instant;
+        ++nbAppels;
+
+        if (tampon.size() >= TAILLE_BLOC)
+        {
+            fichier.write(tampon.data(), tampon.size());
+            tampon.clear();
+            if (!fichier)
+                throw std::runtime_error("TraceDico : Impossible d'écrire la trace");
+        }
+    }
+
+}//Fin du namespace
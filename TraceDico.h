@@ -0,0 +1,226 @@
+/**
+* \file TraceDico.h
+* \brief Interface du type TraceDico
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <mutex>
+#include <chrono>
+#include <type_traits>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#ifndef _TRACEDICO__H
+#define _TRACEDICO__H
+
+namespace TP3
+{
+
+   /**
+   * \class TraceDico
+   *
+   * \brief Enregistre les appels publics faits à un DicoSynonymes (voir enregistrerTrace) dans
+   *        une trace binaire compacte, rejouable par RejeuTrace.
+   *
+   * Le fichier commence par 8 octets magiques, suivis d'un enregistrement par appel :
+   *
+   *   operation (1 octet) | délai depuis l'appel précédent en ns | taille des arguments | arguments
+   *
+   * Les nombres sont des entiers variables (7 bits par octet, LEB128) ; les entiers signés sont
+   * d'abord repliés en zigzag. Une chaîne est sa longueur suivie de ses octets, un tableau son
+   * nombre d'éléments suivi des éléments, un float ses 4 octets. La taille des arguments permet
+   * de sauter une opération inconnue : une trace reste lisible par une version plus récente.
+   *
+   * Seul l'appel le plus extérieur d'un fil est enregistré : getSens, qui appelle trouverSens,
+   * donne un seul enregistrement. Les appels sont tamponnés et écrits par blocs.
+   *
+   */
+   class TraceDico
+   {
+   public:
+
+      /**
+      * \brief Les opérations enregistrées. Les numéros font partie du format : on ajoute à la fin.
+      */
+      enum Operation : std::uint8_t
+      {
+         AjoutRadical = 1, AjoutFlexion, AjoutSynonyme, AjoutFlexions, AjoutGroupeSynonymes, ApplicationLot,
+         SuppressionIntervalle, SuppressionRadical, SuppressionFlexion, SuppressionSynonyme,
+         ContientRadical, RadicalAuRang, Rang, Page, RechercheRadical, Similitude,
+         NombreSens, Sens, Synonymes, Flexions,
+         TrouverRadical, TrouverNombreSens, TrouverSens, TrouverSynonymes, TrouverFlexions,
+         SynonymesTransitifs, SynonymesTransitifsLot, DevinerRadical, RadicalLePlusProche,
+         CompressionFlexions, ActivationCache, ActivationRaciniseur, Compactage,
+         ConsolidationGroupes, ConsolidationEnLigne
+      };
+
+      /**
+      * \brief Vrai si operation modifie le dictionnaire ou sa configuration : elle ne peut pas
+      *        être exécutée en même temps qu'un autre appel
+      */
+      static bool estModification(Operation operation);
+
+      /**
+      * \brief Nom de l'opération (celui de la méthode de DicoSynonymes)
+      */
+      static const char* nom(Operation operation);
+
+      /**
+      * \struct Appel
+      *
+      * \brief Un enregistrement lu dans une trace ; arguments se décode avec LecteurArguments.
+      */
+      struct Appel
+      {
+         Operation operation;
+         std::uint64_t instant;        // Nanosecondes depuis l'ouverture de la trace.
+         std::string arguments;
+      };
+
+      /**
+      * \class LecteurArguments
+      *
+      * \brief Décode, dans l'ordre, les arguments d'un Appel
+      */
+      class LecteurArguments
+      {
+      public:
+         explicit LecteurArguments(const std::string& arguments)
+            : p(arguments.data()), fin(arguments.data() + arguments.size()) { }
+
+         /**
+         * \exception runtime_error si les arguments sont plus courts qu'attendu.
+         */
+         std::string chaine();
+         std::vector<std::string> chaines();
+         std::int64_t entier();
+         float reel();
+         std::uint64_t naturel();      // Un nombre d'éléments.
+
+      private:
+
+         const char* p;
+         const char* fin;
+      };
+
+      /**
+      * \brief Crée (ou écrase) la trace chemin
+      *
+      * \exception runtime_error si le fichier ne peut pas être créé.
+      */
+      explicit TraceDico(const std::string& chemin);
+
+      /**
+      * \brief Destructeur. Les appels encore dans le tampon sont écrits.
+      */
+      ~TraceDico();
+
+      TraceDico(const TraceDico&) = delete;
+      TraceDico& operator=(const TraceDico&) = delete;
+
+      /**
+      * \brief Écrit les appels tamponnés
+      *
+      * \exception runtime_error si le fichier ne peut pas être écrit.
+      */
+      void vider();
+
+      /**
+      * \brief Nombre d'appels enregistrés depuis l'ouverture
+      */
+      std::size_t nombreAppels();
+
+      /**
+      * \brief Lit tous les appels de la trace chemin. Un dernier enregistrement incomplet
+      *        (trace interrompue) est ignoré, de même que les opérations inconnues.
+      *
+      * \exception runtime_error si le fichier ne peut pas être lu ou n'est pas une trace.
+      */
+      static std::vector<Appel> lire(const std::string& chemin);
+
+      /**
+      * \class Garde
+      *
+      * \brief Placée au début d'une méthode publique : enregistre l'appel si trace n'est pas nul
+      *        et qu'aucun autre appel enregistré n'est en cours dans ce fil.
+      *
+      * Sans trace, rien n'est évalué ni copié. Les arguments reconnus sont les chaînes, les
+      * tableaux de chaînes, les entiers, bool, float et les tableaux de DicoSynonymes::Mutation.
+      */
+      class Garde
+      {
+      public:
+         template <class... Arguments>
+         Garde(TraceDico* trace, Operation operation, const Arguments&... arguments) : active(false)
+         {
+            if (trace == 0 || appelEnCours) return;
+            std::string& tampon = tamponArguments();
+            tampon.clear();
+            (ajouter(tampon, arguments), ...);
+            trace->ecrire(operation, tampon);
+            appelEnCours = active = true;
+         }
+
+         ~Garde() { if (active) appelEnCours = false; }
+
+         Garde(const Garde&) = delete;
+         Garde& operator=(const Garde&) = delete;
+
+      private:
+         bool active;
+      };
+
+   private:
+
+      static thread_local bool appelEnCours;     // Un appel enregistré est en cours dans ce fil.
+      static std::string& tamponArguments();
+
+      static void ajouterNaturel(std::string& tampon, std::uint64_t valeur);
+      static void ajouter(std::string& tampon, std::string_view s);
+      static void ajouter(std::string& tampon, const std::string& s) { ajouter(tampon, std::string_view(s)); }
+      static void ajouter(std::string& tampon, const std::vector<std::string>& mots);
+      static void ajouter(std::string& tampon, float valeur);
+
+      template <class Entier, class = typename std::enable_if<std::is_integral<Entier>::value>::type>
+      static void ajouter(std::string& tampon, Entier valeur)
+      {
+         std::int64_t v = static_cast<std::int64_t>(valeur);
+         ajouterNaturel(tampon, (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+      }
+
+      // Un tableau de DicoSynonymes::Mutation : type, radical et flexion de chacune.
+      template <class Mutation>
+      static void ajouter(std::string& tampon, const std::vector<Mutation>& mutations)
+      {
+         ajouterNaturel(tampon, mutations.size());
+         for (auto &mutation : mutations)
+         {
+            ajouter(tampon, static_cast<int>(mutation.type));
+            ajouter(tampon, mutation.radical);
+            ajouter(tampon, mutation.flexion);
+         }
+      }
+
+      void ecrire(Operation operation, const std::string& arguments);
+
+      std::mutex verrou;                                   // Protège tout ce qui suit.
+      std::ofstream fichier;
+      std::string tampon;                                  // Enregistrements pas encore écrits.
+      std::chrono::steady_clock::time_point ouverture;
+      std::uint64_t dernierInstant;                        // Instant du dernier appel enregistré, en ns.
+      std::size_t nbAppels;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,58 @@
+/**
+* \file TraitsDico.cpp
+* \brief Le code des opérateurs de TraitsSansCasseNiAccents.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "TraitsDico.h"
+
+namespace TP3
+{
+
+    // Forme sans accent des caractères U+00C0 à U+00FF (encodés 0xC3 0x80 à 0xC3 0xBF) ;
+    // 0 pour ceux qui restent tels quels (×, Þ, ÷, þ).
+    static const char* const SANS_ACCENT[64] = {
+        "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+        "d", "n", "o", "o", "o", "o", "o", 0, "o", "u", "u", "u", "u", "y", 0, "ss",
+        "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+        "d", "n", "o", "o", "o", "o", "o", 0, "o", "u", "u", "u", "u", "y", 0, "y"
+    };
+
+    /**
+    * \brief Retourne mot en minuscules, sans accents
+    *
+    * Les octets qui ne sont ni des majuscules ASCII ni une lettre latine accentuée en UTF-8
+    * (y compris Œ et œ) sont recopiés tels quels.
+    */
+    std::string TraitsSansCasseNiAccents::normaliser(const std::string& mot)
+    {
+        std::string resultat;
+        resultat.reserve(mot.size());
+        for (std::size_t i = 0; i < mot.size(); ++i)
+        {
+            unsigned char c = mot[i];
+            unsigned char suivant = i + 1 < mot.size() ? static_cast<unsigned char>(mot[i + 1]) : 0;
+            if (c >= 'A' && c <= 'Z')
+                resultat.push_back(static_cast<char>(c - 'A' + 'a'));
+            else if (c == 0xC3 && suivant >= 0x80 && suivant <= 0xBF && SANS_ACCENT[suivant - 0x80])
+            {
+                resultat += SANS_ACCENT[suivant - 0x80];
+                ++i;
+            }
+            else if (c == 0xC5 && (suivant == 0x92 || suivant == 0x93))
+            {
+                resultat += "oe";
+                ++i;
+            }
+            else
+                resultat.push_back(static_cast<char>(c));
+        }
+        return resultat;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,76 @@
+/**
+* \file TraitsDico.h
+* \brief Interface des types TraitsDico et TraitsSansCasseNiAccents
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <memory>
+
+#include "ListeFlexions.h"
+#include "VecteurFlexions.h"
+
+#ifndef _TRAITSDICO__H
+#define _TRAITSDICO__H
+
+namespace TP3
+{
+
+   /**
+   * \struct TraitsDico
+   *
+   * \brief Politiques de DicoSynonymesGenerique, choisies à la compilation : le comportement habituel.
+   *
+   * Un type de traits fournit :
+   *
+   *   normaliser(mot)     la forme sous laquelle un mot reçu est conservé et cherché. Retourner une
+   *                       référence sur mot (l'identité) ne coûte rien ; retourner une std::string
+   *                       fait normaliser tous les mots reçus par le dictionnaire.
+   *   inferieur(a, b)     l'ordre des radicaux dans l'arbre (rang, page, supprimerIntervalle...), sur
+   *                       des mots déjà normalisés. Deux mots dont aucun n'est inférieur à l'autre
+   *                       doivent être égaux.
+   *   Allocateur          l'allocateur des noeuds de l'arbre (réassocié au type des noeuds). Il est
+   *                       construit par défaut ; deux instances doivent être interchangeables.
+   *   ConteneurFlexions   les flexions d'un radical non compressées : même interface que ListeFlexions.
+   *
+   */
+   struct TraitsDico
+   {
+      typedef std::allocator<char> Allocateur;
+      typedef ListeFlexions ConteneurFlexions;
+
+      static const std::string& normaliser(const std::string& mot) { return mot; }
+      static bool inferieur(const std::string& a, const std::string& b) { return a < b; }
+   };
+
+   /**
+   * \struct TraitsSansCasseNiAccents
+   *
+   * \brief Comme TraitsDico, mais « Grand », « grand » et « GRAND » sont le même mot, de même que
+   *        « élève » et « eleve » : les majuscules ASCII et les lettres accentuées latines (UTF-8)
+   *        sont ramenées à leur minuscule sans accent avant toute recherche ou insertion.
+   */
+   struct TraitsSansCasseNiAccents : TraitsDico
+   {
+      static std::string normaliser(const std::string& mot);
+   };
+
+   /**
+   * \struct TraitsFlexionsSeparees
+   *
+   * \brief Comme TraitsDico, mais chaque flexion est une std::string (VecteurFlexions) : plus de
+   *        mémoire, mais aucune copie pour lire une flexion.
+   */
+   struct TraitsFlexionsSeparees : TraitsDico
+   {
+      typedef VecteurFlexions ConteneurFlexions;
+   };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,76 @@
+/**
+* \file VecteurFlexions.cpp
+* \brief Le code des opérateurs de VecteurFlexions.
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3.
+*
+*/
+
+#include "VecteurFlexions.h"
+
+#include <algorithm>
+
+namespace TP3
+{
+
+    /**
+    * \brief Vérifie si motFlexion fait partie de la liste
+    *
+    * \post La liste reste inchangée.
+    */
+    bool VecteurFlexions::contient(std::string_view motFlexion) const
+    {
+        return std::find(flexions.begin(), flexions.end(), motFlexion) != flexions.end();
+    }
+
+    /**
+    * \brief Ajoute motFlexion à la fin de la liste
+    *
+    * \post La flexion est ajoutée si elle n'était pas déjà présente.
+    * \return vrai si la flexion a été ajoutée, faux si elle était déjà présente.
+    */
+    bool VecteurFlexions::ajouter(std::string_view motFlexion)
+    {
+        if (contient(motFlexion)) return false;
+
+        flexions.emplace_back(motFlexion);
+        return true;
+    }
+
+    /**
+    * \brief Retire motFlexion de la liste
+    *
+    * \return vrai si la flexion a été retirée, faux si elle n'était pas présente.
+    */
+    bool VecteurFlexions::retirer(std::string_view motFlexion)
+    {
+        auto it = std::find(flexions.begin(), flexions.end(), motFlexion);
+        if (it == flexions.end()) return false;
+
+        flexions.erase(it);
+        return true;
+    }
+
+    /**
+    * \brief Octets alloués sur le tas (voir Memoire.h)
+    */
+    std::size_t VecteurFlexions::memoire() const
+    {
+        std::size_t octets = octetsVecteur(flexions);
+        for (auto &flexion : flexions) octets += octetsChaine(flexion);
+        return octets;
+    }
+
+    /**
+    * \brief Libère les capacités inutilisées
+    */
+    void VecteurFlexions::compacter()
+    {
+        flexions.shrink_to_fit();
+        for (auto &flexion : flexions) flexion.shrink_to_fit();
+    }
+
+}//Fin du namespace
@@ -0,0 +1,87 @@
+/**
+* \file VecteurFlexions.h
+* \brief Interface du type VecteurFlexions
+* \author IFT-2008, Olivier Caron
+* \version 0.1
+* \date juillet 2023
+*
+* Travail pratique numéro 3
+*
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+#include "Memoire.h"
+
+#ifndef _VECTEURFLEXIONS__H
+#define _VECTEURFLEXIONS__H
+
+namespace TP3
+{
+
+   /**
+   * \class VecteurFlexions
+   *
+   * \brief Conteneur des flexions d'un radical, une chaîne par flexion.
+   *
+   * Même interface que ListeFlexions. Chaque flexion est une std::string : l'accès à une
+   * flexion ne la recopie pas, au prix d'une allocation par flexion trop longue pour la petite
+   * chaîne optimisée.
+   *
+   */
+   class VecteurFlexions
+   {
+   public:
+
+      typedef std::vector<std::string>::const_iterator const_iterator;
+
+      /**
+      * \brief Vérifie si motFlexion fait partie de la liste
+      *
+      * \post La liste reste inchangée.
+      */
+      bool contient(std::string_view motFlexion) const;
+
+      /**
+      * \brief Ajoute motFlexion à la fin de la liste
+      *
+      * \post La flexion est ajoutée si elle n'était pas déjà présente.
+      * \return vrai si la flexion a été ajoutée, faux si elle était déjà présente.
+      */
+      bool ajouter(std::string_view motFlexion);
+
+      /**
+      * \brief Retire motFlexion de la liste
+      *
+      * \return vrai si la flexion a été retirée, faux si elle n'était pas présente.
+      */
+      bool retirer(std::string_view motFlexion);
+
+      void vider() { flexions.clear(); }
+
+      std::size_t taille() const { return flexions.size(); }
+      bool estVide() const { return flexions.empty(); }
+
+      /**
+      * \brief Octets alloués sur le tas (voir Memoire.h)
+      */
+      std::size_t memoire() const;
+
+      void compacter();
+
+      std::vector<std::string> versVecteur() const { return flexions; }
+
+      const_iterator begin() const { return flexions.begin(); }
+      const_iterator end() const { return flexions.end(); }
+
+   private:
+
+      std::vector<std::string> flexions;   // Dans l'ordre d'insertion.
+   };
+
+}//Fin du namespace
+
+#endif